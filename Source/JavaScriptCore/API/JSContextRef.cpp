@@ -112,6 +112,13 @@ void JSContextGroupClearExecutionTimeLimit(JSContextGroupRef group)
         vm.watchdog()->setTimeLimit(Watchdog::noTimeLimit);
 }
 
+void JSContextGroupSetMemoryBudget(JSContextGroupRef group, size_t softLimit, size_t hardLimit)
+{
+    VM& vm = *toJS(group);
+    JSLockHolder locker(&vm);
+    vm.heap.setMemoryBudget(softLimit, hardLimit);
+}
+
 // From the API's perspective, a global context remains alive iff it has been JSGlobalContextRetained.
 
 JSGlobalContextRef JSGlobalContextCreate(JSClassRef globalObjectClass)
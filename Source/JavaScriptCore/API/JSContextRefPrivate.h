@@ -94,6 +94,20 @@ JS_EXPORT void JSContextGroupSetExecutionTimeLimit(JSContextGroupRef group, doub
 */
 JS_EXPORT void JSContextGroupClearExecutionTimeLimit(JSContextGroupRef group) CF_AVAILABLE(10_6, 7_0);
 
+/*!
+@function
+@abstract Sets the memory budget of the garbage collected heap.
+@param group The JavaScript context group whose heap is budgeted.
+@param softLimit The heap size, in bytes, above which the collector collects more often. Pass 0 to
+ use the hard limit.
+@param hardLimit The heap size, in bytes, that the collector tries to stay under. When the heap gets
+ close to it, all compiled code is discarded and a synchronous full collection is done. Pass 0 for
+ no hard limit.
+@discussion Passing 0 for both limits removes the budget. The budget only changes how often the
+ collector runs; allocations never fail because of it.
+*/
+JS_EXPORT void JSContextGroupSetMemoryBudget(JSContextGroupRef group, size_t softLimit, size_t hardLimit);
+
 /*!
 @function
 @abstract Gets a whether or not remote inspection is enabled on the context.
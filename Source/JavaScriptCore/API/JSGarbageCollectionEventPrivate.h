@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef JSGarbageCollectionEventPrivate_h
+#define JSGarbageCollectionEventPrivate_h
+
+#include <JavaScriptCore/JSContextRef.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+@struct JSGarbageCollectionEvent
+@abstract Describes one completed garbage collection. All times are in seconds. startTime is on
+ the same monotonic clock as WTF::MonotonicTime.
+@field isFullCollection true for a full collection, false for an eden collection.
+@field pauseCount How many times the collection stopped the mutator.
+@field totalPauseDuration The total time the mutator was stopped by this collection.
+@field maxPauseDuration The longest single stop of the mutator.
+@field constraintSolvingDuration The time spent executing marking constraints.
+@field bytesVisited The number of bytes marked by this collection.
+@field bytesSwept The number of bytes the sweeper found free in the blocks it swept after this
+ collection, up to the end of the sweep or the start of the next collection.
+@field heapSizeBeforeCollection The heap size, in bytes, when the collection started.
+@field heapSizeAfterCollection The heap size, in bytes, when the collection finished.
+@field wasOverSoftMemoryBudget true if the heap was over its soft memory budget when the collection
+ started, so the collection was paced by the budget rather than by the usual heuristics.
+@field wasMemoryBudgetEmergency true if the collection was forced because the heap was about to
+ exceed its hard memory budget.
+*/
+typedef struct {
+    bool isFullCollection;
+    double startTime;
+    double duration;
+    unsigned pauseCount;
+    double totalPauseDuration;
+    double maxPauseDuration;
+    double beginPhaseDuration;
+    double fixpointPhaseDuration;
+    double concurrentPhaseDuration;
+    double reloopPhaseDuration;
+    double endPhaseDuration;
+    double constraintSolvingDuration;
+    size_t bytesVisited;
+    size_t bytesSwept;
+    size_t heapSizeBeforeCollection;
+    size_t heapSizeAfterCollection;
+    bool wasOverSoftMemoryBudget;
+    bool wasMemoryBudgetEmergency;
+} JSGarbageCollectionEvent;
+
+/*!
+@typedef JSGarbageCollectionEventCallback
+@abstract Called on the thread that owns the context group, with the API lock held, once for
+ every collection that finished since the last call. A collection is reported once the sweep that
+ follows it is done, or when the next collection begins. The event is only valid for the duration
+ of the callback. The callback must not call back into JavaScript.
+*/
+typedef void (*JSGarbageCollectionEventCallback)(JSContextGroupRef, const JSGarbageCollectionEvent*, void* userData);
+
+JS_EXPORT void JSContextGroupAddGarbageCollectionEventCallback(JSContextGroupRef, JSGarbageCollectionEventCallback, void* userData);
+JS_EXPORT void JSContextGroupRemoveGarbageCollectionEventCallback(JSContextGroupRef, JSGarbageCollectionEventCallback, void* userData);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JSGarbageCollectionEventPrivate_h
@@ -33,6 +33,7 @@
 
 #include "JSBasePrivate.h"
 #include "JSContextRefPrivate.h"
+#include "JSGarbageCollectionEventPrivate.h"
 #include "JSHeapFinalizerPrivate.h"
 #include "JSMarkingConstraintPrivate.h"
 #include "JSObjectRefPrivate.h"
@@ -1236,6 +1237,92 @@ static void testMarkingConstraintsAndHeapFinalizers(void)
     printf("PASS: Marking Constraints and Heap Finalizers.\n");
 }
 
+static unsigned garbageCollectionEventCount;
+static bool sawFullGarbageCollectionEvent;
+
+static void garbageCollectionEventCallback(JSContextGroupRef group, const JSGarbageCollectionEvent* event, void *userData)
+{
+    assertTrue((uintptr_t)userData == (uintptr_t)42, "Correct userData was passed");
+    assertTrue(group == expectedContextGroup, "Correct context group");
+    assertTrue(event->duration >= 0, "Collection has a duration");
+    assertTrue(event->pauseCount > 0, "Collection stopped the mutator at least once");
+    assertTrue(event->maxPauseDuration <= event->totalPauseDuration, "Longest pause is part of the total pause");
+    assertTrue(event->endPhaseDuration <= event->duration, "End phase is part of the collection");
+
+    garbageCollectionEventCount++;
+    if (event->isFullCollection)
+        sawFullGarbageCollectionEvent = true;
+}
+
+static void testGarbageCollectionEvents(void)
+{
+    JSContextGroupRef group;
+    JSGlobalContextRef context;
+
+    printf("Testing Garbage Collection Events.\n");
+
+    group = JSContextGroupCreate();
+    expectedContextGroup = group;
+    context = JSGlobalContextCreateInGroup(group, NULL);
+
+    JSContextGroupAddGarbageCollectionEventCallback(group, garbageCollectionEventCallback, (void*)(uintptr_t)42);
+
+    garbageCollectionEventCount = 0;
+    JSSynchronousGarbageCollectForDebugging(context);
+    assertTrue(garbageCollectionEventCount > 0, "Did report garbage collection event");
+    assertTrue(sawFullGarbageCollectionEvent, "Did report full collection");
+
+    JSContextGroupRemoveGarbageCollectionEventCallback(group, garbageCollectionEventCallback, (void*)(uintptr_t)42);
+
+    garbageCollectionEventCount = 0;
+    JSSynchronousGarbageCollectForDebugging(context);
+    assertTrue(!garbageCollectionEventCount, "Did not report garbage collection event");
+
+    JSGlobalContextRelease(context);
+    JSContextGroupRelease(group);
+
+    printf("PASS: Garbage Collection Events.\n");
+}
+
+static unsigned overSoftMemoryBudgetEventCount;
+
+static void memoryBudgetEventCallback(JSContextGroupRef group, const JSGarbageCollectionEvent* event, void *userData)
+{
+    UNUSED_PARAM(group);
+    UNUSED_PARAM(userData);
+    if (event->wasOverSoftMemoryBudget)
+        overSoftMemoryBudgetEventCount++;
+}
+
+static void testMemoryBudget(void)
+{
+    JSContextGroupRef group;
+    JSGlobalContextRef context;
+    JSStringRef script;
+
+    printf("Testing Memory Budget.\n");
+
+    group = JSContextGroupCreate();
+    context = JSGlobalContextCreateInGroup(group, NULL);
+
+    JSContextGroupAddGarbageCollectionEventCallback(group, memoryBudgetEventCallback, NULL);
+    JSContextGroupSetMemoryBudget(group, 1024 * 1024, 64 * 1024 * 1024);
+
+    // Keep several megabytes alive so that every collection after the first starts over the soft budget.
+    overSoftMemoryBudgetEventCount = 0;
+    script = JSStringCreateWithUTF8CString("var live = []; for (var i = 0; i < 200000; ++i) live.push({ index: i }); for (var i = 0; i < 200000; ++i) [i, i + 1, i + 2];");
+    JSEvaluateScript(context, script, NULL, NULL, 1, NULL);
+    JSStringRelease(script);
+    JSSynchronousGarbageCollectForDebugging(context);
+    assertTrue(overSoftMemoryBudgetEventCount > 0, "Did report collections over the soft memory budget");
+
+    JSContextGroupRemoveGarbageCollectionEventCallback(group, memoryBudgetEventCallback, NULL);
+    JSGlobalContextRelease(context);
+    JSContextGroupRelease(group);
+
+    printf("PASS: Memory Budget.\n");
+}
+
 #if USE(CF)
 static void testCFStrings(void)
 {
@@ -1366,6 +1453,8 @@ int main(int argc, char* argv[])
     ASSERT(Base_didFinalize);
 
     testMarkingConstraintsAndHeapFinalizers();
+    testGarbageCollectionEvents();
+    testMemoryBudget();
 
 #if USE(CF)
     testCFStrings();
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "GCEvent.h"
+
+#include <wtf/PrintStream.h>
+
+namespace JSC {
+
+void GCEvent::dump(PrintStream& out) const
+{
+    out.print(scope, " collection: ", duration().milliseconds(), "ms");
+    out.print(", pauses: ", pauseCount, " (total ", totalPauseTime.milliseconds(), "ms, max ", maxPauseTime.milliseconds(), "ms)");
+    out.print(", phases:");
+    for (unsigned i = 0; i < numberOfCollectorPhases; ++i) {
+        CollectorPhase phase = static_cast<CollectorPhase>(i);
+        if (phase == CollectorPhase::NotRunning)
+            continue;
+        out.print(" ", phase, "=", phaseDuration(phase).milliseconds(), "ms");
+    }
+    out.print(", constraints: ", constraintSolvingTime.milliseconds(), "ms");
+    out.print(", visited: ", bytesVisited / 1024, "kb, swept: ", bytesSwept / 1024, "kb, size: ", sizeBefore / 1024, "kb => ", sizeAfter / 1024, "kb");
+    if (wasMemoryBudgetEmergency)
+        out.print(", memory budget emergency");
+    else if (wasOverSoftMemoryBudget)
+        out.print(", over soft memory budget");
+}
+
+} // namespace JSC
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "CollectionScope.h"
+#include "CollectorPhase.h"
+#include <array>
+#include <wtf/MonotonicTime.h>
+#include <wtf/PrintStream.h>
+
+namespace JSC {
+
+static const unsigned numberOfCollectorPhases = static_cast<unsigned>(CollectorPhase::End) + 1;
+
+// Telemetry for one collection cycle. The collector fills this in as it goes, including the sweep that
+// follows. The event is handed to the GCEventCallbacks when that sweep ends (Heap::didFinishSweeping()), or
+// when the next collection begins (Heap::runBeginPhase()) if the sweep hasn't ended by then.
+struct GCEvent {
+    Seconds duration() const { return endTime - startTime; }
+    Seconds& phaseDuration(CollectorPhase phase) { return phaseDurations[static_cast<unsigned>(phase)]; }
+    Seconds phaseDuration(CollectorPhase phase) const { return phaseDurations[static_cast<unsigned>(phase)]; }
+    
+    void didPause(Seconds pause)
+    {
+        pauseCount++;
+        totalPauseTime += pause;
+        maxPauseTime = std::max(maxPauseTime, pause);
+    }
+    
+    void dump(PrintStream&) const;
+    
+    CollectionScope scope { CollectionScope::Eden };
+    MonotonicTime startTime;
+    MonotonicTime endTime;
+    std::array<Seconds, numberOfCollectorPhases> phaseDurations;
+    unsigned pauseCount { 0 };
+    Seconds totalPauseTime;
+    Seconds maxPauseTime;
+    Seconds constraintSolvingTime;
+    size_t bytesVisited { 0 };
+    // Filled in once the sweep that follows the collection is done, or the next collection begins.
+    size_t bytesSwept { 0 };
+    size_t sizeBefore { 0 };
+    size_t sizeAfter { 0 };
+    bool wasOverSoftMemoryBudget { false };
+    bool wasMemoryBudgetEmergency { false };
+};
+
+} // namespace JSC
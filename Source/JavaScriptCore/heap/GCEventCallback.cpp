@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "GCEventCallback.h"
+
+#include "APICast.h"
+#include "GCEvent.h"
+
+namespace JSC {
+
+void GCEventCallback::dump(PrintStream& out) const
+{
+    out.print(RawPointer(bitwise_cast<void*>(m_callback)), ":", RawPointer(m_userData));
+}
+
+void GCEventCallback::run(VM& vm, const GCEvent& event) const
+{
+    JSGarbageCollectionEvent apiEvent;
+    apiEvent.isFullCollection = event.scope == CollectionScope::Full;
+    apiEvent.startTime = event.startTime.secondsSinceEpoch().seconds();
+    apiEvent.duration = event.duration().seconds();
+    apiEvent.pauseCount = event.pauseCount;
+    apiEvent.totalPauseDuration = event.totalPauseTime.seconds();
+    apiEvent.maxPauseDuration = event.maxPauseTime.seconds();
+    apiEvent.beginPhaseDuration = event.phaseDuration(CollectorPhase::Begin).seconds();
+    apiEvent.fixpointPhaseDuration = event.phaseDuration(CollectorPhase::Fixpoint).seconds();
+    apiEvent.concurrentPhaseDuration = event.phaseDuration(CollectorPhase::Concurrent).seconds();
+    apiEvent.reloopPhaseDuration = event.phaseDuration(CollectorPhase::Reloop).seconds();
+    apiEvent.endPhaseDuration = event.phaseDuration(CollectorPhase::End).seconds();
+    apiEvent.constraintSolvingDuration = event.constraintSolvingTime.seconds();
+    apiEvent.bytesVisited = event.bytesVisited;
+    apiEvent.bytesSwept = event.bytesSwept;
+    apiEvent.heapSizeBeforeCollection = event.sizeBefore;
+    apiEvent.heapSizeAfterCollection = event.sizeAfter;
+    apiEvent.wasOverSoftMemoryBudget = event.wasOverSoftMemoryBudget;
+    apiEvent.wasMemoryBudgetEmergency = event.wasMemoryBudgetEmergency;
+    m_callback(toRef(&vm), &apiEvent, m_userData);
+}
+
+} // namespace JSC
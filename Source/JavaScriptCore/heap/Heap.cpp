@@ -76,6 +76,7 @@
 #include <wtf/ParallelVectorIterator.h>
 #include <wtf/ProcessID.h>
 #include <wtf/RAMSize.h>
+#include <wtf/SetForScope.h>
 #include <wtf/SimpleStats.h>
 
 #if USE(FOUNDATION)
@@ -304,10 +305,16 @@ Heap::Heap(VM* vm, HeapType heapType)
     , m_sharedCollectorMarkStack(std::make_unique<MarkStackArray>())
     , m_sharedMutatorMarkStack(std::make_unique<MarkStackArray>())
     , m_helperClient(&heapHelperPool())
+    , m_sweepHelperClient(&heapHelperPool())
     , m_threadLock(Box<Lock>::create())
     , m_threadCondition(AutomaticThreadCondition::create())
 {
     m_worldState.store(0);
+    m_indexOfNextBlockToSweepConcurrently.store(0);
+    m_concurrentSweepersShouldStop.store(false);
+    
+    if (Options::gcSoftMemoryBudget() || Options::gcHardMemoryBudget())
+        setMemoryBudget(Options::gcSoftMemoryBudget(), Options::gcHardMemoryBudget());
     
     if (Options::useConcurrentGC()) {
         if (Options::useStochasticMutatorScheduler())
@@ -429,6 +436,8 @@ void Heap::lastChanceToFinalize()
     if (Options::logGC())
         dataLog("5 ");
     
+    stopConcurrentSweeping();
+    
     m_arrayBuffers.lastChanceToFinalize();
     m_codeBlocks->lastChanceToFinalize(*m_vm);
     m_objectSpace.stopAllocating();
@@ -982,12 +991,14 @@ void Heap::sweepSynchronously()
         dataLog("Full sweep: ", capacity() / 1024, "kb ");
         before = currentTimeMS();
     }
+    stopConcurrentSweeping();
     m_objectSpace.sweep();
     m_objectSpace.shrink();
     if (Options::logGC()) {
         double after = currentTimeMS();
         dataLog("=> ", capacity() / 1024, "kb, ", after - before, "ms");
     }
+    didFinishSweeping();
 }
 
 void Heap::collect(Synchronousness synchronousness, GCRequest request)
@@ -1167,6 +1178,19 @@ NEVER_INLINE bool Heap::runBeginPhase(GCConductor conn)
 {
     m_currentGCStartTime = MonotonicTime::now();
     
+    // Marking is about to change the mark bits that the concurrently swept free lists were built
+    // from.
+    stopConcurrentSweeping();
+    
+    // Whatever the sweeper did not get to before this collection is swept against the new marks.
+    finishGCEventAwaitingSweep();
+    
+    m_currentGCEvent = GCEvent();
+    m_currentGCEvent.startTime = m_currentGCStartTime;
+    m_currentGCEvent.wasMemoryBudgetEmergency = m_isHandlingMemoryBudgetEmergency;
+    if (size_t softBudget = m_softMemoryBudget ? m_softMemoryBudget : m_hardMemoryBudget)
+        m_currentGCEvent.wasOverSoftMemoryBudget = m_sizeAfterLastCollect + m_bytesAllocatedThisCycle >= softBudget;
+    
     {
         LockHolder locker(*m_threadLock);
         RELEASE_ASSERT(!m_requests.isEmpty());
@@ -1318,8 +1342,10 @@ NEVER_INLINE bool Heap::runFixpointPhase(GCConductor conn)
             
         // Wondering what this does? Look at Heap::addCoreConstraints(). The DOM and others can also
         // add their own using Heap::addMarkingConstraint().
+        MonotonicTime constraintSolvingStartTime = MonotonicTime::now();
         bool converged =
             m_constraintSet->executeConvergence(slotVisitor, MonotonicTime::infinity());
+        m_currentGCEvent.constraintSolvingTime += MonotonicTime::now() - constraintSolvingStartTime;
         if (converged && slotVisitor.isEmpty()) {
             assertSharedMarkStacksEmpty();
             return changePhase(conn, CollectorPhase::End);
@@ -1443,6 +1469,7 @@ NEVER_INLINE bool Heap::runEndPhase(GCConductor conn)
     m_codeBlocks->clearCurrentlyExecuting();
         
     m_objectSpace.prepareForAllocation();
+    startConcurrentSweeping();
     updateAllocationLimits();
 
     if (UNLIKELY(m_verifier)) {
@@ -1451,6 +1478,7 @@ NEVER_INLINE bool Heap::runEndPhase(GCConductor conn)
     }
 
     didFinishCollection();
+    finishGCEvent();
     
     if (m_currentRequest.didFinishEndPhase)
         m_currentRequest.didFinishEndPhase->run();
@@ -1510,6 +1538,10 @@ NEVER_INLINE bool Heap::finishChangingPhase(GCConductor conn)
         if (suspendedBefore) {
             RELEASE_ASSERT(!suspendedAfter);
             
+            MonotonicTime resumeTime = MonotonicTime::now();
+            m_currentGCEvent.didPause(resumeTime - m_stopTime);
+            if (m_nextPhase == CollectorPhase::NotRunning)
+                didResumeAfterCollection(resumeTime);
             resumeThePeriphery();
             if (conn == GCConductor::Collector)
                 resumeTheMutator();
@@ -1534,6 +1566,11 @@ NEVER_INLINE bool Heap::finishChangingPhase(GCConductor conn)
         }
     }
     
+    MonotonicTime now = MonotonicTime::now();
+    if (m_currentPhase != CollectorPhase::NotRunning)
+        m_currentGCEvent.phaseDuration(m_currentPhase) += now - m_currentPhaseStartTime;
+    m_currentPhaseStartTime = now;
+    
     m_currentPhase = m_nextPhase;
     return true;
 }
@@ -2010,6 +2047,8 @@ void Heap::finalize()
     for (const HeapFinalizerCallback& callback : m_heapFinalizerCallbacks)
         callback.run(*vm());
     
+    dispatchGCEvents();
+    
     if (Options::sweepSynchronously())
         sweepSynchronously();
 
@@ -2154,6 +2193,59 @@ void Heap::notifyIncrementalSweeper()
     m_sweeper->startSweeping();
 }
 
+void Heap::startConcurrentSweeping()
+{
+    if (!Options::useConcurrentSweeping() || Options::numberOfGCMarkers() <= 1)
+        return;
+    
+    auto locker = holdLock(m_concurrentSweepingLock);
+    
+    RELEASE_ASSERT(m_blocksToSweepConcurrently.isEmpty());
+    m_objectSpace.forEachAllocator(
+        [&] (MarkedAllocator& allocator) -> IterationStatus {
+            allocator.appendBlocksToSweepConcurrently(m_blocksToSweepConcurrently);
+            return IterationStatus::Continue;
+        });
+    if (m_blocksToSweepConcurrently.isEmpty())
+        return;
+    
+    // A block may still be claimed from a sweep in a previous cycle.
+    for (MarkedBlock::Handle* block : m_blocksToSweepConcurrently)
+        block->clearConcurrentlySweptFreeList();
+    
+    m_indexOfNextBlockToSweepConcurrently.store(0);
+    m_concurrentSweepersShouldStop.store(false);
+    
+    // The mutator never waits for this task. Whatever is left when the next collection starts
+    // simply gets swept lazily, like it would have been without helpers.
+    m_sweepHelperClient.setFunction(
+        [this] () {
+            WTF::registerGCThread(GCThreadType::Helper);
+            
+            while (!m_concurrentSweepersShouldStop.load()) {
+                unsigned index = m_indexOfNextBlockToSweepConcurrently.exchangeAdd(1);
+                if (index >= m_blocksToSweepConcurrently.size())
+                    return;
+                m_blocksToSweepConcurrently[index]->sweepConcurrently();
+            }
+        });
+}
+
+void Heap::stopConcurrentSweeping()
+{
+    auto locker = holdLock(m_concurrentSweepingLock);
+    
+    if (m_blocksToSweepConcurrently.isEmpty())
+        return;
+    
+    m_concurrentSweepersShouldStop.store(true);
+    m_sweepHelperClient.finish();
+    
+    for (MarkedBlock::Handle* block : m_blocksToSweepConcurrently)
+        block->clearConcurrentlySweptFreeList();
+    m_blocksToSweepConcurrently.clear();
+}
+
 void Heap::updateAllocationLimits()
 {
     static const bool verbose = false;
@@ -2235,6 +2327,8 @@ void Heap::updateAllocationLimits()
         }
     }
 
+    applyMemoryBudgetToAllocationLimits(currentHeapSize);
+
 #if PLATFORM(IOS)
     // Get critical memory threshold for next cycle.
     overCriticalMemoryThreshold(MemoryThresholdCallType::Direct);
@@ -2250,6 +2344,79 @@ void Heap::updateAllocationLimits()
         dataLog("=> ", currentHeapSize / 1024, "kb, ");
 }
 
+void Heap::setMemoryBudget(size_t softBudget, size_t hardBudget)
+{
+    if (hardBudget && (!softBudget || softBudget > hardBudget))
+        softBudget = hardBudget;
+    m_softMemoryBudget = softBudget;
+    m_hardMemoryBudget = hardBudget;
+    
+    if (Options::logGC())
+        dataLog("[GC<", RawPointer(this), ">: memory budget soft=", softBudget / 1024, "kb hard=", hardBudget / 1024, "kb]\n");
+    
+    // Don't wait for the next collection to start respecting the new budget.
+    applyMemoryBudgetToAllocationLimits(m_sizeAfterLastCollect);
+}
+
+size_t Heap::minEdenSizeUnderMemoryBudget() const
+{
+    // Collecting on every allocation would not free anything more, so always leave some eden.
+    size_t budget = m_hardMemoryBudget ? m_hardMemoryBudget : m_softMemoryBudget;
+    return std::max<size_t>(budget / 32, 128 * KB);
+}
+
+void Heap::applyMemoryBudgetToAllocationLimits(size_t currentHeapSize)
+{
+    if (!m_softMemoryBudget)
+        return;
+    
+    size_t maxHeapSize;
+    if (currentHeapSize < m_softMemoryBudget) {
+        // Plan for the next cycle to start by the time we reach the soft budget.
+        maxHeapSize = std::min(m_maxHeapSize, m_softMemoryBudget);
+    } else {
+        // Past the soft budget, every collection gets to use a quarter of the remaining headroom,
+        // so the pacing escalates as we approach the hard budget. Eden collections can't free the
+        // old space that got us here, so make sure the next one is full.
+        size_t headroom = m_hardMemoryBudget > currentHeapSize ? m_hardMemoryBudget - currentHeapSize : 0;
+        maxHeapSize = std::min(m_maxHeapSize, currentHeapSize + headroom / 4);
+        m_shouldDoFullCollection = true;
+    }
+    
+    m_maxHeapSize = std::max(maxHeapSize, currentHeapSize + minEdenSizeUnderMemoryBudget());
+    m_maxEdenSize = m_maxHeapSize - currentHeapSize;
+    
+    if (Options::logGC() && currentHeapSize >= m_softMemoryBudget)
+        dataLog("over soft memory budget, maxEden=", m_maxEdenSize / 1024, "kb, ");
+}
+
+bool Heap::shouldHandleMemoryBudgetEmergency() const
+{
+    if (!m_hardMemoryBudget || m_isHandlingMemoryBudgetEmergency)
+        return false;
+    
+    // If the live heap itself is over the threshold, another emergency collection right away won't
+    // help. Wait for at least a minimum eden's worth of allocation.
+    if (m_bytesAllocatedThisCycle < minEdenSizeUnderMemoryBudget())
+        return false;
+    
+    size_t threshold = static_cast<size_t>(m_hardMemoryBudget * Options::gcHardMemoryBudgetEmergencyFraction());
+    return m_sizeAfterLastCollect + m_bytesAllocatedThisCycle >= threshold;
+}
+
+void Heap::handleMemoryBudgetEmergency()
+{
+    if (Options::logGC())
+        dataLog("[GC<", RawPointer(this), ">: memory budget emergency at ", (m_sizeAfterLastCollect + m_bytesAllocatedThisCycle) / 1024, "kb of ", m_hardMemoryBudget / 1024, "kb]\n");
+    
+    SetForScope<bool> handlingEmergency(m_isHandlingMemoryBudgetEmergency, true);
+    
+    // Compiled code is often the biggest thing we can drop right away. If JavaScript is running,
+    // the VM defers this until it is idle again, so this collection may not get to free it.
+    m_vm->deleteAllCode(DeleteAllCodeIfNotCollecting);
+    collectNow(Sync, CollectionScope::Full);
+}
+
 void Heap::didFinishCollection()
 {
     m_afterGC = MonotonicTime::now();
@@ -2279,6 +2446,62 @@ void Heap::didFinishCollection()
         observer->didGarbageCollect(scope);
 }
 
+void Heap::finishGCEvent()
+{
+    GCEvent& event = m_currentGCEvent;
+    event.scope = *m_lastCollectionScope;
+    event.bytesVisited = m_totalBytesVisitedThisCycle;
+    event.sizeBefore = event.scope == CollectionScope::Full ? m_sizeBeforeLastFullCollect : m_sizeBeforeLastEdenCollect;
+    event.sizeAfter = m_sizeAfterLastCollect;
+}
+
+void Heap::didResumeAfterCollection(MonotonicTime resumeTime)
+{
+    // The last pause and the end phase both end when the mutator resumes.
+    GCEvent& event = m_currentGCEvent;
+    event.endTime = resumeTime;
+    event.phaseDuration(CollectorPhase::End) += resumeTime - m_currentPhaseStartTime;
+    m_currentPhaseStartTime = resumeTime;
+    
+    // The garbage found by this collection is swept from now on, so the event waits for the
+    // sweeper before it can be reported.
+    auto locker = holdLock(m_finishedGCEventsLock);
+    ASSERT(!m_gcEventAwaitingSweep);
+    m_gcEventAwaitingSweep = event;
+    m_bytesSweptThisCycle = 0;
+    m_currentGCEvent = GCEvent();
+}
+
+void Heap::finishGCEventAwaitingSweep()
+{
+    auto locker = holdLock(m_finishedGCEventsLock);
+    if (!m_gcEventAwaitingSweep)
+        return;
+    m_gcEventAwaitingSweep->bytesSwept = m_bytesSweptThisCycle;
+    m_finishedGCEvents.append(WTFMove(*m_gcEventAwaitingSweep));
+    m_gcEventAwaitingSweep = std::nullopt;
+}
+
+void Heap::didFinishSweeping()
+{
+    finishGCEventAwaitingSweep();
+    dispatchGCEvents();
+}
+
+void Heap::dispatchGCEvents()
+{
+    Vector<GCEvent> events;
+    {
+        auto locker = holdLock(m_finishedGCEventsLock);
+        events = WTFMove(m_finishedGCEvents);
+    }
+    
+    for (const GCEvent& event : events) {
+        for (const GCEventCallback& callback : m_gcEventCallbacks)
+            callback.run(*vm(), event);
+    }
+}
+
 void Heap::resumeCompilerThreads()
 {
 #if ENABLE(DFG_JIT)
@@ -2522,6 +2745,16 @@ void Heap::collectIfNecessaryOrDefer(GCDeferralContext* deferralContext)
             stopIfNecessary();
     }
     
+    if (UNLIKELY(shouldHandleMemoryBudgetEmergency())) {
+        if (deferralContext)
+            deferralContext->m_shouldGC = true;
+        else if (isDeferred())
+            m_didDeferGCWork = true;
+        else
+            handleMemoryBudgetEmergency();
+        return;
+    }
+    
     if (UNLIKELY(Options::gcMaxHeapSize())) {
         if (m_bytesAllocatedThisCycle <= Options::gcMaxHeapSize())
             return;
@@ -2873,4 +3106,14 @@ void Heap::removeHeapFinalizerCallback(const HeapFinalizerCallback& callback)
     m_heapFinalizerCallbacks.removeFirst(callback);
 }
 
+void Heap::addGCEventCallback(const GCEventCallback& callback)
+{
+    m_gcEventCallbacks.append(callback);
+}
+
+void Heap::removeGCEventCallback(const GCEventCallback& callback)
+{
+    m_gcEventCallbacks.removeFirst(callback);
+}
+
 } // namespace JSC
@@ -26,6 +26,8 @@
 #include "CollectionScope.h"
 #include "CollectorPhase.h"
 #include "DeleteAllCodeEffort.h"
+#include "GCEvent.h"
+#include "GCEventCallback.h"
 #include "GCConductor.h"
 #include "GCIncomingRefCountedSet.h"
 #include "GCRequest.h"
@@ -267,6 +269,13 @@ public:
     void deleteAllCodeBlocks(DeleteAllCodeEffort);
     void deleteAllUnlinkedCodeBlocks(DeleteAllCodeEffort);
 
+    // Above the soft budget, the collector shrinks eden in proportion to the headroom left below
+    // the hard budget and only does full collections. Close to the hard budget, it deletes all
+    // code and collects synchronously. A budget of 0 means no budget.
+    JS_EXPORT_PRIVATE void setMemoryBudget(size_t softBudget, size_t hardBudget);
+    size_t softMemoryBudget() const { return m_softMemoryBudget; }
+    size_t hardMemoryBudget() const { return m_hardMemoryBudget; }
+
     void didAllocate(size_t);
     void didAllocateWebAssemblyFastMemories(size_t);
     bool isPagedOut(double deadline);
@@ -378,6 +387,13 @@ public:
     
     void addHeapFinalizerCallback(const HeapFinalizerCallback&);
     void removeHeapFinalizerCallback(const HeapFinalizerCallback&);
+    
+    void addGCEventCallback(const GCEventCallback&);
+    void removeGCEventCallback(const GCEventCallback&);
+    
+    // Only the mutator sweeps blocks. Free lists built by the concurrent sweepers are counted when
+    // the mutator picks them up.
+    void didSweep(size_t bytes) { m_bytesSweptThisCycle += bytes; }
 
 private:
     friend class AllocatingScope;
@@ -499,13 +515,24 @@ private:
     void snapshotUnswept();
     void deleteSourceProviderCaches();
     void notifyIncrementalSweeper();
+    void startConcurrentSweeping();
+    void stopConcurrentSweeping();
     void harvestWeakReferences();
     void finalizeUnconditionalFinalizers();
     void clearUnmarkedExecutables();
     void deleteUnmarkedCompiledCode();
     JS_EXPORT_PRIVATE void addToRememberedSet(const JSCell*);
     void updateAllocationLimits();
+    void applyMemoryBudgetToAllocationLimits(size_t currentHeapSize);
+    size_t minEdenSizeUnderMemoryBudget() const;
+    bool shouldHandleMemoryBudgetEmergency() const;
+    void handleMemoryBudgetEmergency();
     void didFinishCollection();
+    void finishGCEvent();
+    void didResumeAfterCollection(MonotonicTime);
+    void finishGCEventAwaitingSweep();
+    void didFinishSweeping();
+    void dispatchGCEvents();
     void resumeCompilerThreads();
     void gatherExtraHeapSnapshotData(HeapProfiler&);
     void removeDeadHeapSnapshotNodes(HeapProfiler&);
@@ -565,6 +592,9 @@ private:
     bool m_shouldDoFullCollection;
     size_t m_totalBytesVisited;
     size_t m_totalBytesVisitedThisCycle;
+    size_t m_softMemoryBudget { 0 };
+    size_t m_hardMemoryBudget { 0 };
+    bool m_isHandlingMemoryBudgetEmergency { false };
     double m_incrementBalance { 0 };
     
     std::optional<CollectionScope> m_collectionScope;
@@ -635,6 +665,17 @@ private:
     
     Vector<HeapFinalizerCallback> m_heapFinalizerCallbacks;
     
+    Vector<GCEventCallback> m_gcEventCallbacks;
+    GCEvent m_currentGCEvent;
+    MonotonicTime m_currentPhaseStartTime;
+    // Finished events are handed from whichever thread ran the end phase to the mutator. An event
+    // waits for the sweep that follows its collection, until the sweeper is done or the next
+    // collection begins.
+    Lock m_finishedGCEventsLock;
+    std::optional<GCEvent> m_gcEventAwaitingSweep;
+    Vector<GCEvent> m_finishedGCEvents;
+    size_t m_bytesSweptThisCycle { 0 };
+    
     unsigned m_deferralDepth;
     bool m_didDeferGCWork { false };
 
@@ -667,6 +708,14 @@ private:
     ListableHandler<UnconditionalFinalizer>::List m_unconditionalFinalizers;
 
     ParallelHelperClient m_helperClient;
+    
+    // Protects the concurrent sweeping state below, since it may be started and stopped from
+    // either the mutator or the collector thread.
+    Lock m_concurrentSweepingLock;
+    ParallelHelperClient m_sweepHelperClient;
+    Vector<MarkedBlock::Handle*> m_blocksToSweepConcurrently;
+    Atomic<unsigned> m_indexOfNextBlockToSweepConcurrently;
+    Atomic<bool> m_concurrentSweepersShouldStop;
 
 #if ENABLE(RESOURCE_USAGE)
     size_t m_blockBytesAllocated { 0 };
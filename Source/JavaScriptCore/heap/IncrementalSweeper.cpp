@@ -71,6 +71,7 @@ void IncrementalSweeper::doSweep(MonotonicTime sweepBeginTime)
         m_shouldFreeFastMallocMemoryAfterSweeping = false;
     }
     cancelTimer();
+    m_vm->heap.didFinishSweeping();
 }
 
 bool IncrementalSweeper::sweepNextBlock()
@@ -457,6 +457,18 @@ void MarkedAllocator::shrink()
         });
 }
 
+void MarkedAllocator::appendBlocksToSweepConcurrently(Vector<MarkedBlock::Handle*>& blocks)
+{
+    // Blocks with destructors have to be swept on the mutator, since destructors may touch
+    // arbitrary VM state. Empty blocks get a bump free list, so there is nothing to gain there.
+    if (needsDestruction())
+        return;
+    (m_canAllocateButNotEmpty & m_unswept).forEachSetBit(
+        [&] (size_t index) {
+            blocks.append(m_blocks[index]);
+        });
+}
+
 void MarkedAllocator::assertNoUnswept()
 {
     if (ASSERT_DISABLED)
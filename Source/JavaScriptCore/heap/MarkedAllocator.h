@@ -146,6 +146,7 @@ public:
     void snapshotUnsweptForFullCollection();
     void sweep();
     void shrink();
+    void appendBlocksToSweepConcurrently(Vector<MarkedBlock::Handle*>&);
     void assertNoUnswept();
     size_t cellSize() const { return m_cellSize; }
     const AllocatorAttributes& attributes() const { return m_attributes; }
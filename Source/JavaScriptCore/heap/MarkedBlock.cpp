@@ -425,6 +425,21 @@ FreeList MarkedBlock::Handle::sweep(SweepMode sweepMode)
     
     ASSERT(!m_allocator->isAllocated(NoLockingNecessary, this));
     
+    if (sweepMode == SweepToFreeList && m_attributes.destruction == DoesNotNeedDestruction) {
+        // Claiming the block keeps a helper thread from threading its own free list through
+        // the cells we are about to hand out.
+        auto locker = holdLock(block().m_lock);
+        ConcurrentSweepState state = m_concurrentSweepState;
+        m_concurrentSweepState = ConcurrentSweepState::Claimed;
+        if (state == ConcurrentSweepState::Swept) {
+            FreeList result = m_concurrentlySweptFreeList;
+            m_concurrentlySweptFreeList = FreeList();
+            heap()->didSweep(result.originalSize);
+            setIsFreeListed();
+            return result;
+        }
+    }
+    
     if (space()->isMarking())
         block().m_lock.lock();
     
@@ -481,6 +496,45 @@ FreeList MarkedBlock::Handle::sweep(SweepMode sweepMode)
     return specializedSweep<false, IsEmpty, SweepOnly, BlockHasNoDestructors, DontScribble, HasNewlyAllocated, MarksStale>(emptyMode, sweepMode, BlockHasNoDestructors, scribbleMode, newlyAllocatedMode, marksMode, [] (VM&, JSCell*) { });
 }
 
+void MarkedBlock::Handle::sweepConcurrently()
+{
+    ASSERT(m_attributes.destruction == DoesNotNeedDestruction);
+    
+    auto locker = holdLock(block().m_lock);
+    
+    if (m_concurrentSweepState != ConcurrentSweepState::Idle)
+        return;
+    
+    // Only handle the case that sweep() would have handled with the NotEmpty/MarksNotStale
+    // specialization, so that the mutator gets exactly the free list it would have built.
+    if (scribbleMode() == Scribble
+        || newlyAllocatedMode() == HasNewlyAllocated
+        || marksMode() == MarksStale)
+        return;
+    
+    MarkedBlock& block = this->block();
+    FreeCell* head = nullptr;
+    size_t count = 0;
+    for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
+        if (block.m_marks.get(i))
+            continue;
+        FreeCell* freeCell = reinterpret_cast_ptr<FreeCell*>(&block.atoms()[i]);
+        freeCell->next = head;
+        head = freeCell;
+        ++count;
+    }
+    
+    m_concurrentlySweptFreeList = FreeList::list(head, count * cellSize());
+    m_concurrentSweepState = ConcurrentSweepState::Swept;
+}
+
+void MarkedBlock::Handle::clearConcurrentlySweptFreeList()
+{
+    auto locker = holdLock(block().m_lock);
+    m_concurrentSweepState = ConcurrentSweepState::Idle;
+    m_concurrentlySweptFreeList = FreeList();
+}
+
 } // namespace JSC
 
 namespace WTF {
@@ -129,6 +129,14 @@ public:
         enum SweepMode { SweepOnly, SweepToFreeList };
         FreeList sweep(SweepMode = SweepOnly);
         
+        // Called on a heap helper thread between collections. This builds the free list that
+        // sweep(SweepToFreeList) would have built and parks it in the block, so that the mutator
+        // only has to pick it up. It bails out unless the block has no destructors, has fresh
+        // marks, and has no newly allocated cells, and never touches the allocator bits or the
+        // weak set. Everything here is protected by the block's lock.
+        void sweepConcurrently();
+        void clearConcurrentlySweptFreeList();
+        
         // This is to be called by Subspace.
         template<typename DestroyFunc>
         FreeList finishSweepKnowingSubspace(SweepMode, const DestroyFunc&);
@@ -205,6 +213,7 @@ public:
         enum EmptyMode { IsEmpty, NotEmpty };
         enum NewlyAllocatedMode { HasNewlyAllocated, DoesNotHaveNewlyAllocated };
         enum MarksMode { MarksStale, MarksNotStale };
+        enum class ConcurrentSweepState : uint8_t { Idle, Swept, Claimed };
         
         SweepDestructionMode sweepDestructionMode();
         EmptyMode emptyMode();
@@ -230,6 +239,8 @@ public:
             
         AllocatorAttributes m_attributes;
         bool m_isFreeListed { false };
+        ConcurrentSweepState m_concurrentSweepState { ConcurrentSweepState::Idle };
+        FreeList m_concurrentlySweptFreeList;
             
         MarkedAllocator* m_allocator { nullptr };
         size_t m_index { std::numeric_limits<size_t>::max() };
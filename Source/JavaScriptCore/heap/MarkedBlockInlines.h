@@ -187,6 +187,7 @@ FreeList MarkedBlock::Handle::specializedSweep(MarkedBlock::Handle::EmptyMode em
             m_allocator->setIsEmpty(NoLockingNecessary, this, true);
         if (space()->isMarking())
             block.m_lock.unlock();
+        heap()->didSweep(payloadEnd - payloadBegin);
         FreeList result = FreeList::bump(payloadEnd, payloadEnd - payloadBegin);
         if (false)
             dataLog("Quickly swept block ", RawPointer(this), " with cell size ", cellSize(), " and attributes ", m_attributes, ": ", result, "\n");
@@ -198,11 +199,13 @@ FreeList MarkedBlock::Handle::specializedSweep(MarkedBlock::Handle::EmptyMode em
     // order of the free list.
     FreeCell* head = 0;
     size_t count = 0;
+    size_t deadCellCount = 0;
     bool isEmpty = true;
     Vector<size_t> deadCells;
     VM& vm = *this->vm();
     auto handleDeadCell = [&] (size_t i) {
         HeapCell* cell = reinterpret_cast_ptr<HeapCell*>(&block.atoms()[i]);
+        ++deadCellCount;
 
         if (destructionMode != BlockHasNoDestructors && emptyMode == NotEmpty) {
             JSCell* jsCell = static_cast<JSCell*>(cell);
@@ -248,6 +251,7 @@ FreeList MarkedBlock::Handle::specializedSweep(MarkedBlock::Handle::EmptyMode em
             handleDeadCell(i);
     }
 
+    heap()->didSweep(deadCellCount * cellSize());
     FreeList result = FreeList::list(head, count * cellSize());
     if (sweepMode == SweepToFreeList)
         setIsFreeListed();
@@ -1487,6 +1487,7 @@ const GlobalObjectMethodTable GlobalObject::s_globalObjectMethodTable = {
     nullptr, // moduleLoaderEvaluate
     nullptr, // promiseRejectionTracker
     nullptr, // defaultLanguage
+    nullptr, // webAssemblyModuleCachePartition
 };
 
 GlobalObject::GlobalObject(VM& vm, Structure* structure)
@@ -257,6 +257,7 @@ const GlobalObjectMethodTable JSGlobalObject::s_globalObjectMethodTable = {
     nullptr, // moduleLoaderEvaluate
     nullptr, // promiseRejectionTracker
     nullptr, // defaultLanguage
+    nullptr, // webAssemblyModuleCachePartition
 };
 
 /* Source for JSGlobalObject.lut.h
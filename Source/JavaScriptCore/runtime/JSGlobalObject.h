@@ -203,6 +203,11 @@ struct GlobalObjectMethodTable {
 
     typedef String (*DefaultLanguageFunctionPtr)();
     DefaultLanguageFunctionPtr defaultLanguage;
+
+    // Compiled WebAssembly modules are only shared between global objects with the same partition.
+    // A null string disables sharing.
+    typedef String (*WebAssemblyModuleCachePartitionPtr)(const JSGlobalObject*);
+    WebAssemblyModuleCachePartitionPtr webAssemblyModuleCachePartition;
 };
 
 class JSGlobalObject : public JSSegmentedVariableObject {
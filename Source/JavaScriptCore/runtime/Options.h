@@ -194,6 +194,7 @@ typedef const char* optionString;
     v(bool, useGenerationalGC, true, Normal, nullptr) \
     v(bool, useConcurrentBarriers, true, Normal, nullptr) \
     v(bool, useConcurrentGC, true, Normal, nullptr) \
+    v(bool, useConcurrentSweeping, true, Normal, "sweep blocks without destructors to free lists on heap helper threads after each collection") \
     v(bool, collectContinuously, false, Normal, nullptr) \
     v(double, collectContinuouslyPeriodMS, 1, Normal, nullptr) \
     v(bool, forceFencedBarrier, false, Normal, nullptr) \
@@ -207,6 +208,9 @@ typedef const char* optionString;
     v(double, mediumHeapGrowthFactor, 1.5, Normal, nullptr) \
     v(double, largeHeapGrowthFactor, 1.24, Normal, nullptr) \
     v(double, criticalGCMemoryThreshold, 0.88, Normal, "percent memory in use the GC considers critical.  The collector is much more aggressive above this threshold") \
+    v(unsigned, gcSoftMemoryBudget, 0, Normal, "heap size in bytes above which the collector paces collections more aggressively (0 = no budget)") \
+    v(unsigned, gcHardMemoryBudget, 0, Normal, "heap size in bytes that the collector tries hard to stay under (0 = no budget)") \
+    v(double, gcHardMemoryBudgetEmergencyFraction, 0.9, Normal, "fraction of the hard memory budget at which the collector deletes all code and does a synchronous full collection") \
     v(double, minimumMutatorUtilization, 0, Normal, nullptr) \
     v(double, maximumMutatorUtilization, 0.7, Normal, nullptr) \
     v(double, epsilonMutatorUtilization, 0.01, Normal, nullptr) \
@@ -381,6 +385,11 @@ typedef const char* optionString;
     v(unsigned, samplingProfilerTopBytecodesCount, 40, Normal, "Number of top bytecodes to report when using the command line interface.") \
     v(optionString, samplingProfilerPath, nullptr, Normal, "The path to the directory to write sampiling profiler output to. This probably will not work with WK2 unless the path is in the whitelist.") \
     v(bool, sampleCCode, false, Normal, "Causes the sampling profiler to record profiling data for C frames.") \
+    v(optionString, samplingProfilerExportPath, nullptr, Normal, "The path to the directory to periodically write aggregated sampling profiler stacks to. Requires useSamplingProfiler.") \
+    v(optionString, samplingProfilerExportFormat, "collapsed", Normal, "Format of the exported sampling profiles: \"collapsed\" for collapsed stacks text, or \"pprof\".") \
+    v(unsigned, samplingProfilerExportFlushInterval, 60000, Normal, "Time between two sampling profile exports in milliseconds.") \
+    v(unsigned, samplingProfilerExportMaxStacks, 10000, Normal, "Maximum number of distinct stacks kept in memory between two sampling profile exports.") \
+    v(unsigned, samplingProfilerExportMaxFiles, 100, Normal, "Maximum number of sampling profile exports kept on disk per process. The oldest one is overwritten past this.") \
     \
     v(bool, alwaysGeneratePCToCodeOriginMap, false, Normal, "This will make sure we always generate a PCToCodeOriginMap for JITed code.") \
     \
@@ -457,7 +466,9 @@ typedef const char* optionString;
     v(bool, crashIfWebAssemblyCantFastMemory, false, Normal, "If true, we will crash if we can't obtain fast memory for wasm.") \
     v(unsigned, webAssemblyFastMemoryPreallocateCount, 0, Normal, "WebAssembly fast memories can be pre-allocated at program startup and remain cached to avoid fragmentation leading to bounds-checked memory. This number is an upper bound on initial allocation as well as total count of fast memories. Zero means no pre-allocation, no caching, and no limit to the number of runtime allocations.") \
     v(bool, useWebAssemblyFastTLS, true, Normal, "If true, we will try to use fast thread-local storage if available on the current platform.") \
-    v(bool, useCallICsForWebAssemblyToJSCalls, true, Normal, "If true, we will use CallLinkInfo to inline cache Wasm to JS calls.")
+    v(bool, useCallICsForWebAssemblyToJSCalls, true, Normal, "If true, we will use CallLinkInfo to inline cache Wasm to JS calls.") \
+    v(bool, useWebAssemblyModuleCache, true, Normal, "If true, compiling identical WebAssembly bytes reuses the already validated and compiled module.") \
+    v(unsigned, webAssemblyModuleCacheCapacity, 32 * MB, Normal, "Maximum total size, in bytes of source, decoded module information and compiled code, of the WebAssembly modules kept alive by the module cache.")
 
 
 enum OptionEquivalence {
@@ -61,6 +61,11 @@ static const double sWalkErrorPercentage = .05;
 static const bool sReportStatsOnlyWhenTheyreAboveThreshold = false;
 static const bool sReportStats = false;
 
+// While exporting, stack traces are aggregated on VM entry once this many are
+// pending, and samples are dropped rather than buffered past the second limit.
+static const size_t sStackTracesPerExportAggregation = 256;
+static const size_t sMaxPendingStackTracesWhileExporting = 8192;
+
 using FrameType = SamplingProfiler::FrameType;
 using UnprocessedStackFrame = SamplingProfiler::UnprocessedStackFrame;
 
@@ -309,6 +314,7 @@ void SamplingProfiler::timerLoop()
 {
     while (true) {
         std::chrono::microseconds stackTraceProcessingTime = std::chrono::microseconds(0);
+        Vector<SamplingProfilerExporter::File> pendingExportFiles;
         {
             LockHolder locker(m_lock);
             if (UNLIKELY(m_isShutDown))
@@ -318,8 +324,14 @@ void SamplingProfiler::timerLoop()
                 takeSample(locker, stackTraceProcessingTime);
 
             m_lastTime = m_stopwatch->elapsedTime();
+            pendingExportFiles = WTFMove(m_pendingExportFiles);
         }
 
+        // Exported profiles are written from this thread so that the JSC execution
+        // thread never blocks on file I/O.
+        for (auto& file : pendingExportFiles)
+            SamplingProfilerExporter::write(file);
+
         // Read section 6.2 of this paper for more elaboration of why we add a random
         // fluctuation here. The main idea is to prevent our timer from being in sync
         // with some system process such as a scheduled context switch.
@@ -334,6 +346,11 @@ void SamplingProfiler::takeSample(const AbstractLocker&, std::chrono::microsecon
 {
     ASSERT(m_lock.isLocked());
     if (m_vm.entryScope) {
+        if (m_exporter && m_unprocessedStackTraces.size() + m_stackTraces.size() >= sMaxPendingStackTracesWhileExporting) {
+            m_exporter->noteDroppedSamples(1);
+            return;
+        }
+
         double nowTime = m_stopwatch->elapsedTime();
 
         LockHolder machineThreadsLocker(m_vm.heap.machineThreads().getLock());
@@ -449,13 +466,14 @@ void SamplingProfiler::processUnverifiedStackTraces()
     RELEASE_ASSERT(m_lock.isLocked());
 
     TinyBloomFilter filter = m_vm.heap.objectSpace().blocks().filter();
+    bool shouldCollectMachineLocations = Options::collectSamplingProfilerDataForJSCShell() || m_exporter;
 
     for (UnprocessedStackTrace& unprocessedStackTrace : m_unprocessedStackTraces) {
         m_stackTraces.append(StackTrace());
         StackTrace& stackTrace = m_stackTraces.last();
         stackTrace.timestamp = unprocessedStackTrace.timestamp;
 
-        auto populateCodeLocation = [] (CodeBlock* codeBlock, unsigned bytecodeIndex, StackFrame::CodeLocation& location) {
+        auto populateCodeLocation = [&] (CodeBlock* codeBlock, unsigned bytecodeIndex, StackFrame::CodeLocation& location) {
             if (bytecodeIndex < codeBlock->instructionCount()) {
                 int divot;
                 int startOffset;
@@ -464,7 +482,7 @@ void SamplingProfiler::processUnverifiedStackTraces()
                     location.lineNumber, location.columnNumber);
                 location.bytecodeIndex = bytecodeIndex;
             }
-            if (Options::collectSamplingProfilerDataForJSCShell()) {
+            if (shouldCollectMachineLocations) {
                 location.codeBlockHash = codeBlock->hash();
                 location.jitType = codeBlock->jitType();
             }
@@ -550,7 +568,7 @@ void SamplingProfiler::processUnverifiedStackTraces()
                 appendCodeBlock(codeOrigin.inlineCallFrame ? codeOrigin.inlineCallFrame->baselineCodeBlock.get() : machineCodeBlock, codeOrigin.bytecodeIndex);
             });
 
-            if (Options::collectSamplingProfilerDataForJSCShell()) {
+            if (shouldCollectMachineLocations) {
                 RELEASE_ASSERT(machineOrigin.isSet());
                 RELEASE_ASSERT(!machineOrigin.inlineCallFrame);
 
@@ -693,11 +711,142 @@ void SamplingProfiler::noticeJSLockAcquisition()
 
 void SamplingProfiler::noticeVMEntry()
 {
+    bool shouldExport;
+    {
+        LockHolder locker(m_lock);
+        ASSERT(m_vm.entryScope);
+        noticeCurrentThreadAsJSCExecutionThread(locker);
+        m_lastTime = m_stopwatch->elapsedTime();
+        createThreadIfNecessary(locker);
+        shouldExport = m_exporter
+            && (m_unprocessedStackTraces.size() + m_stackTraces.size() >= sStackTracesPerExportAggregation || m_exporter->shouldFlush());
+    }
+
+    if (UNLIKELY(shouldExport))
+        exportStackTraces();
+}
+
+static const char* tierName(JITCode::JITType jitType)
+{
+    switch (jitType) {
+    case JITCode::None:
+    case JITCode::HostCallThunk:
+        return nullptr;
+    case JITCode::InterpreterThunk:
+        return "LLInt";
+    case JITCode::BaselineJIT:
+        return "Baseline";
+    case JITCode::DFGJIT:
+        return "DFG";
+    case JITCode::FTLJIT:
+        return "FTL";
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
+void SamplingProfiler::startExporting(SamplingProfilerExporter::Configuration&& configuration, std::optional<std::chrono::microseconds> timingInterval)
+{
+    finishExporting();
+
     LockHolder locker(m_lock);
-    ASSERT(m_vm.entryScope);
-    noticeCurrentThreadAsJSCExecutionThread(locker);
-    m_lastTime = m_stopwatch->elapsedTime();
-    createThreadIfNecessary(locker);
+    if (!m_stateBeforeExporting)
+        m_stateBeforeExporting = StateBeforeExporting { m_isPaused, m_timingInterval };
+    if (timingInterval)
+        m_timingInterval = *timingInterval;
+    m_exporter = std::make_unique<SamplingProfilerExporter>(WTFMove(configuration), m_timingInterval);
+}
+
+void SamplingProfiler::stopExporting()
+{
+    finishExporting();
+
+    LockHolder locker(m_lock);
+    if (!m_stateBeforeExporting)
+        return;
+
+    m_timingInterval = m_stateBeforeExporting->timingInterval;
+    if (m_stateBeforeExporting->isPaused)
+        pause(locker);
+    m_stateBeforeExporting = std::nullopt;
+}
+
+void SamplingProfiler::finishExporting()
+{
+    {
+        // Computing display names may allocate, and the GC takes m_lock when visiting us.
+        DeferGC deferGC(m_vm.heap);
+        LockHolder locker(m_lock);
+        if (!m_exporter)
+            return;
+
+        aggregateStackTracesForExport(locker);
+        if (auto file = m_exporter->flush())
+            m_pendingExportFiles.append(WTFMove(*file));
+        m_exporter = nullptr;
+    }
+
+    writePendingExportFiles();
+}
+
+void SamplingProfiler::exportStackTraces()
+{
+    DeferGC deferGC(m_vm.heap);
+    LockHolder locker(m_lock);
+    if (!m_exporter)
+        return;
+
+    aggregateStackTracesForExport(locker);
+    if (!m_exporter->shouldFlush())
+        return;
+    if (auto file = m_exporter->flush())
+        m_pendingExportFiles.append(WTFMove(*file));
+}
+
+void SamplingProfiler::aggregateStackTracesForExport(const AbstractLocker& locker)
+{
+    ASSERT(m_lock.isLocked());
+    ASSERT(m_exporter);
+
+    {
+        HeapIterationScope heapIterationScope(m_vm.heap);
+        processUnverifiedStackTraces();
+    }
+
+    Vector<SamplingProfilerExporter::Frame> frames;
+    for (StackTrace& stackTrace : m_stackTraces) {
+        frames.shrink(0);
+        for (StackFrame& stackFrame : stackTrace.frames) {
+            SamplingProfilerExporter::Frame frame;
+            frame.functionName = stackFrame.displayName(m_vm);
+            frame.url = stackFrame.url();
+            frame.startLine = stackFrame.functionStartLine();
+            frame.bytecodeIndex = stackFrame.semanticLocation.bytecodeIndex;
+            if (stackFrame.machineLocation) {
+                // The semantic location refers to the baseline CodeBlock of the inlinee,
+                // the tier we actually ran in is the one of the machine frame.
+                frame.tier = tierName(stackFrame.machineLocation->first.jitType);
+                frame.isInlined = true;
+            } else
+                frame.tier = tierName(stackFrame.semanticLocation.jitType);
+            frames.append(WTFMove(frame));
+        }
+        m_exporter->addStack(frames);
+    }
+
+    clearData(locker);
+}
+
+void SamplingProfiler::writePendingExportFiles()
+{
+    Vector<SamplingProfilerExporter::File> pendingExportFiles;
+    {
+        LockHolder locker(m_lock);
+        pendingExportFiles = WTFMove(m_pendingExportFiles);
+    }
+
+    for (auto& file : pendingExportFiles)
+        SamplingProfilerExporter::write(file);
 }
 
 void SamplingProfiler::clearData(const AbstractLocker&)
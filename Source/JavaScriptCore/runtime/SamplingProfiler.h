@@ -31,6 +31,7 @@
 #include "CodeBlockHash.h"
 #include "JITCode.h"
 #include "MachineStackMarker.h"
+#include "SamplingProfilerExporter.h"
 #include <wtf/HashSet.h>
 #include <wtf/Lock.h>
 #include <wtf/Stopwatch.h>
@@ -174,6 +175,16 @@ public:
     void pause(const AbstractLocker&);
     void clearData(const AbstractLocker&);
 
+    // Continuously aggregates stack traces and periodically writes them out, see
+    // SamplingProfilerExporter. Exported stack traces are consumed, so this should
+    // not be combined with the Web Inspector's ScriptProfiler. These must be called
+    // with the JSLock held. Starting again replaces the configuration, and
+    // stopExporting() puts back the timing interval and the paused state from
+    // before the first startExporting().
+    JS_EXPORT_PRIVATE void startExporting(SamplingProfilerExporter::Configuration&&, std::optional<std::chrono::microseconds> timingInterval = std::nullopt);
+    JS_EXPORT_PRIVATE void stopExporting();
+    bool isExporting() const { return !!m_exporter; }
+
     // Used for debugging in the JSC shell/DRT.
     void registerForReportAtExit();
     void reportDataToOptionFile();
@@ -186,6 +197,10 @@ private:
     void createThreadIfNecessary(const AbstractLocker&);
     void timerLoop();
     void takeSample(const AbstractLocker&, std::chrono::microseconds& stackTraceProcessingTime);
+    void exportStackTraces();
+    void finishExporting();
+    void aggregateStackTracesForExport(const AbstractLocker&);
+    void writePendingExportFiles();
 
     VM& m_vm;
     WeakRandom m_weakRandom;
@@ -202,6 +217,13 @@ private:
     bool m_needsReportAtExit { false };
     HashSet<JSCell*> m_liveCellPointers;
     Vector<UnprocessedStackFrame> m_currentFrames;
+    std::unique_ptr<SamplingProfilerExporter> m_exporter;
+    Vector<SamplingProfilerExporter::File> m_pendingExportFiles;
+    struct StateBeforeExporting {
+        bool isPaused;
+        std::chrono::microseconds timingInterval;
+    };
+    std::optional<StateBeforeExporting> m_stateBeforeExporting;
 };
 
 } // namespace JSC
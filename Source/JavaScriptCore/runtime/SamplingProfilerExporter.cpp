@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SamplingProfilerExporter.h"
+
+#if ENABLE(SAMPLING_PROFILER)
+
+#include "Options.h"
+#include <wtf/DataLog.h>
+#include <wtf/FilePrintStream.h>
+#include <wtf/ProcessID.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC {
+
+// A minimal writer for the protocol buffer wire format, enough to emit the
+// messages of https://github.com/google/pprof/blob/master/proto/profile.proto.
+class ProtobufWriter {
+public:
+    void appendVarint(uint64_t value)
+    {
+        while (value >= 0x80) {
+            m_data.append(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        m_data.append(static_cast<uint8_t>(value));
+    }
+
+    void appendUInt64(unsigned field, uint64_t value)
+    {
+        if (!value)
+            return;
+        appendVarint(field << 3);
+        appendVarint(value);
+    }
+
+    void appendBytes(unsigned field, const uint8_t* data, size_t length)
+    {
+        appendVarint((field << 3) | 2);
+        appendVarint(length);
+        m_data.append(data, length);
+    }
+
+    void appendString(unsigned field, const CString& string)
+    {
+        appendBytes(field, reinterpret_cast<const uint8_t*>(string.data()), string.length());
+    }
+
+    void appendMessage(unsigned field, const ProtobufWriter& message)
+    {
+        appendBytes(field, message.m_data.data(), message.m_data.size());
+    }
+
+    void appendPacked(unsigned field, const Vector<uint64_t>& values)
+    {
+        ProtobufWriter packed;
+        for (uint64_t value : values)
+            packed.appendVarint(value);
+        appendMessage(field, packed);
+    }
+
+    Vector<uint8_t> releaseData() { return WTFMove(m_data); }
+
+private:
+    Vector<uint8_t> m_data;
+};
+
+static String sanitizeForCollapsedStacks(const String& string)
+{
+    // ';' separates frames and whitespace separates the stack from its count.
+    String result = string;
+    result.replace(';', ':');
+    result.replace('\n', ' ');
+    return result;
+}
+
+static std::optional<SamplingProfileFormat> parseFormat(const char* string)
+{
+    if (!string || !strcmp(string, "collapsed"))
+        return SamplingProfileFormat::CollapsedStacks;
+    if (!strcmp(string, "pprof"))
+        return SamplingProfileFormat::PProf;
+    return std::nullopt;
+}
+
+std::optional<SamplingProfilerExporter::Configuration> SamplingProfilerExporter::configurationFromOptions()
+{
+    if (!Options::samplingProfilerExportPath())
+        return std::nullopt;
+
+    std::optional<Format> format = parseFormat(Options::samplingProfilerExportFormat());
+    if (!format) {
+        dataLog("Unknown sampling profiler export format: ", Options::samplingProfilerExportFormat(), "\n");
+        return std::nullopt;
+    }
+
+    Configuration configuration;
+    configuration.directory = String::fromUTF8(Options::samplingProfilerExportPath());
+    configuration.format = *format;
+    configuration.flushInterval = std::chrono::milliseconds(Options::samplingProfilerExportFlushInterval());
+    configuration.maxStacks = Options::samplingProfilerExportMaxStacks();
+    configuration.maxFiles = Options::samplingProfilerExportMaxFiles();
+    return configuration;
+}
+
+SamplingProfilerExporter::SamplingProfilerExporter(Configuration&& configuration, std::chrono::microseconds samplingInterval)
+    : m_configuration(WTFMove(configuration))
+    , m_samplingInterval(samplingInterval)
+    , m_startTime(MonotonicTime::now())
+    , m_startWallTime(WallTime::now())
+{
+}
+
+String SamplingProfilerExporter::labelForFrame(const Frame& frame)
+{
+    StringBuilder label;
+    if (frame.functionName.isEmpty())
+        label.appendLiteral("(anonymous function)");
+    else
+        label.append(frame.functionName);
+    if (!frame.url.isEmpty()) {
+        label.append(' ');
+        label.append(frame.url);
+        if (frame.startLine >= 0) {
+            label.append(':');
+            label.appendNumber(frame.startLine);
+        }
+    }
+    if (frame.tier) {
+        label.appendLiteral(" [");
+        label.append(frame.tier);
+        if (frame.bytecodeIndex != std::numeric_limits<unsigned>::max()) {
+            label.appendLiteral(" bc#");
+            label.appendNumber(frame.bytecodeIndex);
+        }
+        if (frame.isInlined)
+            label.appendLiteral(" inlined");
+        label.append(']');
+    }
+    return sanitizeForCollapsedStacks(label.toString());
+}
+
+void SamplingProfilerExporter::addStack(const Vector<Frame>& frames)
+{
+    if (frames.isEmpty())
+        return;
+
+    Vector<String, 32> labels;
+    labels.reserveInitialCapacity(frames.size());
+    for (const Frame& frame : frames)
+        labels.uncheckedAppend(labelForFrame(frame));
+
+    StringBuilder key;
+    for (size_t i = labels.size(); i--;) {
+        key.append(labels[i]);
+        if (i)
+            key.append(';');
+    }
+
+    String stack = key.toString();
+    auto iterator = m_stackCounts.find(stack);
+    if (iterator != m_stackCounts.end()) {
+        iterator->value++;
+        return;
+    }
+
+    if (m_stackCounts.size() >= m_configuration.maxStacks) {
+        m_stackCounts.add(ASCIILiteral("(truncated)"), 0).iterator->value++;
+        return;
+    }
+
+    m_stackCounts.add(stack, 1);
+    for (size_t i = 0; i < frames.size(); ++i)
+        m_framesByLabel.add(labels[i], frames[i]);
+}
+
+std::optional<SamplingProfilerExporter::File> SamplingProfilerExporter::flush()
+{
+    if (m_stackCounts.isEmpty() && !m_droppedSampleCount) {
+        m_startTime = MonotonicTime::now();
+        m_startWallTime = WallTime::now();
+        return std::nullopt;
+    }
+
+    if (m_droppedSampleCount)
+        m_stackCounts.add(ASCIILiteral("(dropped)"), 0).iterator->value += m_droppedSampleCount;
+
+    File file;
+    StringBuilder path;
+    path.append(m_configuration.directory);
+    path.appendLiteral("/JSCSamplingProfile-");
+    path.appendNumber(getCurrentProcessID());
+    path.append('-');
+    path.appendNumber(m_fileIndex);
+    m_fileIndex = (m_fileIndex + 1) % std::max(m_configuration.maxFiles, 1u);
+    path.append(m_configuration.format == Format::PProf ? ".pb" : ".collapsed");
+    file.path = path.toString().utf8();
+
+    switch (m_configuration.format) {
+    case Format::CollapsedStacks:
+        file.data = serializeAsCollapsedStacks();
+        break;
+    case Format::PProf:
+        file.data = serializeAsPProf();
+        break;
+    }
+
+    m_stackCounts.clear();
+    m_framesByLabel.clear();
+    m_droppedSampleCount = 0;
+    m_startTime = MonotonicTime::now();
+    m_startWallTime = WallTime::now();
+    return file;
+}
+
+Vector<uint8_t> SamplingProfilerExporter::serializeAsCollapsedStacks()
+{
+    Vector<uint8_t> result;
+    for (auto& entry : m_stackCounts) {
+        CString line = makeString(entry.key, ' ', String::number(entry.value), '\n').utf8();
+        result.append(reinterpret_cast<const uint8_t*>(line.data()), line.length());
+    }
+    return result;
+}
+
+Vector<uint8_t> SamplingProfilerExporter::serializeAsPProf()
+{
+    // Field numbers of the Profile message and its sub-messages in profile.proto.
+    enum ProfileField { SampleType = 1, Sample = 2, Location = 4, Function = 5, StringTable = 6, TimeNanos = 9, DurationNanos = 10, PeriodType = 11, Period = 12 };
+
+    Vector<CString> strings;
+    HashMap<String, uint64_t> stringIndices;
+    auto indexForString = [&] (const String& string) -> uint64_t {
+        auto result = stringIndices.add(string, strings.size());
+        if (result.isNewEntry)
+            strings.append(string.utf8());
+        return result.iterator->value;
+    };
+    indexForString(emptyString()); // The string table must start with the empty string.
+
+    ProtobufWriter profile;
+    auto appendValueType = [&] (unsigned field, const char* type, const char* unit) {
+        ProtobufWriter valueType;
+        valueType.appendUInt64(1, indexForString(type));
+        valueType.appendUInt64(2, indexForString(unit));
+        profile.appendMessage(field, valueType);
+    };
+    appendValueType(SampleType, "samples", "count");
+    appendValueType(SampleType, "cpu", "nanoseconds");
+
+    uint64_t periodInNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(m_samplingInterval).count();
+
+    // Each distinct frame label gets both a Location and a Function, sharing the same id.
+    HashMap<String, uint64_t> locationIds;
+    auto locationIdForLabel = [&] (const String& label) -> uint64_t {
+        auto result = locationIds.add(label, locationIds.size() + 1);
+        if (!result.isNewEntry)
+            return result.iterator->value;
+
+        uint64_t id = result.iterator->value;
+        Frame frame;
+        auto frameIterator = m_framesByLabel.find(label);
+        if (frameIterator != m_framesByLabel.end())
+            frame = frameIterator->value;
+
+        ProtobufWriter function;
+        function.appendUInt64(1, id);
+        function.appendUInt64(2, indexForString(label));
+        function.appendUInt64(3, indexForString(frame.functionName.isNull() ? label : frame.functionName));
+        function.appendUInt64(4, indexForString(frame.url.isNull() ? emptyString() : frame.url));
+        if (frame.startLine > 0)
+            function.appendUInt64(5, frame.startLine);
+        profile.appendMessage(Function, function);
+
+        ProtobufWriter line;
+        line.appendUInt64(1, id);
+        if (frame.startLine > 0)
+            line.appendUInt64(2, frame.startLine);
+        ProtobufWriter location;
+        location.appendUInt64(1, id);
+        location.appendMessage(4, line);
+        profile.appendMessage(Location, location);
+        return id;
+    };
+
+    for (auto& entry : m_stackCounts) {
+        Vector<String> labels;
+        entry.key.split(';', labels);
+
+        // pprof wants the leaf first.
+        Vector<uint64_t> locations;
+        locations.reserveInitialCapacity(labels.size());
+        for (size_t i = labels.size(); i--;)
+            locations.uncheckedAppend(locationIdForLabel(labels[i]));
+
+        ProtobufWriter sample;
+        sample.appendPacked(1, locations);
+        sample.appendPacked(2, { entry.value, entry.value * periodInNanoseconds });
+        profile.appendMessage(Sample, sample);
+    }
+
+    Seconds duration = MonotonicTime::now() - m_startTime;
+    profile.appendUInt64(TimeNanos, m_startWallTime.secondsSinceEpoch().nanosecondsAs<uint64_t>());
+    profile.appendUInt64(DurationNanos, duration.nanosecondsAs<uint64_t>());
+    appendValueType(PeriodType, "cpu", "nanoseconds");
+    profile.appendUInt64(Period, periodInNanoseconds);
+
+    // The string table is written last since the messages above keep adding to it.
+    for (const CString& string : strings)
+        profile.appendString(StringTable, string);
+
+    return profile.releaseData();
+}
+
+void SamplingProfilerExporter::write(const File& file)
+{
+    auto out = FilePrintStream::open(file.path.data(), "w");
+    if (!out) {
+        dataLog("Could not open ", file.path, " to write sampling profiler data.\n");
+        return;
+    }
+    if (file.data.size())
+        fwrite(file.data.data(), 1, file.data.size(), out->file());
+}
+
+} // namespace JSC
+
+#endif // ENABLE(SAMPLING_PROFILER)
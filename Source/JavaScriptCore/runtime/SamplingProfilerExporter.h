@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <wtf/EnumTraits.h>
+
+namespace JSC {
+
+// Declared regardless of ENABLE(SAMPLING_PROFILER), so that embedders can pass it around.
+enum class SamplingProfileFormat {
+    CollapsedStacks, // One "root;...;leaf count" line per stack, as consumed by flamegraph.pl.
+    PProf, // Uncompressed profile.proto, as consumed by pprof.
+};
+
+} // namespace JSC
+
+namespace WTF {
+
+template<> struct EnumTraits<JSC::SamplingProfileFormat> {
+    using values = EnumValues<
+        JSC::SamplingProfileFormat,
+        JSC::SamplingProfileFormat::CollapsedStacks,
+        JSC::SamplingProfileFormat::PProf
+    >;
+};
+
+} // namespace WTF
+
+#if ENABLE(SAMPLING_PROFILER)
+
+#include <chrono>
+#include <wtf/HashMap.h>
+#include <wtf/MonotonicTime.h>
+#include <wtf/Optional.h>
+#include <wtf/Vector.h>
+#include <wtf/WallTime.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+// Aggregates the stack traces gathered by the SamplingProfiler and periodically
+// serializes them to a file, so that long-running processes can be profiled
+// continuously without attaching the Web Inspector. Memory use is bounded: at
+// most maxStacks distinct stacks are kept between two flushes, and any other
+// stack is accounted to a single "(truncated)" stack. Disk use is bounded too:
+// intervals without samples are not written, and once maxFiles files have been
+// written the oldest one is overwritten.
+class SamplingProfilerExporter {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    using Format = SamplingProfileFormat;
+
+    struct Configuration {
+        String directory;
+        Format format { Format::CollapsedStacks };
+        std::chrono::milliseconds flushInterval { 60000 };
+        unsigned maxStacks { 10000 };
+        unsigned maxFiles { 100 };
+    };
+
+    struct Frame {
+        String functionName;
+        String url;
+        int startLine { -1 };
+        const char* tier { nullptr };
+        unsigned bytecodeIndex { std::numeric_limits<unsigned>::max() };
+        bool isInlined { false };
+    };
+
+    struct File {
+        CString path;
+        Vector<uint8_t> data;
+    };
+
+    JS_EXPORT_PRIVATE static std::optional<Configuration> configurationFromOptions();
+
+    SamplingProfilerExporter(Configuration&&, std::chrono::microseconds samplingInterval);
+
+    const Configuration& configuration() const { return m_configuration; }
+
+    // Frames are ordered from the leaf to the root, like SamplingProfiler::StackTrace::frames.
+    void addStack(const Vector<Frame>&);
+    void noteDroppedSamples(size_t count) { m_droppedSampleCount += count; }
+
+    bool shouldFlush() const { return MonotonicTime::now() - m_startTime >= Seconds::fromMilliseconds(m_configuration.flushInterval.count()); }
+    // Returns nothing if no sample was taken since the last flush.
+    std::optional<File> flush();
+
+    static void write(const File&);
+
+private:
+    String labelForFrame(const Frame&);
+    Vector<uint8_t> serializeAsCollapsedStacks();
+    Vector<uint8_t> serializeAsPProf();
+
+    Configuration m_configuration;
+    std::chrono::microseconds m_samplingInterval;
+    MonotonicTime m_startTime;
+    WallTime m_startWallTime;
+    HashMap<String, uint64_t> m_stackCounts;
+    HashMap<String, Frame> m_framesByLabel;
+    size_t m_droppedSampleCount { 0 };
+    unsigned m_fileIndex { 0 };
+};
+
+} // namespace JSC
+
+#endif // ENABLE(SAMPLING_PROFILER)
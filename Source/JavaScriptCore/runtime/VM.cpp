@@ -103,6 +103,7 @@
 #include "UnlinkedCodeBlock.h"
 #include "VMEntryScope.h"
 #include "VMInspector.h"
+#include "WasmModuleCache.h"
 #include "WasmWorklist.h"
 #include "Watchdog.h"
 #include "WeakGCMapInlines.h"
@@ -332,6 +333,8 @@ VM::VM(VMType vmType, HeapType heapType)
         m_samplingProfiler = adoptRef(new SamplingProfiler(*this, WTFMove(stopwatch)));
         if (Options::samplingProfilerPath())
             m_samplingProfiler->registerForReportAtExit();
+        if (auto exportConfiguration = SamplingProfilerExporter::configurationFromOptions())
+            m_samplingProfiler->startExporting(WTFMove(*exportConfiguration));
         m_samplingProfiler->start();
     }
 #endif // ENABLE(SAMPLING_PROFILER)
@@ -366,6 +369,7 @@ VM::~VM()
 #if ENABLE(SAMPLING_PROFILER)
     if (m_samplingProfiler) {
         m_samplingProfiler->reportDataToOptionFile();
+        m_samplingProfiler->stopExporting();
         m_samplingProfiler->shutdown();
     }
 #endif // ENABLE(SAMPLING_PROFILER)
@@ -579,6 +583,9 @@ void VM::deleteAllCode(DeleteAllCodeEffort effort)
     whenIdle([=] () {
         m_codeCache->clear();
         m_regExpCache->deleteAllCode();
+#if ENABLE(WEBASSEMBLY)
+        Wasm::ModuleCache::singleton().clear();
+#endif
         heap.deleteAllCodeBlocks(effort);
         heap.deleteAllUnlinkedCodeBlocks(effort);
         heap.reportAbandonedObjectGraph();
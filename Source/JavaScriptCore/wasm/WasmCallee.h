@@ -51,6 +51,7 @@ public:
     }
 
     void* entrypoint() const { return m_entrypoint.compilation->code().executableAddress(); }
+    size_t codeSize() const { return m_entrypoint.compilation->codeRef().size(); }
 
     RegisterAtOffsetList* calleeSaveRegisters() { return &m_entrypoint.calleeSaveRegisters; }
     IndexOrName indexOrName() const { return m_indexOrName; }
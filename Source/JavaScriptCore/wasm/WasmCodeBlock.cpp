@@ -110,6 +110,24 @@ void CodeBlock::compileAsync(VM& vm, AsyncCompilationCallback&& task)
         task->run(vm, makeRef(*this));
 }
 
+size_t CodeBlock::compiledCodeSize()
+{
+    auto locker = holdLock(m_lock);
+    size_t size = 0;
+    for (auto& stub : m_wasmToWasmExitStubs)
+        size += stub.size();
+    auto addCallees = [&] (const Vector<RefPtr<Callee>>& callees) {
+        for (auto& callee : callees) {
+            if (callee)
+                size += callee->codeSize();
+        }
+    };
+    addCallees(m_callees);
+    addCallees(m_optimizedCallees);
+    addCallees(m_jsCallees);
+    return size;
+}
+
 bool CodeBlock::isSafeToRun(MemoryMode memoryMode)
 {
     if (!runnable())
@@ -108,6 +108,8 @@ public:
 
     bool isSafeToRun(MemoryMode);
 
+    size_t compiledCodeSize();
+
     MemoryMode mode() const { return m_mode; }
 
     ~CodeBlock();
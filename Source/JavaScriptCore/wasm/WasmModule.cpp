@@ -29,6 +29,7 @@
 #if ENABLE(WEBASSEMBLY)
 
 #include "WasmBBQPlanInlines.h"
+#include "WasmModuleCache.h"
 #include "WasmModuleInformation.h"
 #include "WasmWorklist.h"
 
@@ -54,28 +55,108 @@ static Module::ValidationResult makeValidationResult(BBQPlan& plan)
     return Module::ValidationResult(Module::create(plan.takeModuleInformation()));
 }
 
-static Plan::CompletionTask makeValidationCallback(Module::AsyncValidationCallback&& callback)
+static Plan::CompletionTask makeValidationCallback(Module::AsyncValidationCallback&& callback, String&& cacheKey)
 {
-    return createSharedTask<Plan::CallbackType>([callback = WTFMove(callback)] (VM* vm, Plan& plan) {
+    return createSharedTask<Plan::CallbackType>([callback = WTFMove(callback), cacheKey = cacheKey.isolatedCopy()] (VM* vm, Plan& plan) {
         ASSERT(!plan.hasWork());
         ASSERT(vm);
-        callback->run(*vm, makeValidationResult(static_cast<BBQPlan&>(plan)));
+        Module::ValidationResult result = makeValidationResult(static_cast<BBQPlan&>(plan));
+        if (result && !cacheKey.isNull())
+            ModuleCache::singleton().add(cacheKey, *result.value());
+        callback->run(*vm, WTFMove(result));
     });
 }
 
-Module::ValidationResult Module::validateSync(VM& vm, Vector<uint8_t>&& source)
+// Hands a module found in the ModuleCache back through the worklist, so that a cache hit completes
+// asynchronously like a miss and is cancelled the same way when the VM goes away.
+class CachedModulePlan final : public Plan {
+public:
+    CachedModulePlan(VM& vm, Ref<Module>&& module, CompletionTask&& task)
+        : Plan(&vm, makeRef(const_cast<ModuleInformation&>(module->moduleInformation())), WTFMove(task))
+        , m_module(WTFMove(module))
+    {
+    }
+
+    Module& module() { return m_module.get(); }
+
+    bool hasWork() const override { return !m_completed; }
+    void work(CompilationEffort) override
+    {
+        LockHolder locker(m_lock);
+        if (!m_completed)
+            complete(locker);
+    }
+    bool multiThreaded() const override { return false; }
+
+private:
+    bool isComplete() const override { return m_completed; }
+    void complete(const AbstractLocker& locker) override
+    {
+        m_completed = true;
+        runCompletionTasks(locker);
+    }
+
+    Ref<Module> m_module;
+    bool m_completed { false };
+};
+
+static String cacheKeyForSource(JSGlobalObject* globalObject, const Vector<uint8_t>& source)
+{
+    if (!ModuleCache::isEnabled())
+        return String();
+    return ModuleCache::keyForSource(globalObject, source);
+}
+
+Module::ValidationResult Module::validateSync(VM& vm, JSGlobalObject* globalObject, Vector<uint8_t>&& source)
 {
+    String cacheKey = cacheKeyForSource(globalObject, source);
+    if (!cacheKey.isNull()) {
+        if (RefPtr<Module> module = ModuleCache::singleton().find(cacheKey, source))
+            return ValidationResult(WTFMove(module));
+    }
+
     Ref<BBQPlan> plan = adoptRef(*new BBQPlan(&vm, WTFMove(source), BBQPlan::Validation, Plan::dontFinalize()));
     plan->parseAndValidateModule();
-    return makeValidationResult(plan.get());
+    ValidationResult result = makeValidationResult(plan.get());
+    if (result && !cacheKey.isNull())
+        ModuleCache::singleton().add(cacheKey, *result.value());
+    return result;
 }
 
-void Module::validateAsync(VM& vm, Vector<uint8_t>&& source, Module::AsyncValidationCallback&& callback)
+void Module::validateAsync(VM& vm, JSGlobalObject* globalObject, Vector<uint8_t>&& source, Module::AsyncValidationCallback&& callback)
 {
-    Ref<Plan> plan = adoptRef(*new BBQPlan(&vm, WTFMove(source), BBQPlan::Validation, makeValidationCallback(WTFMove(callback))));
+    String cacheKey = cacheKeyForSource(globalObject, source);
+    if (!cacheKey.isNull()) {
+        if (RefPtr<Module> module = ModuleCache::singleton().find(cacheKey, source)) {
+            auto task = createSharedTask<Plan::CallbackType>([callback = WTFMove(callback)] (VM* vm, Plan& plan) {
+                ASSERT(vm);
+                auto& cachedModulePlan = static_cast<CachedModulePlan&>(plan);
+                if (cachedModulePlan.failed()) {
+                    callback->run(*vm, UnexpectedType<String>(cachedModulePlan.errorMessage()));
+                    return;
+                }
+                callback->run(*vm, ValidationResult(makeRef(cachedModulePlan.module())));
+            });
+            Wasm::ensureWorklist().enqueue(adoptRef(*new CachedModulePlan(vm, module.releaseNonNull(), WTFMove(task))));
+            return;
+        }
+    }
+
+    Ref<Plan> plan = adoptRef(*new BBQPlan(&vm, WTFMove(source), BBQPlan::Validation, makeValidationCallback(WTFMove(callback), WTFMove(cacheKey))));
     Wasm::ensureWorklist().enqueue(WTFMove(plan));
 }
 
+size_t Module::compiledCodeSize()
+{
+    auto locker = holdLock(m_lock);
+    size_t size = 0;
+    for (auto& codeBlock : m_codeBlocks) {
+        if (codeBlock)
+            size += codeBlock->compiledCodeSize();
+    }
+    return size;
+}
+
 Ref<CodeBlock> Module::getOrCreateCodeBlock(MemoryMode mode)
 {
     RefPtr<CodeBlock> codeBlock;
@@ -34,7 +34,11 @@
 #include <wtf/SharedTask.h>
 #include <wtf/ThreadSafeRefCounted.h>
 
-namespace JSC { namespace Wasm {
+namespace JSC {
+
+class JSGlobalObject;
+
+namespace Wasm {
 
 struct ModuleInformation;
 class Plan;
@@ -47,8 +51,8 @@ public:
     typedef void CallbackType(VM&, ValidationResult&&);
     using AsyncValidationCallback = RefPtr<SharedTask<CallbackType>>;
 
-    static ValidationResult validateSync(VM&, Vector<uint8_t>&& source);
-    static void validateAsync(VM&, Vector<uint8_t>&& source, Module::AsyncValidationCallback&&);
+    static ValidationResult validateSync(VM&, JSGlobalObject*, Vector<uint8_t>&& source);
+    static void validateAsync(VM&, JSGlobalObject*, Vector<uint8_t>&& source, Module::AsyncValidationCallback&&);
 
     static Ref<Module> create(Ref<ModuleInformation>&& moduleInformation)
     {
@@ -64,6 +68,9 @@ public:
     JS_EXPORT_PRIVATE ~Module();
 
     CodeBlock* codeBlockFor(MemoryMode mode) { return m_codeBlocks[static_cast<uint8_t>(mode)].get(); }
+
+    // Executable memory used by the code compiled so far for all memory modes.
+    size_t compiledCodeSize();
 private:
     Ref<CodeBlock> getOrCreateCodeBlock(MemoryMode);
 
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmModuleCache.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "JSGlobalObject.h"
+#include "Options.h"
+#include "WasmModule.h"
+#include "WasmModuleInformation.h"
+#include <wtf/SHA1.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC { namespace Wasm {
+
+ModuleCache& ModuleCache::singleton()
+{
+    static NeverDestroyed<ModuleCache> cache;
+    return cache;
+}
+
+bool ModuleCache::isEnabled()
+{
+    return Options::useWebAssemblyModuleCache() && Options::webAssemblyModuleCacheCapacity();
+}
+
+String ModuleCache::keyForSource(JSGlobalObject* globalObject, const Vector<uint8_t>& source)
+{
+    // Sharing modules across origins would let a page find out, from how fast a compilation
+    // finishes, which modules another origin loaded.
+    String partition = emptyString();
+    if (auto webAssemblyModuleCachePartition = globalObject->globalObjectMethodTable()->webAssemblyModuleCachePartition) {
+        partition = webAssemblyModuleCachePartition(globalObject);
+        if (partition.isNull())
+            return String();
+    }
+
+    SHA1 sha1;
+    sha1.addBytes(source);
+    SHA1::Digest digest;
+    sha1.computeHash(digest);
+    CString hexDigest = SHA1::hexDigest(digest);
+
+    StringBuilder key;
+    key.append(partition);
+    key.append(' ');
+    key.append(hexDigest.data(), hexDigest.length());
+    return key.toString();
+}
+
+RefPtr<Module> ModuleCache::find(const String& key, const Vector<uint8_t>& source)
+{
+    auto locker = holdLock(m_lock);
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end())
+        return nullptr;
+    // Don't trust the digest alone; the bytes are already kept alive by the module.
+    if (iter->value.module->moduleInformation().source != source)
+        return nullptr;
+    iter->value.lastUse = ++m_useCounter;
+    updateSize(locker, iter->value);
+    RefPtr<Module> module = iter->value.module;
+    evictIfNeeded(locker);
+    return module;
+}
+
+void ModuleCache::add(const String& key, Module& module)
+{
+    auto locker = holdLock(m_lock);
+    auto addResult = m_entries.add(key.isolatedCopy(), Entry { &module, ++m_useCounter, 0 });
+    if (!addResult.isNewEntry)
+        return;
+    updateSize(locker, addResult.iterator->value);
+    evictIfNeeded(locker);
+}
+
+void ModuleCache::clear()
+{
+    auto locker = holdLock(m_lock);
+    m_entries.clear();
+    m_totalSize = 0;
+}
+
+size_t ModuleCache::entrySize(Module& module)
+{
+    return module.moduleInformation().estimatedSize() + module.compiledCodeSize();
+}
+
+void ModuleCache::updateSize(const AbstractLocker&, Entry& entry)
+{
+    // Modules are added when validated and only get compiled code later, once instantiated, so an
+    // entry is measured again whenever it is used.
+    size_t size = entrySize(*entry.module);
+    ASSERT(m_totalSize >= entry.size);
+    m_totalSize = m_totalSize - entry.size + size;
+    entry.size = size;
+}
+
+void ModuleCache::evictIfNeeded(const AbstractLocker&)
+{
+    // The cache only ever holds a handful of modules, so a linear scan for the least recently used
+    // entry is cheaper than maintaining an ordered list.
+    while (m_totalSize > Options::webAssemblyModuleCacheCapacity()) {
+        auto victim = m_entries.begin();
+        for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter) {
+            if (iter->value.lastUse < victim->value.lastUse)
+                victim = iter;
+        }
+        ASSERT(m_totalSize >= victim->value.size);
+        m_totalSize -= victim->value.size;
+        m_entries.remove(victim);
+    }
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
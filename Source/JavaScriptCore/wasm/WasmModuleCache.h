@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class JSGlobalObject;
+
+namespace Wasm {
+
+class Module;
+
+// Process-wide cache of validated modules, keyed by the SHA-1 of their source bytes and by the
+// partition (the origin, in WebCore) of the global object that compiled them. A Module is
+// VM-agnostic and owns its compiled code per MemoryMode, so handing the same Module back for
+// identical bytes lets a page reload skip validation and BBQ/OMG compilation entirely.
+class ModuleCache {
+    WTF_MAKE_NONCOPYABLE(ModuleCache);
+    WTF_MAKE_FAST_ALLOCATED;
+    friend class NeverDestroyed<ModuleCache>;
+public:
+    static ModuleCache& singleton();
+
+    static bool isEnabled();
+    // Returns a null string if modules compiled by this global object should not be cached.
+    static String keyForSource(JSGlobalObject*, const Vector<uint8_t>&);
+
+    RefPtr<Module> find(const String& key, const Vector<uint8_t>& source);
+    void add(const String& key, Module&);
+    void clear();
+
+private:
+    ModuleCache() = default;
+
+    struct Entry {
+        RefPtr<Module> module;
+        uint64_t lastUse;
+        size_t size; // What the entry is charged in m_totalSize.
+    };
+
+    static size_t entrySize(Module&);
+    void updateSize(const AbstractLocker&, Entry&);
+    void evictIfNeeded(const AbstractLocker&);
+
+    Lock m_lock;
+    HashMap<String, Entry> m_entries;
+    size_t m_totalSize { 0 };
+    uint64_t m_useCounter { 0 };
+};
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
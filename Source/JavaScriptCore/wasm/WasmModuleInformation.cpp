@@ -32,6 +32,28 @@ namespace JSC { namespace Wasm {
 
 ModuleInformation::~ModuleInformation() { }
 
+size_t ModuleInformation::estimatedSize() const
+{
+    size_t size = sizeof(ModuleInformation) + source.size();
+    for (auto& import : imports)
+        size += sizeof(Import) + import.module.size() + import.field.size();
+    size += (importFunctionSignatureIndices.size() + internalFunctionSignatureIndices.size()) * sizeof(SignatureIndex);
+    size += usedSignatures.size() * sizeof(Ref<Signature>);
+    size += functionLocationInBinary.size() * sizeof(FunctionLocationInBinary);
+    for (auto& exp : exports)
+        size += sizeof(Export) + exp.field.size();
+    for (auto& segment : data)
+        size += sizeof(Segment) + segment->sizeInBytes;
+    for (auto& element : elements)
+        size += sizeof(Element) + element.functionIndices.size() * sizeof(uint32_t);
+    size += globals.size() * sizeof(Global);
+    for (auto& section : customSections)
+        size += sizeof(CustomSection) + section.name.size() + section.payload.size();
+    for (auto& name : nameSection.functionNames)
+        size += sizeof(Name) + name.size();
+    return size;
+}
+
 } } // namespace JSC::Wasm
 
 #endif // ENABLE(WEBASSEMBLY)
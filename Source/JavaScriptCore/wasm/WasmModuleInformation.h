@@ -55,6 +55,9 @@ struct ModuleInformation : public ThreadSafeRefCounted<ModuleInformation> {
 
     JS_EXPORT_PRIVATE ~ModuleInformation();
 
+    // Approximate memory held by the source bytes and everything decoded from them.
+    size_t estimatedSize() const;
+
     const Vector<uint8_t> source;
 
     Vector<Import> imports;
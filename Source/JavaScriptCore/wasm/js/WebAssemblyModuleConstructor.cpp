@@ -183,7 +183,7 @@ JSValue WebAssemblyModuleConstructor::createModule(ExecState* exec, JSValue buff
     Vector<uint8_t> source = createSourceBufferFromValue(vm, exec, buffer);
     RETURN_IF_EXCEPTION(scope, { });
 
-    return JSWebAssemblyModule::createStub(vm, exec, structure, Wasm::Module::validateSync(vm, WTFMove(source)));
+    return JSWebAssemblyModule::createStub(vm, exec, structure, Wasm::Module::validateSync(vm, exec->lexicalGlobalObject(), WTFMove(source)));
 }
 
 WebAssemblyModuleConstructor* WebAssemblyModuleConstructor::create(VM& vm, Structure* structure, WebAssemblyModulePrototype* thisPrototype)
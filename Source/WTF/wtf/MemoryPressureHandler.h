@@ -59,6 +59,11 @@ enum class WebsamProcessState {
 enum class Critical { No, Yes };
 enum class Synchronous { No, Yes };
 
+// How hard the system is pushing us to give memory back. None means the current release was not
+// triggered by a graded system notification (simulated pressure, process suspension, memory usage
+// policy changes, or platforms that can't tell pressure levels apart).
+enum class MemoryPressureLevel { None, Low, Medium, Critical };
+
 typedef std::function<void(Critical, Synchronous)> LowMemoryHandler;
 
 class MemoryPressureHandler {
@@ -81,8 +86,28 @@ public:
     WTF_EXPORT_PRIVATE static bool isUnderMemoryPressure();
     void setUnderMemoryPressure(bool);
 
+    MemoryPressureLevel pressureLevel() const { return m_pressureLevel; }
+
 #if OS(LINUX)
     void setMemoryPressureMonitorHandle(int fd);
+
+    // What the UI process memory pressure monitor adds to its eventfd to report a level. eventfd sums
+    // the values written until they are read, so the levels are far enough apart that the most severe
+    // one can still be told from the sum.
+    static constexpr uint64_t memoryPressureMonitorEventValue(MemoryPressureLevel level)
+    {
+        switch (level) {
+        case MemoryPressureLevel::None:
+            return 0;
+        case MemoryPressureLevel::Low:
+            return 1;
+        case MemoryPressureLevel::Medium:
+            return static_cast<uint64_t>(1) << 20;
+        case MemoryPressureLevel::Critical:
+            return static_cast<uint64_t>(1) << 40;
+        }
+        return 0;
+    }
 #endif
 
     class ReliefLogger {
@@ -162,14 +187,15 @@ private:
     class EventFDPoller {
         WTF_MAKE_NONCOPYABLE(EventFDPoller); WTF_MAKE_FAST_ALLOCATED;
     public:
-        EventFDPoller(int fd, std::function<void ()>&& notifyHandler);
+        // The handler receives the eventfd counter, or 0 if it couldn't be read.
+        EventFDPoller(int fd, std::function<void (uint64_t)>&& notifyHandler);
         ~EventFDPoller();
 
     private:
         void readAndNotify() const;
 
         std::optional<int> m_fd;
-        std::function<void ()> m_notifyHandler;
+        std::function<void (uint64_t)> m_notifyHandler;
 #if USE(GLIB)
         GRefPtr<GSource> m_source;
 #else
@@ -184,6 +210,7 @@ private:
     LowMemoryHandler m_lowMemoryHandler;
 
     std::atomic<bool> m_underMemoryPressure;
+    MemoryPressureLevel m_pressureLevel { MemoryPressureLevel::None };
     bool m_isSimulatingMemoryPressure { false };
 
     std::unique_ptr<RunLoop::Timer<MemoryPressureHandler>> m_measurementTimer;
@@ -200,11 +227,16 @@ private:
 #if OS(LINUX)
     std::optional<int> m_eventFD;
     std::optional<int> m_pressureLevelFD;
+    // The cgroup listeners for the medium and critical levels. m_eventFD listens to the low level,
+    // which is signalled for every event, and these tell how serious the event was.
+    std::optional<int> m_mediumPressureEventFD;
+    std::optional<int> m_criticalPressureEventFD;
     std::unique_ptr<EventFDPoller> m_eventFDPoller;
     RunLoop::Timer<MemoryPressureHandler> m_holdOffTimer;
     void holdOffTimerFired();
     void logErrorAndCloseFDs(const char* error);
     bool tryEnsureEventFD();
+    MemoryPressureLevel cgroupMemoryPressureLevel() const;
 #endif
 };
 
@@ -214,5 +246,6 @@ extern WTFLogChannel LogMemoryPressure;
 
 using WTF::Critical;
 using WTF::MemoryPressureHandler;
+using WTF::MemoryPressureLevel;
 using WTF::Synchronous;
 using WTF::WebsamProcessState;
@@ -32,6 +32,8 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <malloc.h>
+#include <stdio.h>
+#include <string.h>
 #include <sys/eventfd.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -66,6 +68,13 @@ static const unsigned s_holdOffMultiplier = 20;
 
 static const char* s_cgroupMemoryPressureLevel = "/sys/fs/cgroup/memory/memory.pressure_level";
 static const char* s_cgroupEventControl = "/sys/fs/cgroup/memory/cgroup.event_control";
+static const char* s_pressureStallInformation = "/proc/pressure/memory";
+
+// Percentage of the last 10 seconds that some or all tasks were stalled waiting for memory.
+static const double s_lowPressureSomeStallPercentage = 10;
+static const double s_mediumPressureSomeStallPercentage = 40;
+static const double s_mediumPressureFullStallPercentage = 5;
+static const double s_criticalPressureFullStallPercentage = 20;
 
 #if USE(GLIB)
 typedef struct {
@@ -99,7 +108,7 @@ static GSourceFuncs eventFDSourceFunctions = {
 };
 #endif
 
-MemoryPressureHandler::EventFDPoller::EventFDPoller(int fd, std::function<void ()>&& notifyHandler)
+MemoryPressureHandler::EventFDPoller::EventFDPoller(int fd, std::function<void (uint64_t)>&& notifyHandler)
     : m_fd(fd)
     , m_notifyHandler(WTFMove(notifyHandler))
 {
@@ -156,15 +165,16 @@ void MemoryPressureHandler::EventFDPoller::readAndNotify() const
         return;
     }
 
-    uint64_t buffer;
+    uint64_t buffer = 0;
     if (read(m_fd.value(), &buffer, sizeof(buffer)) == -1) {
         if (isFatalReadError(errno)) {
             LOG(MemoryPressure, "Failed to read eventfd.");
             return;
         }
+        buffer = 0;
     }
 
-    m_notifyHandler();
+    m_notifyHandler(buffer);
 }
 
 inline void MemoryPressureHandler::logErrorAndCloseFDs(const char* log)
@@ -180,6 +190,14 @@ inline void MemoryPressureHandler::logErrorAndCloseFDs(const char* log)
         close(m_pressureLevelFD.value());
         m_pressureLevelFD = std::nullopt;
     }
+    if (m_mediumPressureEventFD) {
+        close(m_mediumPressureEventFD.value());
+        m_mediumPressureEventFD = std::nullopt;
+    }
+    if (m_criticalPressureEventFD) {
+        close(m_criticalPressureEventFD.value());
+        m_criticalPressureEventFD = std::nullopt;
+    }
 }
 
 bool MemoryPressureHandler::tryEnsureEventFD()
@@ -202,24 +220,122 @@ bool MemoryPressureHandler::tryEnsureEventFD()
     }
     m_pressureLevelFD = fd;
 
+    // The kernel adds one to every listener's counter per event, so the counters can't tell the levels
+    // apart. An event signals the listeners of its level and of all the levels below it, though, so
+    // listening to each level on its own eventfd does.
+    fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (fd == -1) {
+        logErrorAndCloseFDs("eventfd() failed");
+        return false;
+    }
+    m_mediumPressureEventFD = fd;
+
+    fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (fd == -1) {
+        logErrorAndCloseFDs("eventfd() failed");
+        return false;
+    }
+    m_criticalPressureEventFD = fd;
+
     fd = open(s_cgroupEventControl, O_CLOEXEC | O_WRONLY);
     if (fd == -1) {
         logErrorAndCloseFDs("Failed to open cgroup.event_control");
         return false;
     }
 
-    char line[128] = {0, };
-    if (snprintf(line, sizeof(line), "%d %d low", m_eventFD.value(), m_pressureLevelFD.value()) < 0
-        || write(fd, line, strlen(line) + 1) < 0) {
-        logErrorAndCloseFDs("Failed to write cgroup.event_control");
-        close(fd);
-        return false;
+    std::pair<int, const char*> listeners[] = {
+        { m_eventFD.value(), "low" },
+        { m_mediumPressureEventFD.value(), "medium" },
+        { m_criticalPressureEventFD.value(), "critical" },
+    };
+    for (auto& listener : listeners) {
+        char line[128] = {0, };
+        if (snprintf(line, sizeof(line), "%d %d %s", listener.first, m_pressureLevelFD.value(), listener.second) < 0
+            || write(fd, line, strlen(line) + 1) < 0) {
+            logErrorAndCloseFDs("Failed to write cgroup.event_control");
+            close(fd);
+            return false;
+        }
     }
     close(fd);
 
     return true;
 }
 
+// Reads and resets the counter of a non blocking eventfd, returning whether it had been signalled.
+static bool consumeEventFD(int fd)
+{
+    uint64_t buffer = 0;
+    return read(fd, &buffer, sizeof(buffer)) == sizeof(buffer) && buffer;
+}
+
+MemoryPressureLevel MemoryPressureHandler::cgroupMemoryPressureLevel() const
+{
+    // Both are read so that an old event doesn't make the next one look more serious than it is.
+    bool medium = consumeEventFD(m_mediumPressureEventFD.value());
+    bool critical = consumeEventFD(m_criticalPressureEventFD.value());
+    if (critical)
+        return MemoryPressureLevel::Critical;
+    if (medium)
+        return MemoryPressureLevel::Medium;
+    return MemoryPressureLevel::Low;
+}
+
+static MemoryPressureLevel memoryPressureLevelForMonitorEventCount(uint64_t count)
+{
+    // Several notifications may have added up before we read them, the most severe one wins.
+    if (count >= MemoryPressureHandler::memoryPressureMonitorEventValue(MemoryPressureLevel::Critical))
+        return MemoryPressureLevel::Critical;
+    if (count >= MemoryPressureHandler::memoryPressureMonitorEventValue(MemoryPressureLevel::Medium))
+        return MemoryPressureLevel::Medium;
+    if (count >= MemoryPressureHandler::memoryPressureMonitorEventValue(MemoryPressureLevel::Low))
+        return MemoryPressureLevel::Low;
+    return MemoryPressureLevel::None;
+}
+
+static std::optional<MemoryPressureLevel> memoryPressureLevelFromStallInformation()
+{
+    FILE* file = fopen(s_pressureStallInformation, "r");
+    if (!file)
+        return std::nullopt;
+
+    double some = -1;
+    double full = -1;
+    char buffer[128];
+    while (char* line = fgets(buffer, 128, file)) {
+        if (!strncmp(line, "some ", 5))
+            sscanf(line, "some avg10=%lf", &some);
+        else if (!strncmp(line, "full ", 5))
+            sscanf(line, "full avg10=%lf", &full);
+    }
+    fclose(file);
+
+    if (some < 0)
+        return std::nullopt;
+
+    if (full >= s_criticalPressureFullStallPercentage)
+        return MemoryPressureLevel::Critical;
+    if (some >= s_mediumPressureSomeStallPercentage || full >= s_mediumPressureFullStallPercentage)
+        return MemoryPressureLevel::Medium;
+    if (some >= s_lowPressureSomeStallPercentage)
+        return MemoryPressureLevel::Low;
+    return MemoryPressureLevel::None;
+}
+
+static MemoryPressureLevel memoryPressureLevelForNotification(MemoryPressureLevel level)
+{
+    // The notified level is None when another process sharing the monitor's eventfd read it first.
+    // Pressure stall information, when the kernel provides it, tells how much we are actually
+    // stalling right now, so trust whichever of the two is more severe.
+    if (auto stallLevel = memoryPressureLevelFromStallInformation())
+        level = std::max(level, stallLevel.value());
+    else if (level == MemoryPressureLevel::None) {
+        // Nothing tells us how serious this is, assume the worst as we always used to.
+        level = MemoryPressureLevel::Critical;
+    }
+    return std::max(level, MemoryPressureLevel::Low);
+}
+
 void MemoryPressureHandler::install()
 {
     if (m_installed || m_holdOffTimer.isActive())
@@ -228,19 +344,23 @@ void MemoryPressureHandler::install()
     if (!tryEnsureEventFD())
         return;
 
-    m_eventFDPoller = std::make_unique<EventFDPoller>(m_eventFD.value(), [this] {
-        // FIXME: Current memcg does not provide any way for users to know how serious the memory pressure is.
-        // So we assume all notifications from memcg are critical for now. If memcg had better inferfaces
-        // to get a detailed memory pressure level in the future, we should update here accordingly.
-        bool critical = true;
+    m_eventFDPoller = std::make_unique<EventFDPoller>(m_eventFD.value(), [this] (uint64_t eventCount) {
+        MemoryPressureLevel level = memoryPressureLevelForNotification(m_pressureLevelFD ? cgroupMemoryPressureLevel() : memoryPressureLevelForMonitorEventCount(eventCount));
+        bool critical = level == MemoryPressureLevel::Critical;
         if (ReliefLogger::loggingEnabled())
-            LOG(MemoryPressure, "Got memory pressure notification (%s)", critical ? "critical" : "non-critical");
+            LOG(MemoryPressure, "Got memory pressure notification (level %d)", static_cast<int>(level));
 
-        setUnderMemoryPressure(critical);
-        if (isMainThread())
+        // Low pressure is only a hint to trim caches, it shouldn't make anyone stop caching.
+        setUnderMemoryPressure(level >= MemoryPressureLevel::Medium);
+        auto respond = [this, level, critical] {
+            m_pressureLevel = level;
             respondToMemoryPressure(critical ? Critical::Yes : Critical::No);
+            m_pressureLevel = MemoryPressureLevel::None;
+        };
+        if (isMainThread())
+            respond();
         else
-            RunLoop::main().dispatch([this, critical] { respondToMemoryPressure(critical ? Critical::Yes : Critical::No); });
+            RunLoop::main().dispatch(WTFMove(respond));
     });
 
     if (ReliefLogger::loggingEnabled() && isUnderMemoryPressure())
@@ -262,11 +382,19 @@ void MemoryPressureHandler::uninstall()
         close(m_pressureLevelFD.value());
         m_pressureLevelFD = std::nullopt;
 
-        // Only close the eventFD used for cgroups.
+        // Only close the eventFDs used for cgroups.
         if (m_eventFD) {
             close(m_eventFD.value());
             m_eventFD = std::nullopt;
         }
+        if (m_mediumPressureEventFD) {
+            close(m_mediumPressureEventFD.value());
+            m_mediumPressureEventFD = std::nullopt;
+        }
+        if (m_criticalPressureEventFD) {
+            close(m_criticalPressureEventFD.value());
+            m_criticalPressureEventFD = std::nullopt;
+        }
     }
 
     m_installed = false;
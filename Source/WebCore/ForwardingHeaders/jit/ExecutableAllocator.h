@@ -0,0 +1,4 @@
+#ifndef WebCore_FWD_ExecutableAllocator_h
+#define WebCore_FWD_ExecutableAllocator_h
+#include <JavaScriptCore/ExecutableAllocator.h>
+#endif
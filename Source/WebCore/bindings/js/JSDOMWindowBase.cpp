@@ -28,6 +28,7 @@
 #include "Chrome.h"
 #include "CommonVM.h"
 #include "DOMWindow.h"
+#include "Document.h"
 #include "Frame.h"
 #include "InspectorController.h"
 #include "JSDOMBindingSecurity.h"
@@ -74,7 +75,8 @@ const GlobalObjectMethodTable JSDOMWindowBase::s_globalObjectMethodTable = {
     nullptr, // moduleLoaderInstantiate
     &moduleLoaderEvaluate,
     &promiseRejectionTracker,
-    &defaultLanguage
+    &defaultLanguage,
+    &webAssemblyModuleCachePartition
 };
 
 JSDOMWindowBase::JSDOMWindowBase(VM& vm, Structure* structure, RefPtr<DOMWindow>&& window, JSDOMWindowShell* shell)
@@ -198,6 +200,15 @@ RuntimeFlags JSDOMWindowBase::javaScriptRuntimeFlags(const JSGlobalObject* objec
     return frame->settings().javaScriptRuntimeFlags();
 }
 
+String JSDOMWindowBase::webAssemblyModuleCachePartition(const JSGlobalObject* object)
+{
+    const JSDOMWindowBase* thisObject = static_cast<const JSDOMWindowBase*>(object);
+    Document* document = thisObject->wrapped().document();
+    if (!document || document->securityOrigin().isUnique())
+        return String();
+    return document->securityOrigin().toString();
+}
+
 class JSDOMWindowMicrotaskCallback : public RefCounted<JSDOMWindowMicrotaskCallback> {
 public:
     static Ref<JSDOMWindowMicrotaskCallback> create(JSDOMWindowBase& globalObject, Ref<JSC::Microtask>&& task)
@@ -34,6 +34,7 @@
 #include "JSDynamicDowncast.h"
 #include "JSWorkerGlobalScope.h"
 #include "Language.h"
+#include "SecurityOrigin.h"
 #include "WorkerGlobalScope.h"
 #include "WorkerThread.h"
 #include <runtime/JSCInlines.h>
@@ -58,7 +59,8 @@ const GlobalObjectMethodTable JSWorkerGlobalScopeBase::s_globalObjectMethodTable
     nullptr, // moduleLoaderInstantiate
     nullptr, // moduleLoaderEvaluate
     nullptr, // promiseRejectionTracker
-    &defaultLanguage
+    &defaultLanguage,
+    &webAssemblyModuleCachePartition
 };
 
 JSWorkerGlobalScopeBase::JSWorkerGlobalScopeBase(JSC::VM& vm, JSC::Structure* structure, RefPtr<WorkerGlobalScope>&& impl)
@@ -114,6 +116,15 @@ RuntimeFlags JSWorkerGlobalScopeBase::javaScriptRuntimeFlags(const JSGlobalObjec
     return thisObject->m_wrapped->thread().runtimeFlags();
 }
 
+String JSWorkerGlobalScopeBase::webAssemblyModuleCachePartition(const JSGlobalObject* object)
+{
+    const JSWorkerGlobalScopeBase* thisObject = jsCast<const JSWorkerGlobalScopeBase*>(object);
+    SecurityOrigin* origin = thisObject->m_wrapped->securityOrigin();
+    if (!origin || origin->isUnique())
+        return String();
+    return origin->toString();
+}
+
 void JSWorkerGlobalScopeBase::queueTaskToEventLoop(JSGlobalObject& object, Ref<JSC::Microtask>&& task)
 {
     JSWorkerGlobalScopeBase& thisObject = static_cast<JSWorkerGlobalScopeBase&>(object);
@@ -145,6 +145,15 @@ void CSSDefaultStyleSheets::loadFullDefaultStyle()
     defaultQuirksStyle->addRulesFromSheet(*quirksStyleSheet, screenEval());
 }
 
+void CSSDefaultStyleSheets::ensureFullDefaultStyle()
+{
+    if (defaultStyleSheet)
+        return;
+
+    loadFullDefaultStyle();
+    ++defaultStyleVersion;
+}
+
 void CSSDefaultStyleSheets::loadSimpleDefaultStyle()
 {
     ASSERT(!defaultStyle);
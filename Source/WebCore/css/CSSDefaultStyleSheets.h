@@ -47,6 +47,7 @@ public:
 
     static void ensureDefaultStyleSheetsForElement(const Element&);
     static void loadFullDefaultStyle();
+    WEBCORE_EXPORT static void ensureFullDefaultStyle();
     static void loadSimpleDefaultStyle();
     static void initDefaultStyle(const Element*);
 };
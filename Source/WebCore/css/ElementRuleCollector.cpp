@@ -43,6 +43,7 @@
 #include "SelectorCompiler.h"
 #include "SelectorFilter.h"
 #include "ShadowRoot.h"
+#include "StyleParallelRuleMatcher.h"
 #include "StyleProperties.h"
 #include "StyleScope.h"
 #include "StyledElement.h"
@@ -141,6 +142,9 @@ void ElementRuleCollector::collectMatchingRules(const MatchRequest& matchRequest
     ASSERT(matchRequest.ruleSet);
     ASSERT_WITH_MESSAGE(!(m_mode == SelectorChecker::Mode::CollectingRulesIgnoringVirtualPseudoElements && m_pseudoStyleRequest.pseudoId != NOPSEUDO), "When in StyleInvalidation or SharingRules, SelectorChecker does not try to match the pseudo ID. While ElementRuleCollector supports matching a particular pseudoId in this case, this would indicate a error at the call site since matching a particular element should be unnecessary.");
 
+    if (m_parallelRuleMatcher && collectPrecollectedRules(matchRequest, ruleRange))
+        return;
+
     auto* shadowRoot = m_element.containingShadowRoot();
     if (shadowRoot && shadowRoot->mode() == ShadowRootMode::UserAgent)
         collectMatchingShadowPseudoElementRules(matchRequest, ruleRange);
@@ -163,6 +167,51 @@ void ElementRuleCollector::collectMatchingRules(const MatchRequest& matchRequest
     collectMatchingRulesForList(matchRequest.ruleSet->universalRules(), matchRequest, ruleRange);
 }
 
+bool ElementRuleCollector::collectPrecollectedRules(const MatchRequest& matchRequest, StyleResolver::RuleRange& ruleRange)
+{
+    // Rules are precollected for plain style resolution of the element itself only.
+    if (m_mode != SelectorChecker::Mode::ResolvingStyle || m_pseudoStyleRequest.pseudoId != NOPSEUDO || m_sameOriginOnly)
+        return false;
+    if (matchRequest.includeEmptyRules || matchRequest.styleScopeOrdinal != Style::ScopeOrdinal::Element)
+        return false;
+
+    auto* rules = m_parallelRuleMatcher->precollectedRules(m_element, *matchRequest.ruleSet);
+    if (!rules)
+        return false;
+
+    for (auto& matchedRule : rules->matchedRules)
+        addMatchedRule(*matchedRule.ruleData, matchedRule.specificity, matchRequest.styleScopeOrdinal, ruleRange);
+    m_styleRelations.appendVector(rules->styleRelations);
+    m_matchedPseudoElementIds.merge(rules->matchedPseudoElementIds);
+    if (rules->didMatchUncommonAttributeSelector)
+        m_didMatchUncommonAttributeSelector = true;
+    return true;
+}
+
+bool ElementRuleCollector::collectMatchingRulesOffMainThread(const RuleSet& ruleSet, Style::PrecollectedRules& rules)
+{
+    ASSERT(!m_parallelRuleMatcher);
+    ASSERT(m_mode == SelectorChecker::Mode::ResolvingStyle);
+
+    clearMatchedRules();
+
+    SetForScope<bool> change(m_isMatchingOffMainThread, true);
+    m_didSkipRuleRequiringMainThread = false;
+
+    int firstRuleIndex = -1, lastRuleIndex = -1;
+    StyleResolver::RuleRange ruleRange(firstRuleIndex, lastRuleIndex);
+    collectMatchingRules(MatchRequest(&ruleSet), ruleRange);
+
+    if (m_didSkipRuleRequiringMainThread)
+        return false;
+
+    rules.matchedRules.appendVector(m_matchedRules);
+    rules.styleRelations = WTFMove(m_styleRelations);
+    rules.matchedPseudoElementIds = m_matchedPseudoElementIds;
+    rules.didMatchUncommonAttributeSelector = m_didMatchUncommonAttributeSelector;
+    return true;
+}
+
 void ElementRuleCollector::collectMatchingRulesForRegion(const MatchRequest& matchRequest, StyleResolver::RuleRange& ruleRange)
 {
     if (!m_regionForStyling)
@@ -396,9 +445,15 @@ inline bool ElementRuleCollector::ruleMatches(const RuleData& ruleData, unsigned
         return true;
     }
 
+    if (m_isMatchingOffMainThread && !ruleData.canMatchOffMainThread()) {
+        m_didSkipRuleRequiringMainThread = true;
+        return false;
+    }
+
 #if ENABLE(CSS_SELECTOR_JIT)
     void* compiledSelectorChecker = ruleData.compiledSelectorCodeRef().code().executableAddress();
-    if (!compiledSelectorChecker && ruleData.compilationStatus() == SelectorCompilationStatus::NotCompiled) {
+    // Selectors are only compiled on the main thread. Helper threads take the slow path until then.
+    if (!compiledSelectorChecker && ruleData.compilationStatus() == SelectorCompilationStatus::NotCompiled && !m_isMatchingOffMainThread) {
         JSC::VM& vm = m_element.document().scriptExecutionContext()->vm();
         SelectorCompilationStatus compilationStatus;
         JSC::MacroAssemblerCodeRef compiledSelectorCodeRef;
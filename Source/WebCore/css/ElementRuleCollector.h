@@ -37,6 +37,11 @@ class RuleData;
 class RuleSet;
 class SelectorFilter;
 
+namespace Style {
+class ParallelRuleMatcher;
+struct PrecollectedRules;
+}
+
 struct MatchedRule {
     const RuleData* ruleData;
     unsigned specificity;   
@@ -58,6 +63,10 @@ public:
     void setSameOriginOnly(bool f) { m_sameOriginOnly = f; } 
     void setRegionForStyling(const RenderRegion* regionForStyling) { m_regionForStyling = regionForStyling; }
     void setMedium(const MediaQueryEvaluator* medium) { m_isPrintStyle = medium->mediaTypeMatchSpecific("print"); }
+    void setParallelRuleMatcher(const Style::ParallelRuleMatcher* parallelRuleMatcher) { m_parallelRuleMatcher = parallelRuleMatcher; }
+
+    // Safe to call on a helper thread. Returns false if some rule could only be matched on the main thread.
+    bool collectMatchingRulesOffMainThread(const RuleSet&, Style::PrecollectedRules&);
 
     bool hasAnyMatchingRules(const RuleSet*);
 
@@ -83,6 +92,7 @@ private:
     std::unique_ptr<RuleSet::RuleDataVector> collectSlottedPseudoElementRulesForSlot(bool includeEmptyRules);
 
     void collectMatchingRules(const MatchRequest&, StyleResolver::RuleRange&);
+    bool collectPrecollectedRules(const MatchRequest&, StyleResolver::RuleRange&);
     void collectMatchingRulesForRegion(const MatchRequest&, StyleResolver::RuleRange&);
     void collectMatchingRulesForList(const RuleSet::RuleDataVector*, const MatchRequest&, StyleResolver::RuleRange&);
     bool ruleMatches(const RuleData&, unsigned &specificity);
@@ -104,6 +114,9 @@ private:
     SelectorChecker::Mode m_mode { SelectorChecker::Mode::ResolvingStyle };
     bool m_isMatchingSlottedPseudoElements { false };
     bool m_isMatchingHostPseudoClass { false };
+    const Style::ParallelRuleMatcher* m_parallelRuleMatcher { nullptr };
+    bool m_isMatchingOffMainThread { false };
+    bool m_didSkipRuleRequiringMainThread { false };
     Vector<std::unique_ptr<RuleSet::RuleDataVector>> m_keepAliveSlottedPseudoElementRules;
 
     Vector<MatchedRule, 64> m_matchedRules;
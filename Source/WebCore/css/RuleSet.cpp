@@ -135,6 +135,87 @@ static inline bool containsUncommonAttributeSelector(const CSSSelector& rootSele
     return containsUncommonAttributeSelector(rootSelector, true);
 }
 
+static bool selectorCanMatchOffMainThread(const CSSSelector& rootSelector)
+{
+    for (const CSSSelector* selector = &rootSelector; selector; selector = selector->tagHistory()) {
+        switch (selector->match()) {
+        case CSSSelector::Tag:
+        case CSSSelector::Id:
+        case CSSSelector::Class:
+        case CSSSelector::Exact:
+        case CSSSelector::Set:
+        case CSSSelector::List:
+        case CSSSelector::Hyphen:
+        case CSSSelector::Contain:
+        case CSSSelector::Begin:
+        case CSSSelector::End:
+            break;
+        case CSSSelector::PseudoClass:
+            switch (selector->pseudoClassType()) {
+            case CSSSelector::PseudoClassNthChild:
+            case CSSSelector::PseudoClassNthOfType:
+            case CSSSelector::PseudoClassNthLastChild:
+            case CSSSelector::PseudoClassNthLastOfType:
+                // The nth arguments are parsed lazily. Do it now so that matching never writes to the selector.
+                selector->parseNth();
+                break;
+            case CSSSelector::PseudoClassEmpty:
+            case CSSSelector::PseudoClassFirstChild:
+            case CSSSelector::PseudoClassFirstOfType:
+            case CSSSelector::PseudoClassLastChild:
+            case CSSSelector::PseudoClassLastOfType:
+            case CSSSelector::PseudoClassOnlyChild:
+            case CSSSelector::PseudoClassOnlyOfType:
+            case CSSSelector::PseudoClassLink:
+            case CSSSelector::PseudoClassVisited:
+            case CSSSelector::PseudoClassAny:
+            case CSSSelector::PseudoClassAnyLink:
+            case CSSSelector::PseudoClassAnyLinkDeprecated:
+            case CSSSelector::PseudoClassHover:
+            case CSSSelector::PseudoClassFocus:
+            case CSSSelector::PseudoClassFocusWithin:
+            case CSSSelector::PseudoClassActive:
+            case CSSSelector::PseudoClassMatches:
+            case CSSSelector::PseudoClassTarget:
+            case CSSSelector::PseudoClassNot:
+            case CSSSelector::PseudoClassRoot:
+            case CSSSelector::PseudoClassScope:
+                break;
+            default:
+                // Form control, language and fullscreen state may be computed lazily or allocate strings.
+                return false;
+            }
+            break;
+        case CSSSelector::PseudoElement:
+            switch (selector->pseudoElementType()) {
+            case CSSSelector::PseudoElementAfter:
+            case CSSSelector::PseudoElementBefore:
+            case CSSSelector::PseudoElementFirstLetter:
+            case CSSSelector::PseudoElementFirstLine:
+            case CSSSelector::PseudoElementSelection:
+                break;
+            default:
+                return false;
+            }
+            break;
+        case CSSSelector::PagePseudoClass:
+        case CSSSelector::Unknown:
+            return false;
+        }
+
+        if (const CSSSelectorList* selectorList = selector->selectorList()) {
+            for (const CSSSelector* subSelector = selectorList->first(); subSelector; subSelector = CSSSelectorList::next(subSelector)) {
+                if (!selectorCanMatchOffMainThread(*subSelector))
+                    return false;
+            }
+        }
+
+        if (selector->relation() == CSSSelector::ShadowDescendant)
+            return false;
+    }
+    return true;
+}
+
 static inline PropertyWhitelistType determinePropertyWhitelistType(const AddRuleFlags addRuleFlags, const CSSSelector* selector)
 {
     if (addRuleFlags & RuleIsInRegionRule)
@@ -150,6 +231,16 @@ static inline PropertyWhitelistType determinePropertyWhitelistType(const AddRule
     return PropertyWhitelistNone;
 }
 
+static unsigned selectorListIndex(const CSSSelectorList& selectorList, unsigned selectorIndex)
+{
+    unsigned listIndex = 0;
+    for (size_t index = 0; index != selectorIndex; index = selectorList.indexOfNextSelectorAfter(index)) {
+        ASSERT(index != notFound);
+        ++listIndex;
+    }
+    return listIndex;
+}
+
 RuleData::RuleData(StyleRule* rule, unsigned selectorIndex, unsigned position, AddRuleFlags addRuleFlags)
     : m_rule(rule)
     , m_selectorIndex(selectorIndex)
@@ -160,6 +251,8 @@ RuleData::RuleData(StyleRule* rule, unsigned selectorIndex, unsigned position, A
     , m_containsUncommonAttributeSelector(WebCore::containsUncommonAttributeSelector(*selector()))
     , m_linkMatchType(SelectorChecker::determineLinkMatchType(selector()))
     , m_propertyWhitelistType(determinePropertyWhitelistType(addRuleFlags, selector()))
+    , m_canMatchOffMainThread(selectorCanMatchOffMainThread(*selector()))
+    , m_selectorListIndex(selectorListIndex(rule->selectorList(), selectorIndex))
 #if ENABLE(CSS_SELECTOR_JIT) && CSS_SELECTOR_JIT_PROFILING
     , m_compiledSelectorUseCount(0)
 #endif
@@ -79,6 +79,8 @@ public:
     unsigned linkMatchType() const { return m_linkMatchType; }
     bool hasDocumentSecurityOrigin() const { return m_hasDocumentSecurityOrigin; }
     PropertyWhitelistType propertyWhitelistType() const { return static_cast<PropertyWhitelistType>(m_propertyWhitelistType); }
+    // True if SelectorChecker can match this rule on a helper thread without touching main thread only state.
+    bool canMatchOffMainThread() const { return m_canMatchOffMainThread; }
     // Try to balance between memory usage (there can be lots of RuleData objects) and good filtering performance.
     static const unsigned maximumIdentifierCount = 4;
     const unsigned* descendantSelectorIdentifierHashes() const { return m_descendantSelectorIdentifierHashes; }
@@ -86,17 +88,27 @@ public:
     void disableSelectorFiltering() { m_descendantSelectorIdentifierHashes[0] = 0; }
 
 #if ENABLE(CSS_SELECTOR_JIT)
-    SelectorCompilationStatus compilationStatus() const { return m_compilationStatus; }
-    JSC::MacroAssemblerCodeRef compiledSelectorCodeRef() const { return m_compiledSelectorCodeRef; }
+    // Compiled code is stored on the StyleRule so it is shared by every RuleSet built from the same stylesheet contents.
+    SelectorCompilationStatus compilationStatus() const
+    {
+        auto* compiledSelector = m_rule->compiledSelector(m_selectorListIndex);
+        return compiledSelector ? compiledSelector->status : SelectorCompilationStatus::NotCompiled;
+    }
+    JSC::MacroAssemblerCodeRef compiledSelectorCodeRef() const
+    {
+        auto* compiledSelector = m_rule->compiledSelector(m_selectorListIndex);
+        return compiledSelector ? compiledSelector->codeRef : JSC::MacroAssemblerCodeRef();
+    }
     void setCompiledSelector(SelectorCompilationStatus status, JSC::MacroAssemblerCodeRef codeRef) const
     {
-        m_compilationStatus = status;
-        m_compiledSelectorCodeRef = codeRef;
+        auto& compiledSelector = m_rule->ensureCompiledSelector(m_selectorListIndex);
+        compiledSelector.status = status;
+        compiledSelector.codeRef = codeRef;
     }
 #if CSS_SELECTOR_JIT_PROFILING
     ~RuleData()
     {
-        if (m_compiledSelectorCodeRef.code().executableAddress())
+        if (compiledSelectorCodeRef().code().executableAddress())
             dataLogF("RuleData compiled selector %d \"%s\"\n", m_compiledSelectorUseCount, selector()->selectorText().utf8().data());
     }
     void compiledSelectorUsed() const { m_compiledSelectorUseCount++; }
@@ -115,26 +127,19 @@ private:
     unsigned m_containsUncommonAttributeSelector : 1;
     unsigned m_linkMatchType : 2; //  SelectorChecker::LinkMatchMask
     unsigned m_propertyWhitelistType : 2;
+    unsigned m_canMatchOffMainThread : 1;
+    unsigned m_selectorListIndex : 13;
     // Use plain array instead of a Vector to minimize memory overhead.
     unsigned m_descendantSelectorIdentifierHashes[maximumIdentifierCount];
-#if ENABLE(CSS_SELECTOR_JIT)
-    mutable SelectorCompilationStatus m_compilationStatus;
-    mutable JSC::MacroAssemblerCodeRef m_compiledSelectorCodeRef;
-#if CSS_SELECTOR_JIT_PROFILING
+#if ENABLE(CSS_SELECTOR_JIT) && CSS_SELECTOR_JIT_PROFILING
     mutable unsigned m_compiledSelectorUseCount;
 #endif
-#endif // ENABLE(CSS_SELECTOR_JIT)
 };
     
 struct SameSizeAsRuleData {
-#if ENABLE(CSS_SELECTOR_JIT)
-    unsigned compilationStatus;
-    void* compiledSelectorPointer;
-    void* codeRefPtr;
-#if CSS_SELECTOR_JIT_PROFILING
+#if ENABLE(CSS_SELECTOR_JIT) && CSS_SELECTOR_JIT_PROFILING
     unsigned compiledSelectorUseCount;
 #endif
-#endif // ENABLE(CSS_SELECTOR_JIT)
 
     void* a;
     unsigned b;
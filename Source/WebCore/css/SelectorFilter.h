@@ -44,6 +44,11 @@ public:
 
     void pushParent(Element* parent);
     void popParent() { popParentStackFrame(); }
+
+    // Collecting the hashes creates atomic strings, so filters built on helper threads use hashes collected on the main thread.
+    static void collectElementIdentifierHashes(const Element&, Vector<unsigned, 4>& identifierHashes);
+    void pushParent(Element* parent, const Vector<unsigned, 4>& identifierHashes);
+
     bool parentStackIsEmpty() const { return m_parentStack.isEmpty(); }
     bool parentStackIsConsistent(const ContainerNode* parentNode) const;
 
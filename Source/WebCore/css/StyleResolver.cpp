@@ -408,6 +408,7 @@ ElementStyle StyleResolver::styleForElement(const Element& element, const Render
     ElementRuleCollector collector(element, m_ruleSets, m_state.selectorFilter());
     collector.setRegionForStyling(regionForStyling);
     collector.setMedium(&m_mediaQueryEvaluator);
+    collector.setParallelRuleMatcher(m_parallelRuleMatcher);
 
     if (matchingBehavior == MatchOnlyUserAgentRules)
         collector.matchUARules();
@@ -88,6 +88,10 @@ class SVGSVGElement;
 class ViewportStyleResolver;
 struct ResourceLoaderOptions;
 
+namespace Style {
+class ParallelRuleMatcher;
+}
+
 // MatchOnlyUserAgentRules is used in media queries, where relative units
 // are interpreted according to the document root element style, and styled only
 // from the User Agent Stylesheet rules.
@@ -160,6 +164,7 @@ public:
     const MediaQueryEvaluator& mediaQueryEvaluator() const { return m_mediaQueryEvaluator; }
 
     void setOverrideDocumentElementStyle(RenderStyle* style) { m_overrideDocumentElementStyle = style; }
+    void setParallelRuleMatcher(const Style::ParallelRuleMatcher* parallelRuleMatcher) { m_parallelRuleMatcher = parallelRuleMatcher; }
 
 private:
     std::unique_ptr<RenderStyle> styleForKeyframe(const RenderStyle*, const StyleRuleKeyframe*, KeyframeValue&);
@@ -509,6 +514,7 @@ private:
     bool m_matchAuthorAndUserStyles;
 
     RenderStyle* m_overrideDocumentElementStyle { nullptr };
+    const Style::ParallelRuleMatcher* m_parallelRuleMatcher { nullptr };
 
     Vector<MediaQueryResult> m_viewportDependentMediaQueryResults;
     Vector<MediaQueryResult> m_accessibilitySettingsDependentMediaQueryResults;
@@ -34,6 +34,7 @@
 #include "CSSSupportsRule.h"
 #include "CSSUnknownRule.h"
 #include "MediaList.h"
+#include "SelectorCompiler.h"
 #include "StyleProperties.h"
 #include "StyleRuleImport.h"
 #include "WebKitCSSRegionRule.h"
@@ -237,6 +238,35 @@ MutableStyleProperties& StyleRule::mutableProperties()
     return downcast<MutableStyleProperties>(m_properties.get());
 }
 
+void StyleRule::wrapperAdoptSelectorList(CSSSelectorList& selectors)
+{
+    m_selectorList = WTFMove(selectors);
+#if ENABLE(CSS_SELECTOR_JIT)
+    m_compiledSelectors = nullptr;
+#endif
+}
+
+#if ENABLE(CSS_SELECTOR_JIT)
+const CompiledSelector* StyleRule::compiledSelector(unsigned selectorListIndex) const
+{
+    if (!m_compiledSelectors)
+        return nullptr;
+    return &m_compiledSelectors[selectorListIndex];
+}
+
+CompiledSelector& StyleRule::ensureCompiledSelector(unsigned selectorListIndex) const
+{
+    ASSERT(isMainThread());
+    if (!m_compiledSelectors) {
+        unsigned selectorCount = 0;
+        for (const CSSSelector* selector = m_selectorList.first(); selector; selector = CSSSelectorList::next(selector))
+            ++selectorCount;
+        m_compiledSelectors = std::make_unique<CompiledSelector[]>(selectorCount);
+    }
+    return m_compiledSelectors[selectorListIndex];
+}
+#endif
+
 Ref<StyleRule> StyleRule::create(const Vector<const CSSSelector*>& selectors, Ref<StyleProperties>&& properties)
 {
     ASSERT_WITH_SECURITY_IMPLICATION(!selectors.isEmpty());
@@ -36,6 +36,9 @@ class MutableStyleProperties;
 class StyleRuleKeyframe;
 class StyleProperties;
 class StyleRuleKeyframes;
+#if ENABLE(CSS_SELECTOR_JIT)
+struct CompiledSelector;
+#endif
     
 class StyleRuleBase : public WTF::RefCountedBase {
     WTF_MAKE_FAST_ALLOCATED;
@@ -124,9 +127,17 @@ public:
     const StyleProperties* propertiesWithoutDeferredParsing() const;
 
     void parserAdoptSelectorVector(Vector<std::unique_ptr<CSSParserSelector>>& selectors) { m_selectorList.adoptSelectorVector(selectors); }
-    void wrapperAdoptSelectorList(CSSSelectorList& selectors) { m_selectorList = WTFMove(selectors); }
+    void wrapperAdoptSelectorList(CSSSelectorList&);
     void parserAdoptSelectorArray(CSSSelector* selectors) { m_selectorList.adoptSelectorArray(selectors); }
 
+#if ENABLE(CSS_SELECTOR_JIT)
+    // Compiled selector code only depends on the selector, so it is kept with the rule and reused by every
+    // RuleSet that references it, including those of other documents sharing the same StyleSheetContents.
+    // Indexed by position in the selector list. Returns null if nothing has been compiled for this rule.
+    const CompiledSelector* compiledSelector(unsigned selectorListIndex) const;
+    CompiledSelector& ensureCompiledSelector(unsigned selectorListIndex) const;
+#endif
+
     Ref<StyleRule> copy() const { return adoptRef(*new StyleRule(*this)); }
 
     Vector<RefPtr<StyleRule>> splitIntoMultipleRulesWithMaximumSelectorComponentCount(unsigned) const;
@@ -141,6 +152,9 @@ private:
 
     mutable Ref<StylePropertiesBase> m_properties;
     CSSSelectorList m_selectorList;
+#if ENABLE(CSS_SELECTOR_JIT)
+    mutable std::unique_ptr<CompiledSelector[]> m_compiledSelectors;
+#endif
 };
 
 inline const StyleProperties* StyleRule::propertiesWithoutDeferredParsing() const
@@ -24,6 +24,7 @@
 #include "CSSImportRule.h"
 #include "CSSParser.h"
 #include "CSSStyleSheet.h"
+#include "CSSTokenizer.h"
 #include "CachedCSSStyleSheet.h"
 #include "Document.h"
 #include "MediaList.h"
@@ -36,6 +37,7 @@
 #include "StyleRule.h"
 #include "StyleRuleImport.h"
 #include <wtf/Deque.h>
+#include <wtf/MonotonicTime.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/Ref.h>
 
@@ -333,8 +335,10 @@ void StyleSheetContents::parseAuthorStyleSheet(const CachedCSSStyleSheet* cached
         return;
     }
 
+    auto parsingStartTime = MonotonicTime::now();
     CSSParser p(parserContext());
-    p.parseSheet(this, sheetText, CSSParser::RuleParsing::Deferred);
+    p.parseSheet(this, sheetText, cachedStyleSheet->createBackgroundTokenizedTokenizer(sheetText), CSSParser::RuleParsing::Deferred);
+    const_cast<CachedCSSStyleSheet*>(cachedStyleSheet)->setRecreationCost(MonotonicTime::now() - parsingStartTime);
 
     if (m_parserContext.needsSiteSpecificQuirks && isStrictParserMode(m_parserContext.mode)) {
         // Work around <https://bugs.webkit.org/show_bug.cgi?id=28350>.
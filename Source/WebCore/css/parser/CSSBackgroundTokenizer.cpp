@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "CSSBackgroundTokenizer.h"
+
+#include "CSSTokenizer.h"
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/WorkQueue.h>
+
+namespace WebCore {
+
+// Tokenizing retries from the start of the pending text until a top-level block is complete,
+// so don't try again before a reasonable amount of new text has arrived.
+static const unsigned minimumAttemptLength = 16 * 1024;
+
+static WorkQueue& tokenizerQueue()
+{
+    static NeverDestroyed<Ref<WorkQueue>> queue(WorkQueue::create("org.webkit.CSSBackgroundTokenizer", WorkQueue::Type::Serial, WorkQueue::QOS::UserInitiated));
+    return queue.get();
+}
+
+CSSBackgroundTokenizer::~CSSBackgroundTokenizer()
+{
+}
+
+void CSSBackgroundTokenizer::append(const String& text)
+{
+    ASSERT(isMainThread());
+    if (text.isEmpty())
+        return;
+
+    tokenizerQueue().dispatch([protectedThis = makeRef(*this), text = text.isolatedCopy()] {
+        protectedThis->m_pendingText.append(text);
+        if (protectedThis->m_pendingText.length() >= protectedThis->m_nextAttemptLength)
+            protectedThis->tokenizePendingText(false);
+    });
+}
+
+void CSSBackgroundTokenizer::finish()
+{
+    ASSERT(isMainThread());
+    tokenizerQueue().dispatch([protectedThis = makeRef(*this)] () mutable {
+        protectedThis->tokenizePendingText(true);
+        // The strings may be shared with main thread tokenizers from now on, so drop the last reference there.
+        callOnMainThread([protectedThis = WTFMove(protectedThis)] { });
+    });
+}
+
+void CSSBackgroundTokenizer::tokenizePendingText(bool isFinal)
+{
+    ASSERT(!isMainThread());
+    if (m_pendingText.isEmpty())
+        return;
+
+    String text = m_pendingText.toString();
+    m_pendingText.clear();
+
+    unsigned length;
+    std::unique_ptr<CSSTokenizer> tokenizer;
+    if (isFinal) {
+        tokenizer = std::make_unique<CSSTokenizer>(text);
+        length = text.length();
+    } else
+        tokenizer = std::unique_ptr<CSSTokenizer>(new CSSTokenizer(text, length));
+
+    if (length < text.length())
+        m_pendingText.append(StringView(text).substring(length));
+
+    // Back off geometrically while no block completes so a huge block is not retokenized quadratically.
+    m_nextAttemptLength = std::max(minimumAttemptLength, 2 * m_pendingText.length());
+
+    if (!length)
+        return;
+
+    // The main thread may copy the published strings right away, so nothing on this thread may
+    // still refer to them: take them from the tokenizer and destroy it first.
+    Vector<String> escapedStrings = WTFMove(tokenizer->m_stringPool);
+    Vector<CSSParserToken, 32> tokens = WTFMove(tokenizer->m_tokens);
+    tokenizer = nullptr;
+
+    LockHolder locker(m_lock);
+    m_tokens.appendVector(tokens);
+    for (auto& string : escapedStrings)
+        m_escapedStrings.append(WTFMove(string));
+    m_segments.append({ WTFMove(text), length, static_cast<unsigned>(tokens.size()) });
+}
+
+// Makes the tokens read from text, found at offset in sheetText, point into sheetText instead. The
+// style sheet keeps its text alive already, so only escaped strings need to be kept for the tokens.
+// Returns false if the character widths differ, in which case the tokens still point into text.
+static bool rebaseTokens(CSSParserToken* begin, CSSParserToken* end, const String& text, const String& sheetText, unsigned offset)
+{
+    if (text.is8Bit() != sheetText.is8Bit())
+        return false;
+
+    for (auto* token = begin; token != end; ++token) {
+        if (!token->hasStringBacking())
+            continue;
+        StringView value = token->value();
+        if (value.is8Bit() != text.is8Bit())
+            continue; // An escaped string.
+        size_t valueOffset;
+        if (text.is8Bit()) {
+            if (value.characters8() < text.characters8() || value.characters8() >= text.characters8() + text.length())
+                continue;
+            valueOffset = value.characters8() - text.characters8();
+        } else {
+            if (value.characters16() < text.characters16() || value.characters16() >= text.characters16() + text.length())
+                continue;
+            valueOffset = value.characters16() - text.characters16();
+        }
+        *token = token->copyWithUpdatedString(StringView(sheetText).substring(offset + valueOffset, value.length()));
+    }
+    return true;
+}
+
+std::unique_ptr<CSSTokenizer> CSSBackgroundTokenizer::createTokenizer(const String& sheetText)
+{
+    ASSERT(isMainThread());
+
+    Vector<CSSParserToken> tokens;
+    Vector<String> stringPool;
+    unsigned offset = 0;
+    {
+        LockHolder locker(m_lock);
+        // Copy, since the tokens are rebased and this may be called again with another string.
+        tokens = m_tokens;
+        stringPool = m_escapedStrings;
+        size_t firstToken = 0;
+        for (auto& segment : m_segments) {
+            if (offset + segment.length > sheetText.length())
+                return nullptr;
+            if (StringView(sheetText).substring(offset, segment.length) != StringView(segment.text).left(segment.length))
+                return nullptr;
+            auto* begin = tokens.data() + firstToken;
+            if (!rebaseTokens(begin, begin + segment.tokenCount, segment.text, sheetText, offset))
+                stringPool.append(segment.text);
+            firstToken += segment.tokenCount;
+            offset += segment.length;
+        }
+    }
+
+    if (offset < sheetText.length()) {
+        String remainingText = sheetText.substring(offset);
+        CSSTokenizer tokenizer(remainingText);
+        size_t firstToken = tokens.size();
+        tokens.appendVector(tokenizer.m_tokens);
+        stringPool.appendVector(tokenizer.m_stringPool);
+        if (!rebaseTokens(tokens.data() + firstToken, tokens.data() + tokens.size(), remainingText, sheetText, offset))
+            stringPool.append(remainingText);
+    }
+
+    return std::make_unique<CSSTokenizer>(tokens, stringPool);
+}
+
+} // namespace WebCore
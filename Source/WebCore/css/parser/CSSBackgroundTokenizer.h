@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "CSSParserToken.h"
+#include <wtf/Lock.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringBuilder.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+class CSSTokenizer;
+
+// Tokenizes a style sheet on a background thread while it is being received, so that only rule
+// building is left for the main thread once loading finishes. The input is cut after each complete
+// top-level block, since tokens before that point can't be affected by text that has not arrived yet.
+class CSSBackgroundTokenizer : public ThreadSafeRefCounted<CSSBackgroundTokenizer> {
+public:
+    static Ref<CSSBackgroundTokenizer> create() { return adoptRef(*new CSSBackgroundTokenizer); }
+    ~CSSBackgroundTokenizer();
+
+    void append(const String&);
+    void finish();
+
+    // Doesn't wait for the background thread: the part of sheetText it has not tokenized yet is
+    // tokenized on the calling thread. Returns null if the text tokenized so far doesn't match sheetText.
+    std::unique_ptr<CSSTokenizer> createTokenizer(const String& sheetText);
+
+private:
+    CSSBackgroundTokenizer() = default;
+
+    void tokenizePendingText(bool isFinal);
+
+    struct Segment {
+        String text;
+        unsigned length; // The tokens only cover text up to this length.
+        unsigned tokenCount;
+    };
+
+    // Only accessed on the background thread.
+    StringBuilder m_pendingText;
+    unsigned m_nextAttemptLength { 0 };
+
+    // Published by the background thread after each complete top-level block.
+    Lock m_lock;
+    Vector<CSSParserToken> m_tokens;
+    Vector<String> m_escapedStrings;
+    Vector<Segment> m_segments;
+};
+
+} // namespace WebCore
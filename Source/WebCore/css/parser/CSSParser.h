@@ -31,6 +31,7 @@ namespace WebCore {
 
 class CSSParserObserver;
 class CSSSelectorList;
+class CSSTokenizer;
 class Color;
 class Element;
 class ImmutableStyleProperties;
@@ -52,6 +53,8 @@ public:
 
     enum class RuleParsing { Normal, Deferred };
     void parseSheet(StyleSheetContents*, const String&, RuleParsing = RuleParsing::Normal);
+    // The tokenizer must have been created from the same string, ahead of time.
+    void parseSheet(StyleSheetContents*, const String&, std::unique_ptr<CSSTokenizer>, RuleParsing = RuleParsing::Normal);
     
     static RefPtr<StyleRuleBase> parseRule(const CSSParserContext&, StyleSheetContents*, const String&);
     
@@ -92,6 +92,38 @@ CSSTokenizer::CSSTokenizer(const String& string, CSSParserObserverWrapper& wrapp
     wrapper.finalizeConstruction(m_tokens.begin());
 }
 
+CSSTokenizer::CSSTokenizer(const String& string, unsigned& completeBlocksLength)
+    : m_input(string)
+{
+    completeBlocksLength = 0;
+    if (string.isEmpty())
+        return;
+
+    m_tokens.reserveInitialCapacity(string.length() / 3);
+
+    unsigned completeBlocksTokenCount = 0;
+    while (true) {
+        CSSParserToken token = nextToken();
+        if (token.type() == CommentToken)
+            continue;
+        if (token.type() == EOFToken)
+            break;
+        m_tokens.append(token);
+        if (token.type() == RightBraceToken && token.getBlockType() == CSSParserToken::BlockEnd && m_blockStack.isEmpty()) {
+            completeBlocksTokenCount = m_tokens.size();
+            completeBlocksLength = m_input.offset();
+        }
+    }
+    m_tokens.shrink(completeBlocksTokenCount);
+}
+
+CSSTokenizer::CSSTokenizer(const Vector<CSSParserToken>& tokens, const Vector<String>& stringPool)
+    : m_input(emptyString())
+    , m_stringPool(stringPool)
+{
+    m_tokens.appendVector(tokens);
+}
+
 CSSParserTokenRange CSSTokenizer::tokenRange() const
 {
     return m_tokens;
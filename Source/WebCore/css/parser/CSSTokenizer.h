@@ -47,6 +47,8 @@ class CSSTokenizer {
 public:
     CSSTokenizer(const String&);
     CSSTokenizer(const String&, CSSParserObserverWrapper&); // For the inspector
+    // For tokens produced by CSSBackgroundTokenizer. The pool keeps the strings the tokens point into alive.
+    CSSTokenizer(const Vector<CSSParserToken>&, const Vector<String>& stringPool);
 
     CSSParserTokenRange tokenRange() const;
     unsigned tokenCount();
@@ -54,6 +56,11 @@ public:
     Vector<String>&& escapedStringsForAdoption() { return WTFMove(m_stringPool); }
 
 private:
+    friend class CSSBackgroundTokenizer;
+    // Stops after the last right brace closing a top-level block. Tokens up to that point can't
+    // change if more text is appended to the input. completeBlocksLength is set to the length consumed.
+    CSSTokenizer(const String&, unsigned& completeBlocksLength);
+
     CSSParserToken nextToken();
 
     UChar consume();
@@ -66,6 +66,11 @@ private:
     Status m_status;
 };
 
+struct CompiledSelector {
+    SelectorCompilationStatus status;
+    JSC::MacroAssemblerCodeRef codeRef;
+};
+
 namespace SelectorCompiler {
 
 enum class SelectorContext {
@@ -646,6 +646,7 @@ void Document::removedLastRef()
         m_fullScreenElementStack.clear();
 #endif
         m_associatedFormControls.clear();
+        clearSelectorQueryCache();
 
         detachParser();
 
@@ -742,6 +743,14 @@ ExceptionOr<SelectorQuery&> Document::selectorQueryForString(const String& selec
 void Document::clearSelectorQueryCache()
 {
     m_selectorQueryCache = nullptr;
+    m_hasCachedSelectorQueryResults = false;
+}
+
+void Document::clearCachedSelectorQueryResults()
+{
+    m_hasCachedSelectorQueryResults = false;
+    if (m_selectorQueryCache)
+        m_selectorQueryCache->clearCachedResults();
 }
 
 MediaQueryMatcher& Document::mediaQueryMatcher()
@@ -2251,6 +2260,8 @@ void Document::prepareForDestruction()
     m_fullScreenErrorEventTargetQueue.clear();
 #endif
 
+    clearSelectorQueryCache();
+
     commonTeardown();
 
 #if ENABLE(TOUCH_EVENTS)
@@ -2744,7 +2755,7 @@ bool Document::isLayoutTimerActive()
 Seconds Document::minimumLayoutDelay()
 {
     if (m_overMinimumLayoutThreshold)
-        return 0_s;
+        return view() ? view()->budgetedLayoutDelay() : 0_s;
     
     auto elapsed = timeSinceDocumentCreation();
     m_overMinimumLayoutThreshold = elapsed > settings().layoutInterval();
@@ -345,6 +345,7 @@ public:
 
     ExceptionOr<SelectorQuery&> selectorQueryForString(const String&);
     void clearSelectorQueryCache();
+    void clearCachedSelectorQueryResults();
 
     // DOM methods & attributes for Document
 
@@ -936,9 +937,27 @@ public:
     TransformSource* transformSource() const { return m_transformSource.get(); }
 #endif
 
-    void incDOMTreeVersion() { m_domTreeVersion = ++s_globalTreeVersion; }
+    void incDOMTreeVersion()
+    {
+        m_domTreeVersion = ++s_globalTreeVersion;
+        if (m_hasCachedSelectorQueryResults)
+            clearCachedSelectorQueryResults();
+    }
     uint64_t domTreeVersion() const { return m_domTreeVersion; }
 
+    // Bumped when attribute values change without going through Element::attributeChanged(), which
+    // bumps the DOM tree version: the style attribute after CSSOM edits and animated SVG attributes.
+    void incAttributeVersion()
+    {
+        ++m_attributeVersion;
+        if (m_hasCachedSelectorQueryResults)
+            clearCachedSelectorQueryResults();
+    }
+    uint64_t attributeVersion() const { return m_attributeVersion; }
+
+    // Cached selector query results are dropped as soon as either version changes.
+    void setHasCachedSelectorQueryResults() { m_hasCachedSelectorQueryResults = true; }
+
     // XPathEvaluator methods
     WEBCORE_EXPORT ExceptionOr<Ref<XPathExpression>> createExpression(const String& expression, RefPtr<XPathNSResolver>&&);
     WEBCORE_EXPORT Ref<XPathNSResolver> createNSResolver(Node* nodeResolver);
@@ -1462,6 +1481,8 @@ private:
 
     uint64_t m_domTreeVersion;
     static uint64_t s_globalTreeVersion;
+    uint64_t m_attributeVersion { 0 };
+    bool m_hasCachedSelectorQueryResults { false };
     
     HashSet<NodeIterator*> m_nodeIterators;
     HashSet<Range*> m_ranges;
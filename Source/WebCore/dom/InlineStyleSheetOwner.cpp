@@ -58,11 +58,9 @@ static CSSParserContext parserContextForElement(const Element& element)
 
 static std::optional<InlineStyleSheetCacheKey> makeInlineStyleSheetCacheKey(const String& text, const Element& element)
 {
-    // Only cache for shadow trees. Main document inline stylesheets are generally unique and can't be shared between documents.
-    // FIXME: This could be relaxed when a stylesheet does not contain document-relative URLs (or #urls).
-    if (!element.isInShadowTree())
-        return { };
-
+    // The parser context includes the base URL so document-relative URLs (and #urls) resolve identically for every sheet
+    // sharing an entry. This lets identical <style> elements within a document, and in other documents with the same
+    // base URL (reloads, history navigations, repeated frames), share parsed contents and compiled selectors.
     return std::make_pair(text, parserContextForElement(element));
 }
 
@@ -213,7 +211,7 @@ void InlineStyleSheetOwner::createSheet(Element& element, const String& text)
         inlineStyleSheetCache().add(*cacheKey, &m_sheet->contents());
 
         // Prevent pathological growth.
-        const size_t maximumInlineStyleSheetCacheSize = 50;
+        const size_t maximumInlineStyleSheetCacheSize = 100;
         if (inlineStyleSheetCache().size() > maximumInlineStyleSheetCacheSize) {
             inlineStyleSheetCache().begin()->value->removedFromMemoryCache();
             inlineStyleSheetCache().remove(inlineStyleSheetCache().begin());
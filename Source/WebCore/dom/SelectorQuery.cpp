@@ -28,9 +28,11 @@
 #include "SelectorQuery.h"
 
 #include "CSSParser.h"
+#include "Document.h"
 #include "ElementDescendantIterator.h"
 #include "ExceptionCode.h"
 #include "HTMLNames.h"
+#include "Settings.h"
 #include "SelectorChecker.h"
 #include "StaticNodeList.h"
 #include "StyledElement.h"
@@ -170,10 +172,15 @@ struct AllElementExtractorSelectorQueryTrait {
 };
 
 Ref<NodeList> SelectorDataList::queryAll(ContainerNode& rootNode) const
+{
+    return StaticElementList::create(queryAllElements(rootNode));
+}
+
+Vector<Ref<Element>> SelectorDataList::queryAllElements(ContainerNode& rootNode) const
 {
     Vector<Ref<Element>> result;
     execute<AllElementExtractorSelectorQueryTrait>(rootNode, result);
-    return StaticElementList::create(WTFMove(result));
+    return result;
 }
 
 struct SingleElementExtractorSelectorQueryTrait {
@@ -610,10 +617,140 @@ ALWAYS_INLINE void SelectorDataList::execute(ContainerNode& rootNode, typename S
     }
 }
 
+static bool selectorOnlyDependsOnDOMTree(const CSSSelector& firstSelector)
+{
+    for (const CSSSelector* selector = &firstSelector; selector; selector = selector->tagHistory()) {
+        switch (selector->match()) {
+        case CSSSelector::Tag:
+        case CSSSelector::Id:
+        case CSSSelector::Class:
+        case CSSSelector::Exact:
+        case CSSSelector::Set:
+        case CSSSelector::List:
+        case CSSSelector::Hyphen:
+        case CSSSelector::Contain:
+        case CSSSelector::Begin:
+        case CSSSelector::End:
+            break;
+        case CSSSelector::PseudoClass:
+            switch (selector->pseudoClassType()) {
+            case CSSSelector::PseudoClassNthChild:
+            case CSSSelector::PseudoClassNthOfType:
+            case CSSSelector::PseudoClassNthLastChild:
+            case CSSSelector::PseudoClassNthLastOfType:
+            case CSSSelector::PseudoClassEmpty:
+            case CSSSelector::PseudoClassFirstChild:
+            case CSSSelector::PseudoClassFirstOfType:
+            case CSSSelector::PseudoClassLastChild:
+            case CSSSelector::PseudoClassLastOfType:
+            case CSSSelector::PseudoClassOnlyChild:
+            case CSSSelector::PseudoClassOnlyOfType:
+            case CSSSelector::PseudoClassLink:
+            case CSSSelector::PseudoClassVisited:
+            case CSSSelector::PseudoClassAnyLink:
+            case CSSSelector::PseudoClassAnyLinkDeprecated:
+            case CSSSelector::PseudoClassAny:
+            case CSSSelector::PseudoClassMatches:
+            case CSSSelector::PseudoClassNot:
+            case CSSSelector::PseudoClassRoot:
+            case CSSSelector::PseudoClassScope:
+                break;
+            default:
+                // User interaction, form control, language and custom element state are not tracked by the DOM tree version.
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+
+        if (const CSSSelectorList* selectorList = selector->selectorList()) {
+            for (const CSSSelector* subSelector = selectorList->first(); subSelector; subSelector = CSSSelectorList::next(subSelector)) {
+                if (!selectorOnlyDependsOnDOMTree(*subSelector))
+                    return false;
+            }
+        }
+
+        if (selector->relation() == CSSSelector::ShadowDescendant)
+            return false;
+    }
+    return true;
+}
+
+static bool selectorListOnlyDependsOnDOMTree(const CSSSelectorList& selectorList)
+{
+    for (const CSSSelector* selector = selectorList.first(); selector; selector = CSSSelectorList::next(selector)) {
+        if (!selectorOnlyDependsOnDOMTree(*selector))
+            return false;
+    }
+    return true;
+}
+
 SelectorQuery::SelectorQuery(CSSSelectorList&& selectorList)
     : m_selectorList(WTFMove(selectorList))
     , m_selectors(m_selectorList)
+    , m_resultsOnlyDependOnDOMTree(selectorListOnlyDependsOnDOMTree(m_selectorList))
+{
+}
+
+SelectorQuery::CachedResults* SelectorQuery::cachedResults(ContainerNode& rootNode) const
+{
+    // Detached roots are not cached, so the cache never keeps otherwise unreachable subtrees alive for long.
+    if (!m_resultsOnlyDependOnDOMTree || !rootNode.isConnected() || !rootNode.document().settings().selectorQueryResultCacheEnabled())
+        return nullptr;
+
+    auto& document = rootNode.document();
+    if (m_cachedResults.rootNode != &rootNode || m_cachedResults.domTreeVersion != document.domTreeVersion() || m_cachedResults.attributeVersion != document.attributeVersion()) {
+        m_cachedResults = { };
+        m_cachedResults.rootNode = &rootNode;
+        m_cachedResults.domTreeVersion = document.domTreeVersion();
+        m_cachedResults.attributeVersion = document.attributeVersion();
+    }
+    return &m_cachedResults;
+}
+
+void SelectorQuery::didCacheResults(ContainerNode& rootNode) const
+{
+    rootNode.document().setHasCachedSelectorQueryResults();
+}
+
+Ref<NodeList> SelectorQuery::queryAll(ContainerNode& rootNode) const
 {
+    auto* cachedResults = this->cachedResults(rootNode);
+    if (!cachedResults)
+        return m_selectors.queryAll(rootNode);
+
+    if (!cachedResults->allElements) {
+        auto elements = m_selectors.queryAllElements(rootNode);
+        // Matching attribute selectors may synchronize lazy attributes, which bumps the version.
+        cachedResults = this->cachedResults(rootNode);
+        cachedResults->allElements = WTFMove(elements);
+        didCacheResults(rootNode);
+    }
+
+    Vector<Ref<Element>> elements;
+    elements.reserveInitialCapacity(cachedResults->allElements->size());
+    for (auto& element : *cachedResults->allElements)
+        elements.uncheckedAppend(element.copyRef());
+    return StaticElementList::create(WTFMove(elements));
+}
+
+Element* SelectorQuery::queryFirst(ContainerNode& rootNode) const
+{
+    auto* cachedResults = this->cachedResults(rootNode);
+    if (!cachedResults)
+        return m_selectors.queryFirst(rootNode);
+
+    if (cachedResults->allElements)
+        return cachedResults->allElements->isEmpty() ? nullptr : cachedResults->allElements->first().ptr();
+
+    if (!cachedResults->firstElement) {
+        RefPtr<Element> element = m_selectors.queryFirst(rootNode);
+        cachedResults = this->cachedResults(rootNode);
+        cachedResults->firstElement = WTFMove(element);
+        didCacheResults(rootNode);
+    }
+    return cachedResults->firstElement->get();
 }
 
 ExceptionOr<SelectorQuery&> SelectorQueryCache::add(const String& selectors, Document& document)
@@ -639,4 +776,10 @@ ExceptionOr<SelectorQuery&> SelectorQueryCache::add(const String& selectors, Doc
     return *m_entries.add(selectors, std::make_unique<SelectorQuery>(WTFMove(selectorList))).iterator->value;
 }
 
+void SelectorQueryCache::clearCachedResults()
+{
+    for (auto& query : m_entries.values())
+        query->clearCachedResults();
+}
+
 }
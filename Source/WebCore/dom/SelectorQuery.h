@@ -47,6 +47,7 @@ public:
     bool matches(Element&) const;
     Element* closest(Element&) const;
     Ref<NodeList> queryAll(ContainerNode& rootNode) const;
+    Vector<Ref<Element>> queryAllElements(ContainerNode& rootNode) const;
     Element* queryFirst(ContainerNode& rootNode) const;
 
 private:
@@ -119,15 +120,36 @@ public:
     Ref<NodeList> queryAll(ContainerNode& rootNode) const;
     Element* queryFirst(ContainerNode& rootNode) const;
 
+    void clearCachedResults() { m_cachedResults = { }; }
+
 private:
+    // Only kept while the document's DOM tree and attribute versions don't change. The document drops
+    // them as soon as one does, and when it is prepared for destruction, so the elements below are
+    // never removed nodes. The root node isn't referenced: it is usually the document that owns the
+    // cache, and removing it from the tree changes the DOM tree version anyway.
+    struct CachedResults {
+        ContainerNode* rootNode { nullptr };
+        uint64_t domTreeVersion { 0 };
+        uint64_t attributeVersion { 0 };
+        std::optional<Vector<Ref<Element>>> allElements;
+        std::optional<RefPtr<Element>> firstElement;
+    };
+    CachedResults* cachedResults(ContainerNode& rootNode) const;
+    void didCacheResults(ContainerNode& rootNode) const;
+
     CSSSelectorList m_selectorList;
     SelectorDataList m_selectors;
+    // True if matching only depends on the DOM tree and attributes, so results stay valid while the
+    // document's DOM tree and attribute versions do not change.
+    bool m_resultsOnlyDependOnDOMTree;
+    mutable CachedResults m_cachedResults;
 };
 
 class SelectorQueryCache {
     WTF_MAKE_FAST_ALLOCATED;
 public:
     ExceptionOr<SelectorQuery&> add(const String&, Document&);
+    void clearCachedResults();
 private:
     HashMap<String, std::unique_ptr<SelectorQuery>> m_entries;
 };
@@ -142,14 +164,4 @@ inline Element* SelectorQuery::closest(Element& element) const
     return m_selectors.closest(element);
 }
 
-inline Ref<NodeList> SelectorQuery::queryAll(ContainerNode& rootNode) const
-{
-    return m_selectors.queryAll(rootNode);
-}
-
-inline Element* SelectorQuery::queryFirst(ContainerNode& rootNode) const
-{
-    return m_selectors.queryFirst(rootNode);
-}
-
 } // namespace WebCore
@@ -151,6 +151,8 @@ void StyledElement::invalidateStyleAttribute()
         document().setHasElementUsingStyleBasedEditability();
 
     elementData()->setStyleAttributeIsDirty(true);
+    // The style attribute value changes without going through attributeChanged().
+    document().incAttributeVersion();
     invalidateStyle();
 }
 
@@ -26,6 +26,8 @@
 #include "config.h"
 #include "CachedPage.h"
 
+#include "CachedResource.h"
+#include "CachedResourceLoader.h"
 #include "Document.h"
 #include "Element.h"
 #include "FocusController.h"
@@ -35,6 +37,7 @@
 #include "MainFrame.h"
 #include "NoEventDispatchAssertion.h"
 #include "Node.h"
+#include "NodeTraversal.h"
 #include "Page.h"
 #include "PageTransitionEvent.h"
 #include "Settings.h"
@@ -53,9 +56,26 @@ namespace WebCore {
 
 DEFINE_DEBUG_ONLY_GLOBAL(WTF::RefCountedLeakCounter, cachedPageCounter, ("CachedPage"));
 
+// This has to run before the frame tree is torn down by CachedFrame.
+static size_t memoryCostForFrameTree(MainFrame& mainFrame)
+{
+    size_t memoryCost = 0;
+    for (Frame* frame = &mainFrame; frame; frame = frame->tree().traverseNext()) {
+        auto* document = frame->document();
+        if (!document)
+            continue;
+        for (Node* node = document; node; node = NodeTraversal::next(*node))
+            memoryCost += node->approximateMemoryCost();
+        for (auto& resource : document->cachedResourceLoader().allCachedResources().values())
+            memoryCost += resource->size();
+    }
+    return memoryCost;
+}
+
 CachedPage::CachedPage(Page& page)
     : m_page(page)
     , m_expirationTime(monotonicallyIncreasingTime() + page.settings().backForwardCacheExpirationInterval())
+    , m_memoryCost(memoryCostForFrameTree(page.mainFrame()))
     , m_cachedMainFrame(std::make_unique<CachedFrame>(page.mainFrame()))
 {
 #ifndef NDEBUG
@@ -47,6 +47,9 @@ public:
     DocumentLoader* documentLoader() const { return m_cachedMainFrame->documentLoader(); }
 
     bool hasExpired() const;
+
+    // Estimated memory kept alive by the cached documents, measured when the page enters the cache.
+    size_t memoryCost() const { return m_memoryCost; }
     
     CachedFrame* cachedMainFrame() { return m_cachedMainFrame.get(); }
 
@@ -61,6 +64,7 @@ public:
 private:
     Page& m_page;
     double m_expirationTime;
+    size_t m_memoryCost;
     std::unique_ptr<CachedFrame> m_cachedMainFrame;
 #if ENABLE(VIDEO_TRACK)
     bool m_needsCaptionPreferencesChanged { false };
@@ -28,6 +28,8 @@
 
 #include "ApplicationCacheHost.h"
 #include "BackForwardController.h"
+#include "CachedResource.h"
+#include "CachedResourceLoader.h"
 #include "CachedPage.h"
 #include "DOMWindow.h"
 #include "DeviceMotionController.h"
@@ -306,6 +308,31 @@ void PageCache::setMaxSize(unsigned maxSize)
     prune(PruningReason::None);
 }
 
+void PageCache::pruneToMemoryCostNow(size_t maxMemoryCost, PruningReason pruningReason)
+{
+    if (!maxMemoryCost) {
+        pruneToSizeNow(0, pruningReason);
+        return;
+    }
+
+    SetForScope<size_t> change(m_maxMemoryCost, maxMemoryCost);
+    prune(pruningReason);
+}
+
+void PageCache::setMaxMemoryCost(size_t maxMemoryCost)
+{
+    m_maxMemoryCost = maxMemoryCost;
+    prune(PruningReason::None);
+}
+
+size_t PageCache::memoryCost() const
+{
+    size_t memoryCost = 0;
+    for (auto& item : m_items)
+        memoryCost += item->m_cachedPage->memoryCost();
+    return memoryCost;
+}
+
 unsigned PageCache::frameCount() const
 {
     unsigned frameCount = m_items.size();
@@ -369,6 +396,21 @@ static void setPageCacheState(Page& page, Document::PageCacheState pageCacheStat
     }
 }
 
+// Decoded image frames, decoded script sources and parsed style sheets can all be regenerated from the
+// encoded data, so don't keep them alive while the page sits in the cache. Resources that are also
+// used outside of this page keep their decoded data.
+static void destroyDecodedData(MainFrame& mainFrame)
+{
+    for (Frame* frame = &mainFrame; frame; frame = frame->tree().traverseNext()) {
+        if (!frame->document())
+            continue;
+        for (auto& resource : frame->document()->cachedResourceLoader().allCachedResources().values()) {
+            if (resource->decodedSize() && resource->numberOfClients() <= 1)
+                resource->destroyDecodedData();
+        }
+    }
+}
+
 // When entering page cache, tear down the render tree before setting the in-cache flag.
 // This maintains the invariant that render trees are never present in the page cache.
 // Note that destruction happens bottom-up so that the main frame's tree dies last.
@@ -427,6 +469,7 @@ void PageCache::addIfCacheable(HistoryItem& item, Page* page)
     }
 
     destroyRenderTree(page->mainFrame());
+    destroyDecodedData(page->mainFrame());
 
     setPageCacheState(*page, Document::InPageCache);
 
@@ -503,7 +546,7 @@ void PageCache::remove(HistoryItem& item)
 
 void PageCache::prune(PruningReason pruningReason)
 {
-    while (pageCount() > maxSize()) {
+    while (pageCount() > maxSize() || (m_maxMemoryCost && memoryCost() > m_maxMemoryCost)) {
         auto oldestItem = m_items.takeFirst();
         oldestItem->m_cachedPage = nullptr;
         oldestItem->m_pruningReason = pruningReason;
@@ -52,6 +52,12 @@ public:
     WEBCORE_EXPORT void setMaxSize(unsigned); // number of pages to cache.
     unsigned maxSize() const { return m_maxSize; }
 
+    // Budget for the estimated memory held by all cached pages, 0 for no limit.
+    WEBCORE_EXPORT void pruneToMemoryCostNow(size_t maxMemoryCost, PruningReason);
+    WEBCORE_EXPORT void setMaxMemoryCost(size_t);
+    size_t maxMemoryCost() const { return m_maxMemoryCost; }
+    WEBCORE_EXPORT size_t memoryCost() const;
+
     void addIfCacheable(HistoryItem&, Page*); // Prunes if maxSize() is exceeded.
     WEBCORE_EXPORT void remove(HistoryItem&);
     CachedPage* get(HistoryItem&, Page*);
@@ -78,6 +84,7 @@ private:
 
     ListHashSet<RefPtr<HistoryItem>> m_items;
     unsigned m_maxSize {0};
+    size_t m_maxMemoryCost { 0 };
 
     friend class WTF::NeverDestroyed<PageCache>;
 };
@@ -37,6 +37,7 @@
 #include "HTMLUnknownElement.h"
 #include "JSCustomElementInterface.h"
 #include "ScriptElement.h"
+#include "Settings.h"
 
 namespace WebCore {
 
@@ -83,6 +84,7 @@ HTMLDocumentParser::~HTMLDocumentParser()
     ASSERT(!m_pumpSessionNestingLevel);
     ASSERT(!m_preloadScanner);
     ASSERT(!m_insertionPreloadScanner);
+    ASSERT(!m_speculativeTokenizer);
 }
 
 void HTMLDocumentParser::detach()
@@ -96,12 +98,14 @@ void HTMLDocumentParser::detach()
     m_preloadScanner = nullptr;
     m_insertionPreloadScanner = nullptr;
     m_parserScheduler = nullptr; // Deleting the scheduler will clear any timers.
+    stopSpeculativeTokenization();
 }
 
 void HTMLDocumentParser::stopParsing()
 {
     DocumentParser::stopParsing();
     m_parserScheduler = nullptr; // Deleting the scheduler will clear any timers.
+    stopSpeculativeTokenization();
 }
 
 // This kicks off "Once the user agent stops parsing" as described by:
@@ -142,7 +146,7 @@ inline bool HTMLDocumentParser::inPumpSession() const
 
 inline bool HTMLDocumentParser::shouldDelayEnd() const
 {
-    return inPumpSession() || isWaitingForScripts() || isScheduledForResume() || isExecutingScript();
+    return inPumpSession() || isWaitingForScripts() || isScheduledForResume() || isExecutingScript() || m_speculativeTokenizer;
 }
 
 bool HTMLDocumentParser::isParsingFragment() const
@@ -241,6 +245,17 @@ bool HTMLDocumentParser::pumpTokenizerLoop(SynchronousMode mode, bool parsingFra
         if (UNLIKELY(mode == AllowYield && m_parserScheduler->shouldYieldBeforeToken(session)))
             return true;
 
+        if (m_speculativeTokenizer) {
+            if (!m_speculativeTokens.isEmpty()) {
+                constructTreeFromSpeculativeToken(m_speculativeTokens.takeFirst());
+                continue;
+            }
+            if (!m_speculativeTokenizerHasFinished)
+                return false;
+            // Everything the background tokenizer could tokenize has been consumed; the rest is ours.
+            stopSpeculativeTokenization();
+        }
+
         if (!parsingFragment)
             m_sourceTracker.startToken(m_input.current(), m_tokenizer);
 
@@ -320,6 +335,88 @@ void HTMLDocumentParser::constructTreeFromHTMLToken(HTMLTokenizer::TokenPtr& raw
     m_treeBuilder->constructTree(WTFMove(token));
 }
 
+bool HTMLDocumentParser::canTokenizeSpeculatively()
+{
+    if (isParsingFragment() || !document()->settings().threadedHTMLTokenizerEnabled())
+        return false;
+
+    // Both tokenizers need to start from the same point in the input.
+    return !m_input.hasInsertionPoint() && m_input.current().isEmpty() && !m_input.current().numberOfCharactersConsumed();
+}
+
+void HTMLDocumentParser::startSpeculativeTokenization()
+{
+    ASSERT(!m_speculativeTokenizer);
+
+    // The XSSAuditor filters every token, so the background tokenizer has to provide their source.
+    m_xssAuditor.init(document(), &m_xssAuditorDelegate);
+    auto shouldTrackSource = m_xssAuditor.isEnabled() ? HTMLSpeculativeTokenizer::ShouldTrackSource::Yes : HTMLSpeculativeTokenizer::ShouldTrackSource::No;
+
+    // The speculative tokenizer is stopped before this parser goes away, and then no longer calls back.
+    m_speculativeTokenizer = HTMLSpeculativeTokenizer::create(m_options, shouldTrackSource, [this] (Vector<HTMLSpeculativeTokenizer::Token>&& tokens, bool isFinal) {
+        didReceiveSpeculativeTokens(WTFMove(tokens), isFinal);
+    });
+}
+
+void HTMLDocumentParser::constructTreeFromSpeculativeToken(HTMLSpeculativeTokenizer::Token&& speculativeToken)
+{
+    // Consume the same input the background tokenizer did so that text positions are right and we can
+    // take over tokenizing after this token.
+    auto& input = m_input.current();
+    for (unsigned i = 0; i < speculativeToken.inputLength; ++i)
+        input.advance();
+
+    m_tokenizer.restoreCheckpoint(speculativeToken.checkpoint);
+
+    if (m_xssAuditor.isEnabled()) {
+        m_sourceTracker.setSource(WTFMove(speculativeToken.source));
+        if (auto xssInfo = m_xssAuditor.filterToken(FilterTokenRequest(speculativeToken.token, m_sourceTracker, m_tokenizer.shouldAllowCDATA())))
+            m_xssAuditorDelegate.didBlockScript(*xssInfo);
+    }
+
+    m_treeBuilder->constructTree(AtomicHTMLToken(speculativeToken.token));
+
+    if (!m_speculativeTokenizer)
+        return;
+
+    // The background tokenizer guessed how the tree builder would change the tokenizer state. If the
+    // guess was wrong, everything it tokenized after this token is wrong too.
+    auto& expectedCheckpoint = speculativeToken.predictedCheckpoint ? *speculativeToken.predictedCheckpoint : speculativeToken.checkpoint;
+    if (!m_tokenizer.isAtCheckpoint(expectedCheckpoint))
+        stopSpeculativeTokenization();
+}
+
+void HTMLDocumentParser::stopSpeculativeTokenization()
+{
+    if (!m_speculativeTokenizer)
+        return;
+
+    m_speculativeTokenizer->stop();
+    m_speculativeTokenizer = nullptr;
+    m_speculativeTokens.clear();
+    m_speculativeTokenizerHasFinished = false;
+}
+
+void HTMLDocumentParser::didReceiveSpeculativeTokens(Vector<HTMLSpeculativeTokenizer::Token>&& tokens, bool isFinal)
+{
+    ASSERT(m_speculativeTokenizer);
+    ASSERT(!m_speculativeTokenizerHasFinished);
+
+    for (auto& token : tokens)
+        m_speculativeTokens.append(WTFMove(token));
+    m_speculativeTokenizerHasFinished = isFinal;
+
+    if (isStopped() || inPumpSession())
+        return;
+
+    // pumpTokenizer can cause this parser to be detached from the Document,
+    // but we need to ensure it isn't deleted yet.
+    Ref<HTMLDocumentParser> protectedThis(*this);
+
+    pumpTokenizerIfPossible(AllowYield);
+    endIfDelayed();
+}
+
 bool HTMLDocumentParser::hasInsertionPoint()
 {
     // FIXME: The wasCreatedByScript() branch here might not be fully correct.
@@ -338,6 +435,9 @@ void HTMLDocumentParser::insert(SegmentedString&& source)
     // but we need to ensure it isn't deleted yet.
     Ref<HTMLDocumentParser> protectedThis(*this);
 
+    // document.write() input goes before anything the background tokenizer has seen.
+    stopSpeculativeTokenization();
+
     source.setExcludeLineNumbers();
     m_input.insertAtCurrentInsertionPoint(WTFMove(source));
     pumpTokenizerIfPossible(ForceSynchronous);
@@ -377,7 +477,15 @@ void HTMLDocumentParser::append(RefPtr<StringImpl>&& inputSource)
         }
     }
 
+    if (!m_didConsiderSpeculativeTokenization) {
+        m_didConsiderSpeculativeTokenization = true;
+        if (canTokenizeSpeculatively())
+            startSpeculativeTokenization();
+    }
+
     m_input.appendToEnd(source);
+    if (m_speculativeTokenizer)
+        m_speculativeTokenizer->appendToEnd(source);
 
     if (inPumpSession()) {
         // We've gotten data off the network in a nested write.
@@ -446,6 +554,9 @@ void HTMLDocumentParser::finish()
     if (!m_input.haveSeenEndOfFile())
         m_input.markEndOfFile();
 
+    if (m_speculativeTokenizer)
+        m_speculativeTokenizer->finish();
+
     attemptToEnd();
 }
 
@@ -29,11 +29,13 @@
 #include "HTMLInputStream.h"
 #include "HTMLScriptRunnerHost.h"
 #include "HTMLSourceTracker.h"
+#include "HTMLSpeculativeTokenizer.h"
 #include "HTMLTokenizer.h"
 #include "PendingScriptClient.h"
 #include "ScriptableDocumentParser.h"
 #include "XSSAuditor.h"
 #include "XSSAuditorDelegate.h"
+#include <wtf/Deque.h>
 
 namespace WebCore {
 
@@ -108,6 +110,12 @@ private:
     void pumpTokenizerIfPossible(SynchronousMode);
     void constructTreeFromHTMLToken(HTMLTokenizer::TokenPtr&);
 
+    bool canTokenizeSpeculatively();
+    void startSpeculativeTokenization();
+    void didReceiveSpeculativeTokens(Vector<HTMLSpeculativeTokenizer::Token>&&, bool isFinal);
+    void constructTreeFromSpeculativeToken(HTMLSpeculativeTokenizer::Token&&);
+    void stopSpeculativeTokenization();
+
     void runScriptsForPausedTreeBuilder();
     void resumeParsingAfterScriptExecution();
 
@@ -137,6 +145,11 @@ private:
 
     std::unique_ptr<HTMLResourcePreloader> m_preloader;
 
+    RefPtr<HTMLSpeculativeTokenizer> m_speculativeTokenizer;
+    Deque<HTMLSpeculativeTokenizer::Token> m_speculativeTokens;
+    bool m_speculativeTokenizerHasFinished { false };
+    bool m_didConsiderSpeculativeTokenization { false };
+
     bool m_endWasDelayed { false };
     unsigned m_pumpSessionNestingLevel { 0 };
 };
@@ -57,6 +57,16 @@ void HTMLSourceTracker::endToken(SegmentedString& currentInput, HTMLTokenizer& t
     m_cachedSourceForToken = String();
 }
 
+void HTMLSourceTracker::setSource(String&& source)
+{
+    m_started = false;
+    m_previousSource.clear();
+    m_currentSource.clear();
+    m_tokenStart = 0;
+    m_tokenEnd = source.length();
+    m_cachedSourceForToken = WTFMove(source);
+}
+
 String HTMLSourceTracker::source(const HTMLToken& token)
 {
     ASSERT(!m_started);
@@ -41,6 +41,9 @@ public:
     void startToken(SegmentedString&, HTMLTokenizer&);
     void endToken(SegmentedString&, HTMLTokenizer&);
 
+    // For tokens tokenized by HTMLSpeculativeTokenizer, which tracks their source itself.
+    void setSource(String&&);
+
     String source(const HTMLToken&);
     String source(const HTMLToken&, unsigned attributeStart, unsigned attributeEnd);
 
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HTMLSpeculativeTokenizer.h"
+
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/WorkQueue.h>
+#include <wtf/text/StringCommon.h>
+
+namespace WebCore {
+
+// Large enough to amortize the cost of hopping to the main thread, small enough that the tree builder
+// can start before a large chunk of network data has been tokenized entirely.
+static const size_t maximumTokensPerBatch = 1000;
+
+static WorkQueue& tokenizerQueue()
+{
+    static NeverDestroyed<Ref<WorkQueue>> queue(WorkQueue::create("org.webkit.HTMLSpeculativeTokenizer", WorkQueue::Type::Serial, WorkQueue::QOS::UserInitiated));
+    return queue.get();
+}
+
+template<unsigned length> static bool tagNameIs(const HTMLToken::DataVector& name, const char (&tagName)[length])
+{
+    return name.size() == length - 1 && equal(name.data(), reinterpret_cast<const LChar*>(tagName), length - 1);
+}
+
+static bool isCDATASection(const HTMLToken& token)
+{
+    // We never allow CDATA, since only the tree builder knows whether we are in foreign content. A CDATA
+    // section is tokenized as a bogus comment instead, which is wrong inside <svg> and <math>.
+    static const char cdataPrefix[] = "[CDATA[";
+    if (token.type() != HTMLToken::Comment || token.comment().size() < sizeof(cdataPrefix) - 1)
+        return false;
+    return equal(token.comment().data(), reinterpret_cast<const LChar*>(cdataPrefix), sizeof(cdataPrefix) - 1);
+}
+
+HTMLSpeculativeTokenizer::HTMLSpeculativeTokenizer(const HTMLParserOptions& options, ShouldTrackSource shouldTrackSource, TokensCallback&& callback)
+    : m_callback(WTFMove(callback))
+    , m_options(options)
+    , m_shouldTrackSource(shouldTrackSource == ShouldTrackSource::Yes)
+    , m_tokenizer(options)
+{
+}
+
+void HTMLSpeculativeTokenizer::appendToEnd(const String& source)
+{
+    ASSERT(isMainThread());
+    tokenizerQueue().dispatch([protectedThis = makeRef(*this), source = source.isolatedCopy()] () mutable {
+        protectedThis->tokenize(WTFMove(source));
+    });
+}
+
+void HTMLSpeculativeTokenizer::finish()
+{
+    ASSERT(isMainThread());
+    tokenizerQueue().dispatch([protectedThis = makeRef(*this)] {
+        if (protectedThis->m_hasFinished)
+            return;
+        protectedThis->m_hasFinished = true;
+        protectedThis->sendTokens(true);
+    });
+}
+
+void HTMLSpeculativeTokenizer::stop()
+{
+    ASSERT(isMainThread());
+    m_isStopped = true;
+}
+
+void HTMLSpeculativeTokenizer::tokenize(String&& source)
+{
+    ASSERT(!isMainThread());
+    if (m_hasFinished || m_isStopped)
+        return;
+
+    // Whether U+0000 is replaced or dropped depends on the tree builder's insertion mode, so stop
+    // speculating there and let the main thread take over.
+    bool reachedUnpredictableInput = false;
+    size_t nullCharacterPosition = source.find(static_cast<UChar>(0));
+    if (nullCharacterPosition != notFound) {
+        source = source.left(nullCharacterPosition);
+        reachedUnpredictableInput = true;
+    }
+
+    m_input.append(WTFMove(source));
+
+    while (!m_isStopped) {
+        // Track the source like HTMLDocumentParser::pumpTokenizerLoop() does, this also sets the attribute offsets the XSSAuditor expects.
+        if (m_shouldTrackSource)
+            m_sourceTracker.startToken(m_input, m_tokenizer);
+
+        auto rawToken = m_tokenizer.nextToken(m_input);
+        if (!rawToken)
+            break;
+
+        if (isCDATASection(*rawToken)) {
+            reachedUnpredictableInput = true;
+            break;
+        }
+
+        String source;
+        if (m_shouldTrackSource) {
+            m_sourceTracker.endToken(m_input, m_tokenizer);
+            // The tracker keeps a reference to the string, so it has to be copied before it is handed to the main thread.
+            source = m_sourceTracker.source(*rawToken).isolatedCopy();
+        }
+
+        unsigned numberOfCharactersConsumed = m_input.numberOfCharactersConsumed();
+        unsigned inputLength = numberOfCharactersConsumed - m_numberOfCharactersConsumed;
+        m_numberOfCharactersConsumed = numberOfCharactersConsumed;
+        HTMLToken htmlToken = WTFMove(*rawToken);
+        rawToken.clear();
+
+        Token token { WTFMove(htmlToken), inputLength, m_tokenizer.checkpoint(), std::nullopt, WTFMove(source) };
+        if (token.token.type() == HTMLToken::StartTag) {
+            predictTreeBuilderStateFor(token.token.name());
+            token.predictedCheckpoint = m_tokenizer.checkpoint();
+        }
+
+        m_pendingTokens.append(WTFMove(token));
+        if (m_pendingTokens.size() >= maximumTokensPerBatch)
+            sendTokens(false);
+    }
+
+    if (reachedUnpredictableInput) {
+        m_hasFinished = true;
+        sendTokens(true);
+        return;
+    }
+
+    sendTokens(false);
+}
+
+// Mirrors HTMLTokenizer::updateStateFor(), which can't be used off the main thread because it compares AtomicStrings.
+void HTMLSpeculativeTokenizer::predictTreeBuilderStateFor(const HTMLToken::DataVector& tagName)
+{
+    if (tagNameIs(tagName, "textarea") || tagNameIs(tagName, "title"))
+        m_tokenizer.setRCDATAState();
+    else if (tagNameIs(tagName, "plaintext"))
+        m_tokenizer.setPLAINTEXTState();
+    else if (tagNameIs(tagName, "script"))
+        m_tokenizer.setScriptDataState();
+    else if (tagNameIs(tagName, "style")
+        || tagNameIs(tagName, "iframe")
+        || tagNameIs(tagName, "xmp")
+        || (tagNameIs(tagName, "noembed") && m_options.pluginsEnabled)
+        || tagNameIs(tagName, "noframes")
+        || (tagNameIs(tagName, "noscript") && m_options.scriptEnabled))
+        m_tokenizer.setRAWTEXTState();
+}
+
+void HTMLSpeculativeTokenizer::sendTokens(bool isFinal)
+{
+    ASSERT(!isMainThread());
+
+    // After the final batch, any input following the last token, e.g. a partial token, is left to the main thread.
+    if (m_pendingTokens.isEmpty() && !isFinal)
+        return;
+
+    callOnMainThread([protectedThis = makeRef(*this), tokens = WTFMove(m_pendingTokens), isFinal] () mutable {
+        // Once stopped, the callback must not be called anymore, even for tokens sent before.
+        if (!protectedThis->m_isStopped)
+            protectedThis->m_callback(WTFMove(tokens), isFinal);
+    });
+    m_pendingTokens = { };
+}
+
+} // namespace WebCore
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "HTMLParserOptions.h"
+#include "HTMLSourceTracker.h"
+#include "HTMLToken.h"
+#include "HTMLTokenizer.h"
+#include "SegmentedString.h"
+#include <atomic>
+#include <wtf/Function.h>
+#include <wtf/Optional.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// Tokenizes network input on a background thread ahead of the main thread tree builder, and hands the
+// tokens over in batches. Every token records the input it consumed and the tokenizer checkpoint after
+// it, so that HTMLDocumentParser can take over tokenizing after any of them if the speculation turns
+// out to be wrong (document.write, or the tree builder switching the tokenizer into a state we did not
+// predict).
+class HTMLSpeculativeTokenizer : public ThreadSafeRefCounted<HTMLSpeculativeTokenizer> {
+public:
+    struct Token {
+        HTMLToken token;
+        unsigned inputLength;
+        HTMLTokenizer::Checkpoint checkpoint;
+        // For start tags, the checkpoint after applying our guess of what the tree builder will do.
+        std::optional<HTMLTokenizer::Checkpoint> predictedCheckpoint;
+        // The source of the token for the XSSAuditor, only when tracking sources.
+        String source;
+    };
+
+    // Called on the main thread. The final batch is the last one, after it the main thread tokenizes the rest of the input.
+    using TokensCallback = WTF::Function<void(Vector<Token>&&, bool isFinal)>;
+
+    enum class ShouldTrackSource { No, Yes };
+    static Ref<HTMLSpeculativeTokenizer> create(const HTMLParserOptions& options, ShouldTrackSource shouldTrackSource, TokensCallback&& callback)
+    {
+        return adoptRef(*new HTMLSpeculativeTokenizer(options, shouldTrackSource, WTFMove(callback)));
+    }
+
+    void appendToEnd(const String&);
+    void finish();
+    void stop();
+
+private:
+    HTMLSpeculativeTokenizer(const HTMLParserOptions&, ShouldTrackSource, TokensCallback&&);
+
+    void tokenize(String&&);
+    void predictTreeBuilderStateFor(const HTMLToken::DataVector& tagName);
+    void sendTokens(bool isFinal);
+
+    // Only called on the main thread.
+    const TokensCallback m_callback;
+
+    // Background thread only.
+    const HTMLParserOptions m_options;
+    const bool m_shouldTrackSource;
+    HTMLTokenizer m_tokenizer;
+    HTMLSourceTracker m_sourceTracker;
+    SegmentedString m_input;
+    Vector<Token> m_pendingTokens;
+    unsigned m_numberOfCharactersConsumed { 0 };
+    bool m_hasFinished { false };
+
+    std::atomic<bool> m_isStopped { false };
+};
+
+} // namespace WebCore
@@ -1423,6 +1423,38 @@ void HTMLTokenizer::updateStateFor(const AtomicString& tagName)
         m_state = RAWTEXTState;
 }
 
+HTMLTokenizer::Checkpoint HTMLTokenizer::checkpoint() const
+{
+    // Between tokens, m_token is empty and everything else needed to continue is copied here. A character
+    // token emitted right before an end tag leaves the tokenizer with a buffered end tag name, and the
+    // temporary buffer holds the characters of that end tag.
+    ASSERT(m_token.type() == HTMLToken::Uninitialized);
+
+    Checkpoint checkpoint;
+    checkpoint.m_state = m_state;
+    checkpoint.m_appropriateEndTagName = m_appropriateEndTagName;
+    checkpoint.m_temporaryBuffer = m_temporaryBuffer;
+    checkpoint.m_bufferedEndTagName = m_bufferedEndTagName;
+    checkpoint.m_isSkippingNextNewLine = m_preprocessor.isSkippingNextNewLine();
+    return checkpoint;
+}
+
+void HTMLTokenizer::restoreCheckpoint(const Checkpoint& checkpoint)
+{
+    ASSERT(m_token.type() == HTMLToken::Uninitialized);
+    m_state = checkpoint.m_state;
+    m_appropriateEndTagName = checkpoint.m_appropriateEndTagName;
+    m_temporaryBuffer = checkpoint.m_temporaryBuffer;
+    m_bufferedEndTagName = checkpoint.m_bufferedEndTagName;
+    m_preprocessor.setSkippingNextNewLine(checkpoint.m_isSkippingNextNewLine);
+}
+
+bool HTMLTokenizer::isAtCheckpoint(const Checkpoint& checkpoint) const
+{
+    // Everything but the state only changes as input is tokenized; the tree builder can only change the state.
+    return m_state == checkpoint.m_state;
+}
+
 inline void HTMLTokenizer::appendToTemporaryBuffer(UChar character)
 {
     ASSERT(isASCII(character));
@@ -79,6 +79,14 @@ public:
 
     bool neverSkipNullCharacters() const;
 
+    // Used by HTMLSpeculativeTokenizer. A Checkpoint is the tokenizer state between two tokens that is
+    // needed to continue tokenizing from there, including the characters buffered while looking for an
+    // end tag. It can only be taken right after a token was returned by nextToken() and released.
+    class Checkpoint;
+    Checkpoint checkpoint() const;
+    void restoreCheckpoint(const Checkpoint&);
+    bool isAtCheckpoint(const Checkpoint&) const;
+
 private:
     enum State {
         DataState,
@@ -211,6 +219,17 @@ private:
     const HTMLParserOptions m_options;
 };
 
+class HTMLTokenizer::Checkpoint {
+private:
+    friend class HTMLTokenizer;
+
+    State m_state;
+    Vector<UChar, 32> m_appropriateEndTagName;
+    Vector<LChar, 32> m_temporaryBuffer;
+    Vector<LChar, 32> m_bufferedEndTagName;
+    bool m_isSkippingNextNewLine;
+};
+
 class HTMLTokenizer::TokenPtr {
 public:
     TokenPtr();
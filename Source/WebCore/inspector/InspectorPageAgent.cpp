@@ -148,7 +148,7 @@ bool InspectorPageAgent::cachedResourceContent(CachedResource* cachedResource, S
             // We show content for raw resources only for certain mime types (text, html and xml). Otherwise decoder will be null.
             if (!decoder)
                 return false;
-            *result = decoder->decodeAndFlush(buffer->data(), buffer->size());
+            *result = decoder->decodeAndFlush(*buffer);
             return true;
         }
         default:
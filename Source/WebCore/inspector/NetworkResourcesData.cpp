@@ -105,7 +105,7 @@ size_t NetworkResourcesData::ResourceData::decodeDataToContent()
 {
     ASSERT(!hasContent());
     size_t dataLength = m_dataBuffer->size();
-    m_content = m_decoder->decodeAndFlush(m_dataBuffer->data(), m_dataBuffer->size());
+    m_content = m_decoder->decodeAndFlush(*m_dataBuffer);
     m_dataBuffer = nullptr;
     return contentSizeInBytes(m_content) - dataLength;
 }
@@ -806,9 +806,16 @@ void DocumentLoader::continueAfterContentPolicy(PolicyAction policy)
     }
 
     if (!isStopping() && m_substituteData.isValid() && isLoadingMainResource()) {
-        auto content = m_substituteData.content();
-        if (content && content->size())
-            dataReceived(content->data(), content->size());
+        if (auto content = m_substituteData.content()) {
+            for (const auto& segment : *content) {
+                if (!isLoadingMainResource())
+                    break;
+                // An empty loadString() / loadHTMLString() yields a single empty segment.
+                if (!segment->size())
+                    continue;
+                dataReceived(segment->data(), segment->size());
+            }
+        }
         if (isLoadingMainResource())
             finishedLoading();
     }
@@ -26,12 +26,14 @@
 #include "HTMLMetaCharsetParser.h"
 #include "HTMLNames.h"
 #include "MIMETypeRegistry.h"
+#include "SharedBuffer.h"
 #include "TextCodec.h"
 #include "TextEncoding.h"
 #include "TextEncodingDetector.h"
 #include "TextEncodingRegistry.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/StringExtras.h>
+#include <wtf/text/StringBuilder.h>
 
 using namespace WTF;
 
@@ -677,4 +679,13 @@ String TextResourceDecoder::decodeAndFlush(const char* data, size_t length)
     return decoded + flush();
 }
 
+String TextResourceDecoder::decodeAndFlush(const SharedBuffer& buffer)
+{
+    StringBuilder result;
+    for (const auto& segment : buffer)
+        result.append(decode(segment->data(), segment->size()));
+    result.append(flush());
+    return result.toString();
+}
+
 }
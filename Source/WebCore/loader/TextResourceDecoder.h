@@ -28,6 +28,7 @@
 namespace WebCore {
 
 class HTMLMetaCharsetParser;
+class SharedBuffer;
 
 class TextResourceDecoder : public RefCounted<TextResourceDecoder> {
 public:
@@ -57,6 +58,8 @@ public:
     WEBCORE_EXPORT String flush();
 
     WEBCORE_EXPORT String decodeAndFlush(const char* data, size_t length);
+    // Decodes the buffer one segment at a time instead of combining it into a single segment first.
+    WEBCORE_EXPORT String decodeAndFlush(const SharedBuffer&);
 
     void setHintEncoding(const TextResourceDecoder* hintDecoder)
     {
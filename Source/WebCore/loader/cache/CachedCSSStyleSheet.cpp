@@ -27,17 +27,25 @@
 #include "CSSStyleSheet.h"
 #include "CachedResourceClientWalker.h"
 #include "CachedResourceRequest.h"
+#include "CSSBackgroundTokenizer.h"
+#include "CSSTokenizer.h"
 #include "CachedStyleSheetClient.h"
+#include "Frame.h"
 #include "HTTPHeaderNames.h"
 #include "HTTPParsers.h"
 #include "MemoryCache.h"
+#include "Settings.h"
 #include "SharedBuffer.h"
 #include "StyleSheetContents.h"
+#include "SubresourceLoader.h"
 #include "TextResourceDecoder.h"
 #include <wtf/CurrentTime.h>
 
 namespace WebCore {
 
+// Small sheets tokenize faster than the round trip to the background thread.
+static const unsigned minimumSizeForBackgroundTokenization = 32 * 1024;
+
 CachedCSSStyleSheet::CachedCSSStyleSheet(CachedResourceRequest&& request, SessionID sessionID)
     : CachedResource(WTFMove(request), CSSStyleSheet, sessionID)
     , m_decoder(TextResourceDecoder::create("text/css", request.charset()))
@@ -82,7 +90,7 @@ const String CachedCSSStyleSheet::sheetText(MIMETypeCheckHint mimeTypeCheckHint,
         return m_decodedSheetText;
 
     // Don't cache the decoded text, regenerating is cheap and it can use quite a bit of memory
-    return m_decoder->decodeAndFlush(m_data->data(), m_data->size());
+    return m_decoder->decodeAndFlush(*m_data);
 }
 
 void CachedCSSStyleSheet::setBodyDataFrom(const CachedResource& resource)
@@ -98,17 +106,68 @@ void CachedCSSStyleSheet::setBodyDataFrom(const CachedResource& resource)
         saveParsedStyleSheet(*sheet.m_parsedStyleSheetCache);
 }
 
+bool CachedCSSStyleSheet::shouldTokenizeInBackground() const
+{
+    if (!m_loader)
+        return false;
+    auto* frame = m_loader->frame();
+    return frame && frame->settings().threadedCSSTokenizerEnabled();
+}
+
+void CachedCSSStyleSheet::addDataBuffer(SharedBuffer& data)
+{
+    CachedResource::addDataBuffer(data);
+
+    if (!m_backgroundTokenizer) {
+        if (data.size() < minimumSizeForBackgroundTokenization || !shouldTokenizeInBackground())
+            return;
+        m_streamingDecoder = TextResourceDecoder::create("text/css", m_decoder->encoding());
+        m_backgroundTokenizer = CSSBackgroundTokenizer::create();
+    }
+    appendToBackgroundTokenizer(data);
+}
+
+void CachedCSSStyleSheet::appendToBackgroundTokenizer(SharedBuffer& data)
+{
+    unsigned segmentStart = 0;
+    for (auto& segment : data) {
+        unsigned segmentEnd = segmentStart + segment->size();
+        if (segmentEnd > m_backgroundTokenizedDataSize) {
+            unsigned offset = std::max(segmentStart, m_backgroundTokenizedDataSize) - segmentStart;
+            m_backgroundTokenizer->append(m_streamingDecoder->decode(segment->data() + offset, segment->size() - offset));
+        }
+        segmentStart = segmentEnd;
+    }
+    m_backgroundTokenizedDataSize = segmentStart;
+}
+
+std::unique_ptr<CSSTokenizer> CachedCSSStyleSheet::createBackgroundTokenizedTokenizer(const String& sheetText) const
+{
+    if (!m_backgroundTokenizer || sheetText.isNull())
+        return nullptr;
+    return m_backgroundTokenizer->createTokenizer(sheetText);
+}
+
 void CachedCSSStyleSheet::finishLoading(SharedBuffer* data)
 {
     m_data = data;
     setEncodedSize(data ? data->size() : 0);
     // Decode the data to find out the encoding and keep the sheet text around during checkNotify()
     if (data)
-        m_decodedSheetText = m_decoder->decodeAndFlush(data->data(), data->size());
+        m_decodedSheetText = m_decoder->decodeAndFlush(*data);
+    if (m_backgroundTokenizer) {
+        if (data)
+            appendToBackgroundTokenizer(*data);
+        m_backgroundTokenizer->append(m_streamingDecoder->flush());
+        m_backgroundTokenizer->finish();
+    }
     setLoading(false);
     checkNotify();
     // Clear the decoded text as it is unlikely to be needed immediately again and is cheap to regenerate.
     m_decodedSheetText = String();
+    // Clients that come later parse from the cached StyleSheetContents or the data.
+    m_backgroundTokenizer = nullptr;
+    m_streamingDecoder = nullptr;
 }
 
 void CachedCSSStyleSheet::checkNotify()
@@ -116,6 +175,12 @@ void CachedCSSStyleSheet::checkNotify()
     if (isLoading())
         return;
 
+    // error() and cancelLoad() end here too. There is nothing left to tokenize in that case.
+    if (errorOccurred()) {
+        m_backgroundTokenizer = nullptr;
+        m_streamingDecoder = nullptr;
+    }
+
     CachedResourceClientWalker<CachedStyleSheetClient> w(m_clients);
     while (CachedStyleSheetClient* c = w.next())
         c->setCSSStyleSheet(m_resourceRequest.url(), m_response.url(), m_decoder->encoding().name(), this);
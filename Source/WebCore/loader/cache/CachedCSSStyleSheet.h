@@ -26,6 +26,8 @@
 
 namespace WebCore {
 
+class CSSBackgroundTokenizer;
+class CSSTokenizer;
 class StyleSheetContents;
 class TextResourceDecoder;
 
@@ -39,6 +41,9 @@ public:
     enum class MIMETypeCheckHint { Strict, Lax };
     const String sheetText(MIMETypeCheckHint = MIMETypeCheckHint::Strict, bool* hasValidMIMEType = nullptr) const;
 
+    // Returns tokens produced on a background thread while the sheet was received, if they match sheetText.
+    std::unique_ptr<CSSTokenizer> createBackgroundTokenizedTokenizer(const String& sheetText) const;
+
     RefPtr<StyleSheetContents> restoreParsedStyleSheet(const CSSParserContext&, CachePolicy);
     void saveParsedStyleSheet(Ref<StyleSheetContents>&&);
 
@@ -48,6 +53,8 @@ public:
 
 private:
     String responseMIMEType() const;
+    bool shouldTokenizeInBackground() const;
+    void appendToBackgroundTokenizer(SharedBuffer&);
     bool canUseSheet(MIMETypeCheckHint, bool* hasValidMIMEType) const;
     bool mayTryReplaceEncodedData() const final { return true; }
 
@@ -56,6 +63,7 @@ private:
     void setEncoding(const String&) final;
     String encoding() const final;
     const TextResourceDecoder* textResourceDecoder() const final { return m_decoder.get(); }
+    void addDataBuffer(SharedBuffer&) final;
     void finishLoading(SharedBuffer*) final;
     void destroyDecodedData() final;
 
@@ -67,6 +75,10 @@ protected:
     RefPtr<TextResourceDecoder> m_decoder;
     String m_decodedSheetText;
 
+    RefPtr<TextResourceDecoder> m_streamingDecoder;
+    RefPtr<CSSBackgroundTokenizer> m_backgroundTokenizer;
+    unsigned m_backgroundTokenizedDataSize { 0 };
+
     RefPtr<StyleSheetContents> m_parsedStyleSheetCache;
 };
 
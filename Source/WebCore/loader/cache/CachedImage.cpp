@@ -336,6 +336,12 @@ void CachedImage::CachedImageObserver::decodedSizeChanged(const Image& image, lo
         cachedImage->decodedSizeChanged(image, delta);
 }
 
+void CachedImage::CachedImageObserver::didDecodeFrame(const Image& image, size_t index, Seconds decodingTime)
+{
+    for (auto cachedImage : m_cachedImages)
+        cachedImage->didDecodeFrame(image, index, decodingTime);
+}
+
 void CachedImage::CachedImageObserver::didDraw(const Image& image)
 {
     for (auto cachedImage : m_cachedImages)
@@ -372,6 +378,7 @@ inline void CachedImage::clearImage()
         m_imageObserver = nullptr;
     }
     m_image = nullptr;
+    resetFrameDecodingTimes();
 }
 
 void CachedImage::addIncrementalDataBuffer(SharedBuffer& data)
@@ -485,6 +492,7 @@ void CachedImage::destroyDecodedData()
         setDecodedSize(0);
     } else if (m_image && !errorOccurred())
         m_image->destroyDecodedData();
+    resetFrameDecodingTimes();
 }
 
 void CachedImage::decodedSizeChanged(const Image& image, long long delta)
@@ -496,6 +504,29 @@ void CachedImage::decodedSizeChanged(const Image& image, long long delta)
     setDecodedSize(static_cast<unsigned>(decodedSize() + delta));
 }
 
+void CachedImage::didDecodeFrame(const Image& image, size_t index, Seconds decodingTime)
+{
+    if (&image != m_image)
+        return;
+
+    // A frame decoded again, e.g. at another subsampling level, replaces its previous decode
+    // rather than adding to the cost of the image.
+    if (index >= m_frameDecodingTimes.size())
+        m_frameDecodingTimes.grow(index + 1);
+    m_frameDecodingTimes[index] = decodingTime;
+
+    Seconds recreationCost;
+    for (auto frameDecodingTime : m_frameDecodingTimes)
+        recreationCost += frameDecodingTime;
+    setRecreationCost(recreationCost);
+}
+
+void CachedImage::resetFrameDecodingTimes()
+{
+    m_frameDecodingTimes.clear();
+    setRecreationCost({ });
+}
+
 void CachedImage::didDraw(const Image& image)
 {
     if (&image != m_image)
@@ -129,6 +129,7 @@ private:
         // ImageObserver API
         URL sourceUrl() const override { return !m_cachedImages.isEmpty() ? m_cachedImages[0]->url() : URL(); }
         void decodedSizeChanged(const Image&, long long delta) final;
+        void didDecodeFrame(const Image&, size_t index, Seconds decodingTime) final;
         void didDraw(const Image&) final;
 
         bool canDestroyDecodedData(const Image&) final;
@@ -139,6 +140,8 @@ private:
     };
 
     void decodedSizeChanged(const Image&, long long delta);
+    void didDecodeFrame(const Image&, size_t index, Seconds decodingTime);
+    void resetFrameDecodingTimes();
     void didDraw(const Image&);
     bool canDestroyDecodedData(const Image&);
     void imageFrameAvailable(const Image&, ImageAnimatingState, const IntRect* changeRect = nullptr);
@@ -154,6 +157,8 @@ private:
 
     RefPtr<CachedImageObserver> m_imageObserver;
     RefPtr<Image> m_image;
+    // Last decoding time of each frame of m_image, the recreation cost is their sum.
+    Vector<Seconds> m_frameDecodingTimes;
     std::unique_ptr<SVGImageCache> m_svgImageCache;
     bool m_isManuallyCached { false };
     bool m_shouldPaintBrokenImage { true };
@@ -618,6 +618,22 @@ void CachedResource::setEncodedSize(unsigned size)
     }
 }
 
+void CachedResource::setRecreationCost(Seconds cost)
+{
+    if (cost == m_recreationCost)
+        return;
+
+    // The cost is part of the LRU list computation, remove before updating it like for size changes.
+    bool isInLRUList = allowsCaching() && inCache() && accessCount();
+    if (isInLRUList)
+        MemoryCache::singleton().removeFromLRUList(*this);
+
+    m_recreationCost = cost;
+
+    if (isInLRUList)
+        MemoryCache::singleton().insertInLRUList(*this);
+}
+
 void CachedResource::didAccessDecodedData(double timeStamp)
 {
     m_lastDecodedAccessTime = timeStamp;
@@ -123,6 +123,7 @@ public:
     WEBCORE_EXPORT void addClient(CachedResourceClient&);
     WEBCORE_EXPORT void removeClient(CachedResourceClient&);
     bool hasClients() const { return !m_clients.isEmpty() || !m_clientsAwaitingCallback.isEmpty(); }
+    unsigned numberOfClients() const { return m_clients.size() + m_clientsAwaitingCallback.size(); }
     bool hasClient(CachedResourceClient& client) { return m_clients.contains(&client) || m_clientsAwaitingCallback.contains(&client); }
     bool deleteIfPossible();
 
@@ -176,6 +177,11 @@ public:
     unsigned accessCount() const { return m_accessCount; }
     void increaseAccessCount() { m_accessCount++; }
 
+    // Time one full decode or parse of this resource takes. The cache uses it to estimate
+    // how expensive the resource would be to recreate if it was evicted.
+    Seconds recreationCost() const { return m_recreationCost; }
+    void setRecreationCost(Seconds);
+
     // Computes the status of an object after loading.
     // Updates the expire date on the cache entry file
     void finish();
@@ -325,6 +331,7 @@ private:
     unsigned m_decodedSize { 0 };
     unsigned m_accessCount { 0 };
     unsigned m_handleCount { 0 };
+    Seconds m_recreationCost;
     unsigned m_preloadCount { 0 };
 
     PreloadResult m_preloadResult { PreloadNotReferenced };
@@ -78,7 +78,7 @@ bool CachedSVGFont::ensureCustomFontData(const AtomicString& remoteURI)
 
             NoEventDispatchAssertion::EventAllowedScope allowedScope(*m_externalSVGDocument);
 
-            m_externalSVGDocument->setContent(decoder->decodeAndFlush(m_data->data(), m_data->size()));
+            m_externalSVGDocument->setContent(decoder->decodeAndFlush(*m_data));
             sawError = decoder->sawError();
         }
 
@@ -32,10 +32,14 @@
 #include "CachedResourceRequest.h"
 #include "RuntimeApplicationChecks.h"
 #include "SharedBuffer.h"
+#include "StreamingScriptDecoder.h"
 #include "TextResourceDecoder.h"
+#include <wtf/MonotonicTime.h>
 
 namespace WebCore {
 
+static const unsigned minimumSizeForStreamingDecoding = 64 * 1024;
+
 CachedScript::CachedScript(CachedResourceRequest&& request, SessionID sessionID)
     : CachedResource(WTFMove(request), Script, sessionID)
     , m_decoder(TextResourceDecoder::create(ASCIILiteral("application/javascript"), request.charset()))
@@ -49,6 +53,7 @@ CachedScript::~CachedScript()
 void CachedScript::setEncoding(const String& chs)
 {
     m_decoder->setEncoding(chs, TextResourceDecoder::EncodingFromHTTPHeader);
+    m_streamingDecoder = nullptr;
 }
 
 String CachedScript::encoding() const
@@ -56,6 +61,15 @@ String CachedScript::encoding() const
     return m_decoder->encoding().name();
 }
 
+static bool segmentsAreAllASCII(const SharedBuffer& buffer)
+{
+    for (const auto& segment : buffer) {
+        if (!charactersAreAllASCII(reinterpret_cast<const LChar*>(segment->data()), segment->size()))
+            return false;
+    }
+    return true;
+}
+
 StringView CachedScript::script()
 {
     if (!m_data)
@@ -64,7 +78,7 @@ StringView CachedScript::script()
     if (m_decodingState == NeverDecoded
         && TextEncoding(encoding()).isByteBasedEncoding()
         && m_data->size()
-        && charactersAreAllASCII(reinterpret_cast<const LChar*>(m_data->data()), m_data->size())) {
+        && segmentsAreAllASCII(*m_data)) {
 
         m_decodingState = DataAndDecodedStringHaveSameBytes;
 
@@ -79,7 +93,10 @@ StringView CachedScript::script()
         return { reinterpret_cast<const LChar*>(m_data->data()), m_data->size() };
 
     if (!m_script) {
-        m_script = m_decoder->decodeAndFlush(m_data->data(), encodedSize());
+        // Decode segment by segment so that non-ASCII scripts are never combined into a single segment.
+        auto decodingStartTime = MonotonicTime::now();
+        m_script = m_decoder->decodeAndFlush(*m_data);
+        setRecreationCost(MonotonicTime::now() - decodingStartTime);
         ASSERT(!m_scriptHash || m_scriptHash == m_script.impl()->hash());
         if (m_decodingState == NeverDecoded)
             m_scriptHash = m_script.impl()->hash();
@@ -98,10 +115,47 @@ unsigned CachedScript::scriptHash()
     return m_scriptHash;
 }
 
+void CachedScript::addDataBuffer(SharedBuffer& data)
+{
+    CachedResource::addDataBuffer(data);
+
+    if (!m_streamingDecoder) {
+        if (data.size() < minimumSizeForStreamingDecoding)
+            return;
+        m_streamingDecoder = std::make_unique<StreamingScriptDecoder>(m_decoder->encoding());
+    }
+    m_streamingDecoder->append(data);
+}
+
+void CachedScript::adoptStreamedScript()
+{
+    auto& decoder = *m_streamingDecoder;
+    String script = decoder.finish();
+    m_scriptHash = decoder.hash();
+    if (!decoder.isDecoding()) {
+        // The bytes were copied into one segment as they arrived, script() won't have to combine the data.
+        m_data = decoder.takeContiguousData();
+        m_decodingState = DataAndDecodedStringHaveSameBytes;
+        setDecodedSize(0);
+        return;
+    }
+
+    m_script = WTFMove(script);
+    m_decodingState = DataAndDecodedStringHaveDifferentBytes;
+    setRecreationCost(decoder.decodingTime());
+    setDecodedSize(m_script.sizeInBytes());
+    m_decodedDataDeletionTimer.restart();
+}
+
 void CachedScript::finishLoading(SharedBuffer* data)
 {
     m_data = data;
     setEncodedSize(data ? data->size() : 0);
+    if (m_streamingDecoder && data && data->size() >= m_streamingDecoder->size()) {
+        m_streamingDecoder->append(*data);
+        adoptStreamedScript();
+    }
+    m_streamingDecoder = nullptr;
     CachedResource::finishLoading(data);
 }
 
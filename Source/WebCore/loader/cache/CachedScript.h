@@ -29,6 +29,7 @@
 
 namespace WebCore {
 
+class StreamingScriptDecoder;
 class TextResourceDecoder;
 
 class CachedScript final : public CachedResource {
@@ -47,8 +48,11 @@ private:
     void setEncoding(const String&) final;
     String encoding() const final;
     const TextResourceDecoder* textResourceDecoder() const final { return m_decoder.get(); }
+    void addDataBuffer(SharedBuffer&) final;
     void finishLoading(SharedBuffer*) final;
 
+    void adoptStreamedScript();
+
     void destroyDecodedData() final;
 
     void setBodyDataFrom(const CachedResource&) final;
@@ -60,6 +64,10 @@ private:
     DecodingState m_decodingState { NeverDecoded };
 
     RefPtr<TextResourceDecoder> m_decoder;
+
+    // Large scripts are checked for ASCII, decoded and hashed chunk by chunk while they are received,
+    // so that this work overlaps with the download instead of delaying their execution.
+    std::unique_ptr<StreamingScriptDecoder> m_streamingDecoder;
 };
 
 } // namespace WebCore
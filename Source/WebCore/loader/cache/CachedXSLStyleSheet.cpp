@@ -68,7 +68,7 @@ void CachedXSLStyleSheet::finishLoading(SharedBuffer* data)
     m_data = data;
     setEncodedSize(data ? data->size() : 0);
     if (data)
-        m_sheet = m_decoder->decodeAndFlush(data->data(), encodedSize());
+        m_sheet = m_decoder->decodeAndFlush(*data);
     setLoading(false);
     checkNotify();
 }
@@ -51,6 +51,42 @@ namespace WebCore {
 static const int cDefaultCacheCapacity = 8192 * 1024;
 static const double cMinDelayBeforeLiveDecodedPrune = 1; // Seconds.
 static const float cTargetPrunePercentage = .95f; // Percentage of capacity toward which we prune, to avoid immediately pruning again.
+static const Seconds cRecreationCostPerAccess = 5_ms; // Decoding or parsing time that weighs as much as one more access.
+
+enum class DeadResourcePartition { Images, ScriptsAndStyleSheets, Other };
+static const unsigned deadResourcePartitionCount = 3;
+
+static DeadResourcePartition deadResourcePartition(const CachedResource& resource)
+{
+    switch (resource.type()) {
+    case CachedResource::ImageResource:
+        return DeadResourcePartition::Images;
+    case CachedResource::Script:
+    case CachedResource::CSSStyleSheet:
+#if ENABLE(XSLT)
+    case CachedResource::XSLStyleSheet:
+#endif
+        return DeadResourcePartition::ScriptsAndStyleSheets;
+    default:
+        return DeadResourcePartition::Other;
+    }
+}
+
+// Share of the dead capacity each partition may use. The shares overlap so that the capacity
+// is not wasted when a page only uses a few types of resources.
+static float deadCapacityRatio(DeadResourcePartition partition)
+{
+    switch (partition) {
+    case DeadResourcePartition::Images:
+        return .75f;
+    case DeadResourcePartition::ScriptsAndStyleSheets:
+        return .5f;
+    case DeadResourcePartition::Other:
+        return .25f;
+    }
+    ASSERT_NOT_REACHED();
+    return 1;
+}
 
 MemoryCache& MemoryCache::singleton()
 {
@@ -297,6 +333,14 @@ void MemoryCache::destroyDecodedDataForAllImages()
     });
 }
 
+unsigned MemoryCache::liveDecodedSize() const
+{
+    unsigned size = 0;
+    for (auto* resource : m_liveDecodedResources)
+        size += resource->decodedSize();
+    return size;
+}
+
 void MemoryCache::pruneLiveResourcesToSize(unsigned targetSize, bool shouldDestroyDecodedDataForAllLiveResources)
 {
     if (m_inPruneResources)
@@ -363,6 +407,14 @@ void MemoryCache::pruneDeadResourcesToSize(unsigned targetSize)
     if (targetSize && m_deadSize <= targetSize)
         return;
 
+    ++m_pruneStatistics.pruneCount;
+
+    if (targetSize) {
+        pruneDeadResourcesOverPartitionBudgets(targetSize);
+        if (m_deadSize <= targetSize)
+            return;
+    }
+
     bool canShrinkLRULists = true;
     for (int i = m_allResources.size() - 1; i >= 0; i--) {
         // Make a copy of the LRUList first (and ref the resources) as calling
@@ -380,6 +432,8 @@ void MemoryCache::pruneDeadResourcesToSize(unsigned targetSize)
                 // Destroy our decoded data. This will remove us from 
                 // m_liveDecodedResources, and possibly move us to a different 
                 // LRU list in m_allResources.
+                if (resource->decodedSize())
+                    ++m_pruneStatistics.decodedDataDestroyedCount;
                 resource->destroyDecodedData();
 
                 if (targetSize && m_deadSize <= targetSize)
@@ -394,7 +448,7 @@ void MemoryCache::pruneDeadResourcesToSize(unsigned targetSize)
                 continue;
 
             if (!resource->hasClients() && !resource->isPreloaded() && !resource->isCacheValidator()) {
-                remove(*resource);
+                evictDeadResource(*resource);
                 if (targetSize && m_deadSize <= targetSize)
                     return;
             }
@@ -409,6 +463,68 @@ void MemoryCache::pruneDeadResourcesToSize(unsigned targetSize)
     }
 }
 
+void MemoryCache::pruneDeadResourcesOverPartitionBudgets(unsigned targetSize)
+{
+    std::array<unsigned, deadResourcePartitionCount> deadSizes { };
+    Vector<CachedResourceHandle<CachedResource>> deadResources;
+    for (int i = m_allResources.size() - 1; i >= 0; i--) {
+        for (auto* resource : *m_allResources[i]) {
+            if (!resource->inCache() || resource->hasClients())
+                continue;
+            deadSizes[static_cast<unsigned>(deadResourcePartition(*resource))] += resource->size();
+            deadResources.append(resource);
+        }
+    }
+
+    auto isOverBudget = [&] (DeadResourcePartition partition) {
+        return deadSizes[static_cast<unsigned>(partition)] > targetSize * deadCapacityRatio(partition);
+    };
+
+    // Like the regular pruning, first flush decoded data, then evict, in LRU order but only from the
+    // partitions using more than their share.
+    for (auto& resource : deadResources) {
+        if (!resource->inCache() || resource->hasClients() || resource->isPreloaded() || !resource->isLoaded())
+            continue;
+
+        auto partition = deadResourcePartition(*resource);
+        if (!isOverBudget(partition))
+            continue;
+
+        unsigned& deadSize = deadSizes[static_cast<unsigned>(partition)];
+        unsigned sizeBefore = resource->size();
+        if (resource->decodedSize())
+            ++m_pruneStatistics.decodedDataDestroyedCount;
+        resource->destroyDecodedData();
+        deadSize -= std::min(deadSize, sizeBefore - std::min(sizeBefore, resource->size()));
+        if (m_deadSize <= targetSize)
+            return;
+    }
+
+    for (auto& resource : deadResources) {
+        if (!resource->inCache() || resource->hasClients() || resource->isPreloaded() || resource->isCacheValidator())
+            continue;
+
+        auto partition = deadResourcePartition(*resource);
+        if (!isOverBudget(partition))
+            continue;
+
+        unsigned& deadSize = deadSizes[static_cast<unsigned>(partition)];
+        deadSize -= std::min(deadSize, resource->size());
+        ++m_pruneStatistics.evictedOverPartitionBudgetCount;
+        evictDeadResource(*resource);
+        if (m_deadSize <= targetSize)
+            return;
+    }
+}
+
+void MemoryCache::evictDeadResource(CachedResource& resource)
+{
+    ++m_pruneStatistics.evictedCount;
+    m_pruneStatistics.evictedSize += resource.size();
+    m_pruneStatistics.evictedRecreationCost += resource.recreationCost();
+    remove(resource);
+}
+
 void MemoryCache::setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, unsigned totalBytes)
 {
     ASSERT(minDeadBytes <= maxDeadBytes);
@@ -451,7 +567,11 @@ void MemoryCache::remove(CachedResource& resource)
 auto MemoryCache::lruListFor(CachedResource& resource) -> LRUList&
 {
     unsigned accessCount = std::max(resource.accessCount(), 1U);
-    unsigned queueIndex = WTF::fastLog2(resource.size() / accessCount);
+    // Weigh the accesses by how long the resource took to decode or parse, so that expensive resources move
+    // to lists that are evicted later.
+    double costWeight = 1 + resource.recreationCost() / cRecreationCostPerAccess;
+    unsigned weightedAccessCount = static_cast<unsigned>(std::min<double>(accessCount * costWeight, std::numeric_limits<unsigned>::max()));
+    unsigned queueIndex = WTF::fastLog2(resource.size() / weightedAccessCount);
 #ifndef NDEBUG
     resource.m_lruIndex = queueIndex;
 #endif
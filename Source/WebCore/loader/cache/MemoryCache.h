@@ -59,6 +59,11 @@ class SecurityOrigin;
 // -------|-----+++++++++++++++|
 // -------|-----+++++++++++++++|+++++
 
+// Dead resources are evicted in order of size per access, where the time spent decoding or parsing
+// a resource counts as additional accesses, so that resources that are expensive to recreate are
+// kept longer. Dead resources are also split in partitions by type, each allowed a share of the dead
+// capacity, so that a burst of resources of one type cannot push all the other types out of the cache.
+
 class MemoryCache {
     WTF_MAKE_NONCOPYABLE(MemoryCache); WTF_MAKE_FAST_ALLOCATED;
     friend NeverDestroyed<MemoryCache>;
@@ -89,6 +94,16 @@ public:
         TypeStatistic fonts;
     };
 
+    // Totals accumulated over all the prunes of dead resources.
+    struct PruneStatistics {
+        unsigned pruneCount { 0 };
+        unsigned decodedDataDestroyedCount { 0 };
+        unsigned evictedCount { 0 };
+        unsigned evictedOverPartitionBudgetCount { 0 };
+        uint64_t evictedSize { 0 };
+        Seconds evictedRecreationCost;
+    };
+
     WEBCORE_EXPORT static MemoryCache& singleton();
 
     WEBCORE_EXPORT CachedResource* resourceForRequest(const ResourceRequest&, SessionID);
@@ -124,6 +139,9 @@ public:
     void prune();
     void pruneSoon();
     unsigned size() const { return m_liveSize + m_deadSize; }
+    unsigned liveSize() const { return m_liveSize; }
+    unsigned deadSize() const { return m_deadSize; }
+    unsigned liveDecodedSize() const;
 
     void setDeadDecodedDataDeletionInterval(Seconds interval) { m_deadDecodedDataDeletionInterval = interval; }
     Seconds deadDecodedDataDeletionInterval() const { return m_deadDecodedDataDeletionInterval; }
@@ -146,6 +164,7 @@ public:
 
     // Function to collect cache statistics for the caches window in the Safari Debug menu.
     WEBCORE_EXPORT Statistics getStatistics();
+    const PruneStatistics& pruneStatistics() const { return m_pruneStatistics; }
     
     void resourceAccessed(CachedResource&);
     bool inLiveDecodedResourcesList(CachedResource& resource) const { return m_liveDecodedResources.contains(&resource); }
@@ -175,6 +194,8 @@ private:
     ~MemoryCache(); // Not implemented to make sure nobody accidentally calls delete -- WebCore does not delete singletons.
 
     LRUList& lruListFor(CachedResource&);
+    void pruneDeadResourcesOverPartitionBudgets(unsigned targetSize);
+    void evictDeadResource(CachedResource&);
 #ifndef NDEBUG
     void dumpStats();
     void dumpLRULists(bool includeLive) const;
@@ -213,6 +234,8 @@ private:
     typedef HashMap<SessionID, std::unique_ptr<CachedResourceMap>> SessionCachedResourceMap;
     SessionCachedResourceMap m_sessionResources;
 
+    PruneStatistics m_pruneStatistics;
+
     Timer m_pruneTimer;
 };
 
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "StreamingScriptDecoder.h"
+
+#include "SharedBuffer.h"
+#include "TextResourceDecoder.h"
+#include <wtf/MonotonicTime.h>
+
+namespace WebCore {
+
+StreamingScriptDecoder::StreamingScriptDecoder(const TextEncoding& encoding)
+    : m_encoding(encoding)
+{
+    if (!m_encoding.isByteBasedEncoding())
+        m_decoder = TextResourceDecoder::create(ASCIILiteral("application/javascript"), m_encoding);
+}
+
+StreamingScriptDecoder::~StreamingScriptDecoder()
+{
+}
+
+void StreamingScriptDecoder::append(const SharedBuffer& data)
+{
+    unsigned segmentStart = 0;
+    for (auto& segment : data) {
+        unsigned segmentEnd = segmentStart + segment->size();
+        if (segmentEnd > m_size) {
+            unsigned offset = std::max(segmentStart, m_size) - segmentStart;
+            auto* characters = segment->data() + offset;
+            unsigned length = segment->size() - offset;
+            if (!m_decoder && !charactersAreAllASCII(reinterpret_cast<const LChar*>(characters), length)) {
+                // Start over, decoding from the first byte so that the decoder sees the data exactly as it would all at once.
+                m_decoder = TextResourceDecoder::create(ASCIILiteral("application/javascript"), m_encoding);
+                m_hasher = StringHasher();
+                m_contiguousData.clear();
+                for (auto& previousSegment : data) {
+                    if (previousSegment.ptr() == segment.ptr())
+                        break;
+                    decode(previousSegment->data(), previousSegment->size());
+                }
+                characters = segment->data();
+                length = segment->size();
+            }
+            if (m_decoder)
+                decode(characters, length);
+            else {
+                m_hasher.addCharacters(reinterpret_cast<const LChar*>(characters), length);
+                m_contiguousData.append(characters, length);
+            }
+        }
+        segmentStart = segmentEnd;
+    }
+    m_size = segmentStart;
+}
+
+String StreamingScriptDecoder::finish()
+{
+    if (!m_decoder)
+        return String();
+
+    auto decodingStartTime = MonotonicTime::now();
+    appendDecodedText(m_decoder->flush());
+    m_decodingTime += MonotonicTime::now() - decodingStartTime;
+
+    String script = m_decodedScript.toString();
+    ASSERT(script.isEmpty() || hash() == script.impl()->hash());
+    return script;
+}
+
+Ref<SharedBuffer> StreamingScriptDecoder::takeContiguousData()
+{
+    ASSERT(!m_decoder);
+    ASSERT(m_contiguousData.size() == m_size);
+    return SharedBuffer::create(WTFMove(m_contiguousData));
+}
+
+void StreamingScriptDecoder::decode(const char* characters, unsigned length)
+{
+    auto decodingStartTime = MonotonicTime::now();
+    String decoded = m_decoder->decode(characters, length);
+    m_decodingTime += MonotonicTime::now() - decodingStartTime;
+    appendDecodedText(decoded);
+}
+
+void StreamingScriptDecoder::appendDecodedText(const String& text)
+{
+    if (text.isEmpty())
+        return;
+    if (text.is8Bit())
+        m_hasher.addCharacters(text.characters8(), text.length());
+    else
+        m_hasher.addCharacters(text.characters16(), text.length());
+    m_decodedScript.append(text);
+}
+
+} // namespace WebCore
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "TextEncoding.h"
+#include <wtf/Forward.h>
+#include <wtf/Ref.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Seconds.h>
+#include <wtf/text/StringBuilder.h>
+#include <wtf/text/StringHasher.h>
+
+namespace WebCore {
+
+class SharedBuffer;
+class TextResourceDecoder;
+
+// Checks a script for ASCII, decodes it and hashes it chunk by chunk while it is received, with the
+// same results as decoding the whole data at once and hashing the resulting string.
+class StreamingScriptDecoder {
+    WTF_MAKE_NONCOPYABLE(StreamingScriptDecoder); WTF_MAKE_FAST_ALLOCATED;
+public:
+    WEBCORE_EXPORT explicit StreamingScriptDecoder(const TextEncoding&);
+    WEBCORE_EXPORT ~StreamingScriptDecoder();
+
+    // Processes the bytes that previous calls haven't seen. The data must start with the bytes given before.
+    WEBCORE_EXPORT void append(const SharedBuffer&);
+    unsigned size() const { return m_size; }
+
+    // Must be called once every byte has been appended. Returns the null string when the bytes can be used
+    // as they are, because they are all ASCII and the encoding is byte based.
+    WEBCORE_EXPORT String finish();
+
+    // The bytes of an ASCII script in a single segment, so that using them doesn't combine the segments of
+    // the received data. Only valid after finish() returned the null string.
+    WEBCORE_EXPORT Ref<SharedBuffer> takeContiguousData();
+
+    // The same hash as StringImpl::hash() of the script. Only valid after finish().
+    unsigned hash() const { return m_hasher.hashWithTop8BitsMasked(); }
+
+    // Whether a non-ASCII byte was seen or the encoding isn't byte based.
+    bool isDecoding() const { return m_decoder; }
+    Seconds decodingTime() const { return m_decodingTime; }
+
+private:
+    void decode(const char*, unsigned length);
+    void appendDecodedText(const String&);
+
+    TextEncoding m_encoding;
+    unsigned m_size { 0 };
+    // Decoding only starts once a non-ASCII byte is seen, as ASCII data in a byte based encoding is used as is.
+    RefPtr<TextResourceDecoder> m_decoder;
+    Vector<char> m_contiguousData;
+    StringBuilder m_decodedScript;
+    StringHasher m_hasher;
+    Seconds m_decodingTime;
+};
+
+} // namespace WebCore
@@ -338,6 +338,7 @@ void FrameView::reset()
     m_layoutTimer.stop();
     m_layoutRoot = nullptr;
     m_delayedLayout = false;
+    m_lastTimerLayoutDuration = 0_s;
     m_needsFullRepaint = true;
     m_layoutSchedulingEnabled = true;
     m_layoutPhase = OutsideLayout;
@@ -1393,7 +1394,10 @@ void FrameView::layout(bool allowSubtree)
     bool subtree = false;
     RenderElement* root = nullptr;
 
-    ++m_nestedLayoutCount;
+    if (!m_nestedLayoutCount++) {
+        m_itemMeasureLayoutCount = 0;
+        m_itemMeasureCacheHitCount = 0;
+    }
 
     {
         SetForScope<bool> changeSchedulingEnabled(m_layoutSchedulingEnabled, false);
@@ -1585,6 +1589,7 @@ void FrameView::layout(bool allowSubtree)
     }
 
     InspectorInstrumentation::didLayout(cookie, *root);
+    LOG_WITH_STREAM(Layout, stream << "FrameView " << this << " layout measured " << m_itemMeasureLayoutCount << " flex/grid items with layout, reused " << m_itemMeasureCacheHitCount << " measurements");
     DebugPageOverlays::didLayout(frame());
 
     --m_nestedLayoutCount;
@@ -3007,7 +3012,36 @@ void FrameView::layoutTimerFired()
     if (!frame().document()->ownerElement())
         LOG(Layout, "FrameView %p layout timer fired at %.3fs", this, frame().document()->timeSinceDocumentCreation().value());
 #endif
+    Ref<FrameView> protectedThis(*this);
+    auto startTime = MonotonicTime::now();
     layout();
+    m_lastTimerLayoutDuration = MonotonicTime::now() - startTime;
+}
+
+// Layouts scheduled while the document is loading that take longer than this are followed by a pause.
+static const Seconds loadingLayoutBudget = 16_ms;
+static const Seconds maximumLoadingLayoutDelay = 100_ms;
+
+Seconds FrameView::budgetedLayoutDelay() const
+{
+    if (!frame().settings().budgetedLayoutDuringLoadEnabled())
+        return 0_s;
+
+    // Until there is something to show, layout decides time to first paint and should run as early as possible.
+    if (!isVisuallyNonEmpty())
+        return 0_s;
+
+    auto* document = frame().document();
+    if (!document || !document->parsing())
+        return 0_s;
+
+    if (m_lastTimerLayoutDuration <= loadingLayoutBudget)
+        return 0_s;
+
+    // Leave the run loop at least as much time as the last layout took, so that input events and
+    // animation frames are serviced while the rest of the document streams in. Synchronous layouts
+    // (script queries, rendering updates) are not affected and still bring the tree up to date.
+    return std::min(m_lastTimerLayoutDuration, maximumLoadingLayoutDelay);
 }
 
 void FrameView::scheduleRelayout()
@@ -112,6 +112,8 @@ public:
     void unscheduleRelayout();
     void queuePostLayoutCallback(WTF::Function<void ()>&&);
     bool layoutPending() const;
+    // Extra delay before a scheduled layout while the document is still loading, see budgetedLayoutDuringLoadEnabled.
+    Seconds budgetedLayoutDelay() const;
     bool isInLayout() const { return m_layoutPhase != OutsideLayout; }
     bool isInRenderTreeLayout() const { return m_layoutPhase == InRenderTreeLayout; }
     WEBCORE_EXPORT bool inPaintableState() { return m_layoutPhase != InRenderTreeLayout && m_layoutPhase != InViewSizeAdjust && m_layoutPhase != InPostLayout; }
@@ -120,6 +122,12 @@ public:
     void clearLayoutRoot() { m_layoutRoot = nullptr; }
     int layoutCount() const { return m_layoutCount; }
 
+    // Flex and grid items laid out only to measure them, and measurements reused instead, during the last layout.
+    unsigned itemMeasureLayoutCount() const { return m_itemMeasureLayoutCount; }
+    unsigned itemMeasureCacheHitCount() const { return m_itemMeasureCacheHitCount; }
+    void didMeasureItemWithLayout() { ++m_itemMeasureLayoutCount; }
+    void didReuseItemMeasurement() { ++m_itemMeasureCacheHitCount; }
+
     WEBCORE_EXPORT bool needsLayout() const;
     WEBCORE_EXPORT void setNeedsLayout();
     void setViewportConstrainedObjectsNeedLayout();
@@ -788,6 +796,7 @@ private:
 
     Timer m_layoutTimer;
     bool m_delayedLayout;
+    Seconds m_lastTimerLayoutDuration;
     RenderElement* m_layoutRoot { nullptr };
 
     LayoutPhase m_layoutPhase;
@@ -795,6 +804,8 @@ private:
     bool m_inSynchronousPostLayout;
     int m_layoutCount;
     unsigned m_nestedLayoutCount;
+    unsigned m_itemMeasureLayoutCount { 0 };
+    unsigned m_itemMeasureCacheHitCount { 0 };
     Timer m_postLayoutTasksTimer;
     Timer m_updateEmbeddedObjectsTimer;
     bool m_firstLayoutCallbackPending;
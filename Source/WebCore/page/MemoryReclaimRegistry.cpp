@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "MemoryReclaimRegistry.h"
+
+#include "Logging.h"
+#include <wtf/MainThread.h>
+#include <wtf/MemoryPressureHandler.h>
+
+namespace WebCore {
+
+MemoryReclaimRegistry& MemoryReclaimRegistry::singleton()
+{
+    ASSERT(isMainThread());
+    static NeverDestroyed<MemoryReclaimRegistry> registry;
+    return registry;
+}
+
+void MemoryReclaimRegistry::add(const char* name, MemoryReclaimCost cost, WTF::Function<size_t()>&& reclaimableBytes, WTF::Function<void(size_t)>&& reclaim)
+{
+    size_t position = m_reclaimers.findMatching([cost](auto& reclaimer) {
+        return reclaimer.cost > cost;
+    });
+    if (position == notFound)
+        position = m_reclaimers.size();
+    m_reclaimers.insert(position, Reclaimer { name, cost, WTFMove(reclaimableBytes), WTFMove(reclaim) });
+}
+
+size_t MemoryReclaimRegistry::reclaimableBytes(MemoryReclaimCost maxCost) const
+{
+    size_t bytes = 0;
+    for (auto& reclaimer : m_reclaimers) {
+        if (reclaimer.cost > maxCost)
+            break;
+        bytes += reclaimer.reclaimableBytes();
+    }
+    return bytes;
+}
+
+size_t MemoryReclaimRegistry::reclaim(size_t bytesToReclaim, MemoryReclaimCost maxCost)
+{
+    size_t reclaimedBytes = 0;
+    for (auto& reclaimer : m_reclaimers) {
+        if (reclaimedBytes >= bytesToReclaim || reclaimer.cost > maxCost)
+            break;
+
+        size_t available = reclaimer.reclaimableBytes();
+        if (!available)
+            continue;
+
+        size_t bytes = std::min(available, bytesToReclaim - reclaimedBytes);
+        LOG(MemoryPressure, "Reclaiming %zu of %zu bytes from %s", bytes, available, reclaimer.name);
+        MemoryPressureHandler::ReliefLogger log(reclaimer.name);
+        reclaimer.reclaim(bytes);
+        reclaimedBytes += bytes;
+    }
+    return reclaimedBytes;
+}
+
+} // namespace WebCore
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <wtf/Function.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// What it costs to get the memory back once it has been reclaimed, from rebuilding a small
+// lookup table to reloading a page or recompiling its scripts.
+enum class MemoryReclaimCost {
+    Low,
+    Moderate,
+    High,
+};
+
+// Caches that can give memory back under moderate pressure register here, so the memory
+// pressure handler can release just enough of it, cheapest first, instead of flushing everything.
+class MemoryReclaimRegistry {
+    WTF_MAKE_NONCOPYABLE(MemoryReclaimRegistry); WTF_MAKE_FAST_ALLOCATED;
+    friend class NeverDestroyed<MemoryReclaimRegistry>;
+public:
+    WEBCORE_EXPORT static MemoryReclaimRegistry& singleton();
+
+    // reclaimableBytes() returns an estimate of how much reclaim() could release. reclaim() is
+    // asked to release at least the given number of bytes; caches that can only be dropped as a
+    // whole release everything.
+    WEBCORE_EXPORT void add(const char* name, MemoryReclaimCost, WTF::Function<size_t()>&& reclaimableBytes, WTF::Function<void(size_t)>&& reclaim);
+
+    // Only the caches costing at most maxCost to rebuild are taken into account.
+    size_t reclaimableBytes(MemoryReclaimCost maxCost) const;
+
+    // Reclaims from the cheapest caches first until bytesToReclaim have been released.
+    // Returns the estimated number of bytes released.
+    size_t reclaim(size_t bytesToReclaim, MemoryReclaimCost maxCost);
+
+private:
+    MemoryReclaimRegistry() = default;
+
+    struct Reclaimer {
+        const char* name;
+        MemoryReclaimCost cost;
+        WTF::Function<size_t()> reclaimableBytes;
+        WTF::Function<void(size_t)> reclaim;
+    };
+
+    // Sorted by cost, in registration order for the same cost.
+    Vector<Reclaimer> m_reclaimers;
+};
+
+} // namespace WebCore
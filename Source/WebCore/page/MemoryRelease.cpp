@@ -33,12 +33,14 @@
 #include "Document.h"
 #include "FontCache.h"
 #include "GCController.h"
+#include "GlyphPage.h"
 #include "HTMLMediaElement.h"
 #include "InlineStyleSheetOwner.h"
 #include "InspectorInstrumentation.h"
 #include "Logging.h"
 #include "MainFrame.h"
 #include "MemoryCache.h"
+#include "MemoryReclaimRegistry.h"
 #include "Page.h"
 #include "PageCache.h"
 #include "RenderTheme.h"
@@ -46,9 +48,14 @@
 #include "StyleScope.h"
 #include "StyledElement.h"
 #include "WorkerThread.h"
+#include <jit/ExecutableAllocator.h>
 #include <wtf/FastMalloc.h>
 #include <wtf/SystemTracing.h>
 
+#if USE(HARFBUZZ)
+#include "HarfBuzzShapeCache.h"
+#endif
+
 #if PLATFORM(COCOA)
 #include "ResourceUsageThread.h"
 #endif
@@ -63,6 +70,10 @@ static void releaseNoncriticalMemory()
 
     clearWidthCaches();
 
+#if USE(HARFBUZZ)
+    HarfBuzzShapeCache::singleton().clear();
+#endif
+
     for (auto* document : Document::allDocuments())
         document->clearSelectorQueryCache();
 
@@ -71,6 +82,91 @@ static void releaseNoncriticalMemory()
     InlineStyleSheetOwner::clearCache();
 }
 
+// FIXME: The font cache doesn't know how much memory its entries hold.
+static const size_t estimatedFontOverhead = 16 * KB;
+#if USE(HARFBUZZ)
+static const size_t estimatedBytesPerShapeCacheEntry = 1 * KB;
+#endif
+
+static size_t estimatedBytesPerFont()
+{
+    // Glyph pages are owned by their font and go away with it.
+    size_t fontCount = FontCache::singleton().fontCount();
+    if (!fontCount)
+        return estimatedFontOverhead;
+    return estimatedFontOverhead + GlyphPage::count() * sizeof(GlyphPage) / fontCount;
+}
+
+static void registerMemoryReclaimers()
+{
+    static bool registered;
+    if (registered)
+        return;
+    registered = true;
+
+    auto& registry = MemoryReclaimRegistry::singleton();
+
+    registry.add("Dead resources", MemoryReclaimCost::Low, [] {
+        return MemoryCache::singleton().deadSize();
+    }, [] (size_t bytes) {
+        auto& memoryCache = MemoryCache::singleton();
+        memoryCache.pruneDeadResourcesToSize(memoryCache.deadSize() - std::min<size_t>(bytes, memoryCache.deadSize()));
+    });
+
+#if USE(HARFBUZZ)
+    registry.add("Shaping results", MemoryReclaimCost::Low, [] {
+        return HarfBuzzShapeCache::singleton().size() * estimatedBytesPerShapeCacheEntry;
+    }, [] (size_t) {
+        HarfBuzzShapeCache::singleton().clear();
+    });
+#endif
+
+    registry.add("Inactive fonts", MemoryReclaimCost::Moderate, [] {
+        return FontCache::singleton().inactiveFontCount() * estimatedBytesPerFont();
+    }, [] (size_t bytes) {
+        size_t bytesPerFont = estimatedBytesPerFont();
+        FontCache::singleton().purgeInactiveFontData((bytes + bytesPerFont - 1) / bytesPerFont);
+    });
+
+    registry.add("Live decoded data", MemoryReclaimCost::Moderate, [] {
+        return MemoryCache::singleton().liveDecodedSize();
+    }, [] (size_t bytes) {
+        auto& memoryCache = MemoryCache::singleton();
+        memoryCache.pruneLiveResourcesToSize(memoryCache.liveSize() - std::min<size_t>(bytes, memoryCache.liveSize()));
+    });
+
+    registry.add("Page cache", MemoryReclaimCost::High, [] {
+        return PageCache::singleton().memoryCost();
+    }, [] (size_t bytes) {
+        auto& pageCache = PageCache::singleton();
+        size_t memoryCost = pageCache.memoryCost();
+        pageCache.pruneToMemoryCostNow(memoryCost - std::min(bytes, memoryCost), PruningReason::MemoryPressure);
+    });
+
+#if ENABLE(JIT)
+    registry.add("JIT code", MemoryReclaimCost::High, [] {
+        return JSC::ExecutableAllocator::committedByteCount();
+    }, [] (size_t) {
+        GCController::singleton().deleteAllCode(JSC::DeleteAllCodeIfNotCollecting);
+    });
+#endif
+}
+
+static void releaseMemoryToBudget(MemoryPressureLevel level)
+{
+    ASSERT(level == MemoryPressureLevel::Low || level == MemoryPressureLevel::Medium);
+    registerMemoryReclaimers();
+
+    // Give back a quarter of what the caches hold under low pressure and half of it under medium
+    // pressure, starting with what is cheapest to rebuild. Low pressure doesn't justify throwing
+    // away cached pages or JIT code, they are expensive to get back.
+    auto& registry = MemoryReclaimRegistry::singleton();
+    if (level == MemoryPressureLevel::Low)
+        registry.reclaim(registry.reclaimableBytes(MemoryReclaimCost::Moderate) / 4, MemoryReclaimCost::Moderate);
+    else
+        registry.reclaim(registry.reclaimableBytes(MemoryReclaimCost::High) / 2, MemoryReclaimCost::High);
+}
+
 static void releaseCriticalMemory(Synchronous synchronous)
 {
     // Right now, the only reason we call release critical memory while not under memory pressure is if the process is about to be suspended.
@@ -116,7 +212,11 @@ void releaseMemory(Critical critical, Synchronous synchronous)
         releaseCriticalMemory(synchronous);
     }
 
-    releaseNoncriticalMemory();
+    auto level = MemoryPressureHandler::singleton().pressureLevel();
+    if (critical == Critical::No && (level == MemoryPressureLevel::Low || level == MemoryPressureLevel::Medium))
+        releaseMemoryToBudget(level);
+    else
+        releaseNoncriticalMemory();
 
     platformReleaseMemory(critical);
 
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ProcessWarming.h"
+
+#include "CSSDefaultStyleSheets.h"
+#include "CommonVM.h"
+#include "FontCache.h"
+#include "Language.h"
+#include <wtf/text/LineBreakIteratorPoolICU.h>
+#include <wtf/text/TextBreakIterator.h>
+
+namespace WebCore {
+
+void ProcessWarming::prewarmGlobally()
+{
+    // User agent style sheets and the rule sets built from them.
+    CSSDefaultStyleSheets::ensureFullDefaultStyle();
+
+    // Platform font configuration, and the fallback font every page ends up needing.
+    FontCache::singleton().lastResortFallbackFont(FontDescription());
+
+    // ICU break iterator rules.
+    auto& lineBreakIteratorPool = LineBreakIteratorPool::sharedPool();
+    lineBreakIteratorPool.put(lineBreakIteratorPool.take(defaultLanguage(), LineBreakIteratorMode::Default));
+    wordBreakIterator(StringView());
+
+    // The JavaScript VM shared by all the pages of the process.
+    commonVM();
+}
+
+} // namespace WebCore
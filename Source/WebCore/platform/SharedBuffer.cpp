@@ -97,6 +97,27 @@ const char* SharedBuffer::data() const
     return m_segments[0]->data();
 }
 
+unsigned SharedBuffer::getSomeData(const char*& someData, unsigned position) const
+{
+    someData = nullptr;
+    if (position >= m_size)
+        return 0;
+
+    size_t segmentStart = 0;
+    for (const auto& segment : m_segments) {
+        size_t segmentSize = segment->size();
+        if (position < segmentStart + segmentSize) {
+            size_t offsetInSegment = position - segmentStart;
+            someData = segment->data() + offsetInSegment;
+            return segmentSize - offsetInSegment;
+        }
+        segmentStart += segmentSize;
+    }
+
+    ASSERT_NOT_REACHED();
+    return 0;
+}
+
 RefPtr<ArrayBuffer> SharedBuffer::tryCreateArrayBuffer() const
 {
     RefPtr<ArrayBuffer> arrayBuffer = ArrayBuffer::createUninitialized(static_cast<unsigned>(size()), sizeof(char));
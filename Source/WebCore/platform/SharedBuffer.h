@@ -80,6 +80,10 @@ public:
     // FIXME: Audit the call sites of this function and replace them with iteration if possible.
     const char* data() const;
 
+    // Points |data| at the contiguous bytes starting at |position| and returns how many there are,
+    // without combining the segments. Returns 0 when |position| is past the end of the buffer.
+    unsigned getSomeData(const char*& data, unsigned position = 0) const;
+
     // Creates an ArrayBuffer and copies this SharedBuffer's contents to that
     // ArrayBuffer without merging segmented buffers into a flat buffer.
     RefPtr<ArrayBuffer> tryCreateArrayBuffer() const;
@@ -44,6 +44,10 @@
 #include "OpenTypeVerticalData.h"
 #endif
 
+#if USE(HARFBUZZ)
+#include "HarfBuzzShapeCache.h"
+#endif
+
 #if USE(DIRECT2D)
 #include <dwrite.h>
 #endif
@@ -137,6 +141,9 @@ void Font::platformGlyphInit()
 Font::~Font()
 {
     removeFromSystemFallbackCache();
+#if USE(HARFBUZZ)
+    HarfBuzzShapeCache::singleton().removeEntriesForFont(*this);
+#endif
 }
 
 static bool fillGlyphPage(GlyphPage& pageToFill, UChar* buffer, unsigned bufferLength, const Font& font)
@@ -43,6 +43,7 @@
 
 #include <wtf/CheckedArithmetic.h>
 #include <wtf/MainThread.h>
+#include <wtf/MonotonicTime.h>
 #include <wtf/RunLoop.h>
 
 namespace WebCore {
@@ -127,6 +128,14 @@ void ImageFrameCache::decodedSizeChanged(long long decodedSize)
     m_image->imageObserver()->decodedSizeChanged(*m_image, decodedSize);
 }
 
+void ImageFrameCache::didDecodeFrame(size_t index, Seconds decodingTime)
+{
+    if (!m_image || !m_image->imageObserver())
+        return;
+
+    m_image->imageObserver()->didDecodeFrame(*m_image, index, decodingTime);
+}
+
 void ImageFrameCache::decodedSizeIncreased(unsigned decodedSize)
 {
     if (!decodedSize)
@@ -288,7 +297,9 @@ void ImageFrameCache::startAsyncDecodingQueue()
             TraceScope tracingScope(AsyncImageDecodeStart, AsyncImageDecodeEnd);
 
             // Get the frame NativeImage on the decoding thread.
+            auto decodingStartTime = MonotonicTime::now();
             NativeImagePtr nativeImage = protectedDecoder->createFrameImageAtIndex(frameRequest.index, frameRequest.subsamplingLevel, frameRequest.decodingOptions);
+            Seconds decodingTime = MonotonicTime::now() - decodingStartTime;
             if (nativeImage)
                 LOG(Images, "ImageFrameCache::%s - %p - url: %s [frame %ld has been decoded]", __FUNCTION__, protectedThis.ptr(), protectedThis->sourceURL().string().utf8().data(), frameRequest.index);
             else {
@@ -297,12 +308,13 @@ void ImageFrameCache::startAsyncDecodingQueue()
             }
 
             // Update the cached frames on the main thread to avoid updating the MemoryCache from a different thread.
-            callOnMainThread([protectedThis = protectedThis.copyRef(), protectedQueue = protectedQueue.copyRef(), protectedDecoder = protectedDecoder.copyRef(), nativeImage = WTFMove(nativeImage), frameRequest] () mutable {
+            callOnMainThread([protectedThis = protectedThis.copyRef(), protectedQueue = protectedQueue.copyRef(), protectedDecoder = protectedDecoder.copyRef(), nativeImage = WTFMove(nativeImage), frameRequest, decodingTime] () mutable {
                 // The queue may have been closed if after we got the frame NativeImage, stopAsyncDecodingQueue() was called.
                 if (protectedQueue.ptr() == protectedThis->m_decodingQueue && protectedDecoder.ptr() == protectedThis->m_decoder) {
                     ASSERT(protectedThis->m_frameCommitQueue.first() == frameRequest);
                     protectedThis->m_frameCommitQueue.removeFirst();
                     protectedThis->cacheNativeImageAtIndexAsync(WTFMove(nativeImage), frameRequest.index, frameRequest.subsamplingLevel, frameRequest.decodingOptions, frameRequest.decodingStatus);
+                    protectedThis->didDecodeFrame(frameRequest.index, decodingTime);
                 } else
                     LOG(Images, "ImageFrameCache::%s - %p - url: %s [frame %ld will not cached]", __FUNCTION__, protectedThis.ptr(), protectedThis->sourceURL().string().utf8().data(), frameRequest.index);
             });
@@ -370,9 +382,12 @@ const ImageFrame& ImageFrameCache::frameAtIndexCacheIfNeeded(size_t index, Image
         if (frame.hasFullSizeNativeImage(subsamplingLevel))
             break;
         // We have to perform synchronous image decoding in this code. 
+        auto decodingStartTime = MonotonicTime::now();
         NativeImagePtr nativeImage = m_decoder->createFrameImageAtIndex(index, subsamplingLevelValue);
+        Seconds decodingTime = MonotonicTime::now() - decodingStartTime;
         // Clean the old native image and set a new one.
         cacheNativeImageAtIndex(WTFMove(nativeImage), index, subsamplingLevelValue, DecodingMode::Synchronous);
+        didDecodeFrame(index, decodingTime);
         break;
     }
 
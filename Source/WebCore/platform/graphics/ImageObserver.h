@@ -27,6 +27,7 @@
 #define ImageObserver_h
 
 #include "ImageTypes.h"
+#include <wtf/Seconds.h>
 
 namespace WebCore {
 
@@ -42,6 +43,7 @@ protected:
 public:
     virtual URL sourceUrl() const = 0;
     virtual void decodedSizeChanged(const Image&, long long delta) = 0;
+    virtual void didDecodeFrame(const Image&, size_t index, Seconds decodingTime) = 0;
 
     virtual void didDraw(const Image&) = 0;
 
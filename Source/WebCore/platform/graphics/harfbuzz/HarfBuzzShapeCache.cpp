@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HarfBuzzShapeCache.h"
+
+#if USE(HARFBUZZ)
+
+#include <wtf/HashFunctions.h>
+
+namespace WebCore {
+
+bool HarfBuzzShapeCacheKey::operator==(const HarfBuzzShapeCacheKey& other) const
+{
+    if (font != other.font || script != other.script || direction != other.direction || text != other.text)
+        return false;
+    if (features.size() != other.features.size())
+        return false;
+    for (unsigned i = 0; i < features.size(); ++i) {
+        const auto& feature = features[i];
+        const auto& otherFeature = other.features[i];
+        if (feature.tag != otherFeature.tag || feature.value != otherFeature.value || feature.start != otherFeature.start || feature.end != otherFeature.end)
+            return false;
+    }
+    return true;
+}
+
+unsigned HarfBuzzShapeCacheKeyHash::hash(const HarfBuzzShapeCacheKey& key)
+{
+    unsigned hash = key.text.isNull() ? 0 : key.text.impl()->hash();
+    hash = WTF::pairIntHash(hash, PtrHash<const Font*>::hash(key.font));
+    hash = WTF::pairIntHash(hash, (static_cast<unsigned>(key.script) << 8) | static_cast<unsigned>(key.direction));
+    for (const auto& feature : key.features)
+        hash = WTF::pairIntHash(hash, feature.tag ^ feature.value);
+    return hash;
+}
+
+HarfBuzzShapeCache& HarfBuzzShapeCache::singleton()
+{
+    static NeverDestroyed<HarfBuzzShapeCache> cache;
+    return cache;
+}
+
+const HarfBuzzShapeResult* HarfBuzzShapeCache::find(const HarfBuzzShapeCacheKey& key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        ++m_missCount;
+        return nullptr;
+    }
+
+    ++m_hitCount;
+    Entry* entry = it->value.get();
+    if (entry != m_recentlyUsedList.head()) {
+        m_recentlyUsedList.remove(entry);
+        m_recentlyUsedList.push(entry);
+    }
+    return &entry->result;
+}
+
+const HarfBuzzShapeResult& HarfBuzzShapeCache::add(HarfBuzzShapeCacheKey&& key, hb_buffer_t* buffer)
+{
+    ASSERT(canCache(key.text.length()));
+    ASSERT(!m_entries.contains(key));
+
+    if (m_entries.size() >= maxSize)
+        remove(*m_recentlyUsedList.tail());
+
+    auto entry = std::make_unique<Entry>();
+    unsigned numGlyphs = hb_buffer_get_length(buffer);
+    entry->result.glyphInfos.append(hb_buffer_get_glyph_infos(buffer, nullptr), numGlyphs);
+    entry->result.glyphPositions.append(hb_buffer_get_glyph_positions(buffer, nullptr), numGlyphs);
+    entry->key = WTFMove(key);
+
+    m_entryCountForFont.add(entry->key.font);
+    m_recentlyUsedList.push(entry.get());
+
+    auto& result = entry->result;
+    auto addResult = m_entries.add(entry->key, WTFMove(entry));
+    ASSERT_UNUSED(addResult, addResult.isNewEntry);
+    return result;
+}
+
+void HarfBuzzShapeCache::remove(Entry& entry)
+{
+    m_recentlyUsedList.remove(&entry);
+    m_entryCountForFont.remove(entry.key.font);
+    // Copy the key, the entry is destroyed when removed from the map.
+    auto key = entry.key;
+    m_entries.remove(key);
+}
+
+void HarfBuzzShapeCache::removeEntriesForFont(const Font& font)
+{
+    if (!m_entryCountForFont.contains(&font))
+        return;
+
+    Vector<Entry*> entriesToRemove;
+    for (auto& entry : m_entries.values()) {
+        if (entry->key.font == &font)
+            entriesToRemove.append(entry.get());
+    }
+    for (auto* entry : entriesToRemove)
+        remove(*entry);
+    ASSERT(!m_entryCountForFont.contains(&font));
+}
+
+void HarfBuzzShapeCache::clear()
+{
+    m_recentlyUsedList.clear();
+    m_entries.clear();
+    m_entryCountForFont.clear();
+}
+
+} // namespace WebCore
+
+#endif // USE(HARFBUZZ)
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if USE(HARFBUZZ)
+
+#include "hb.h"
+#include <wtf/DoublyLinkedList.h>
+#include <wtf/HashCountedSet.h>
+#include <wtf/HashMap.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+class Font;
+
+// Everything that determines the output of hb_shape() for one HarfBuzzShaper run.
+struct HarfBuzzShapeCacheKey {
+    HarfBuzzShapeCacheKey() = default;
+    HarfBuzzShapeCacheKey(const Font* font, hb_script_t script, hb_direction_t direction, const hb_feature_t* features, unsigned featureCount, const String& text)
+        : font(font)
+        , script(script)
+        , direction(direction)
+        , text(text)
+    {
+        this->features.append(features, featureCount);
+    }
+
+    HarfBuzzShapeCacheKey(WTF::HashTableDeletedValueType)
+        : font(reinterpret_cast<const Font*>(-1))
+    {
+    }
+    bool isHashTableDeletedValue() const { return font == reinterpret_cast<const Font*>(-1); }
+
+    bool operator==(const HarfBuzzShapeCacheKey&) const;
+
+    const Font* font { nullptr };
+    hb_script_t script { HB_SCRIPT_INVALID };
+    hb_direction_t direction { HB_DIRECTION_INVALID };
+    Vector<hb_feature_t> features;
+    String text;
+};
+
+struct HarfBuzzShapeCacheKeyHash {
+    static unsigned hash(const HarfBuzzShapeCacheKey&);
+    static bool equal(const HarfBuzzShapeCacheKey& a, const HarfBuzzShapeCacheKey& b) { return a == b; }
+    static const bool safeToCompareToEmptyOrDeleted = true;
+};
+
+struct HarfBuzzShapeCacheKeyHashTraits : WTF::SimpleClassHashTraits<HarfBuzzShapeCacheKey> {
+    static const bool emptyValueIsZero = false;
+};
+
+// Raw HarfBuzz output, before letter-spacing, word-spacing and justification are applied,
+// so the same entry serves width measurement and painting.
+struct HarfBuzzShapeResult {
+    Vector<hb_glyph_info_t> glyphInfos;
+    Vector<hb_glyph_position_t> glyphPositions;
+};
+
+class HarfBuzzShapeCache {
+    WTF_MAKE_NONCOPYABLE(HarfBuzzShapeCache); WTF_MAKE_FAST_ALLOCATED;
+    friend class NeverDestroyed<HarfBuzzShapeCache>;
+public:
+    WEBCORE_EXPORT static HarfBuzzShapeCache& singleton();
+
+    static bool canCache(unsigned textLength) { return textLength <= maxTextLength; }
+
+    const HarfBuzzShapeResult* find(const HarfBuzzShapeCacheKey&);
+    const HarfBuzzShapeResult& add(HarfBuzzShapeCacheKey&&, hb_buffer_t*);
+
+    void removeEntriesForFont(const Font&);
+    WEBCORE_EXPORT void clear();
+
+    unsigned size() const { return m_entries.size(); }
+    uint64_t hitCount() const { return m_hitCount; }
+    uint64_t missCount() const { return m_missCount; }
+
+private:
+    HarfBuzzShapeCache() = default;
+
+    struct Entry : public DoublyLinkedListNode<Entry> {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        HarfBuzzShapeCacheKey key;
+        HarfBuzzShapeResult result;
+        Entry* m_prev { nullptr };
+        Entry* m_next { nullptr };
+    };
+
+    void remove(Entry&);
+
+    static const unsigned maxTextLength = 256;
+    static const unsigned maxSize = 1024;
+
+    HashMap<HarfBuzzShapeCacheKey, std::unique_ptr<Entry>, HarfBuzzShapeCacheKeyHash, HarfBuzzShapeCacheKeyHashTraits> m_entries;
+    // Most recently used entry first.
+    DoublyLinkedList<Entry> m_recentlyUsedList;
+    HashCountedSet<const Font*> m_entryCountForFont;
+    uint64_t m_hitCount { 0 };
+    uint64_t m_missCount { 0 };
+};
+
+} // namespace WebCore
+
+#endif // USE(HARFBUZZ)
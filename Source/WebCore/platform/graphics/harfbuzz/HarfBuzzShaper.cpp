@@ -33,6 +33,7 @@
 
 #include "FontCascade.h"
 #include "HarfBuzzFace.h"
+#include "HarfBuzzShapeCache.h"
 #include "SurrogatePairAwareTextIterator.h"
 #include <hb-icu.h>
 #include <unicode/normlzr.h>
@@ -80,9 +81,9 @@ HarfBuzzShaper::HarfBuzzRun::HarfBuzzRun(const Font* fontData, unsigned startInd
 {
 }
 
-void HarfBuzzShaper::HarfBuzzRun::applyShapeResult(hb_buffer_t* harfBuzzBuffer)
+void HarfBuzzShaper::HarfBuzzRun::applyShapeResult(unsigned numGlyphs)
 {
-    m_numGlyphs = hb_buffer_get_length(harfBuzzBuffer);
+    m_numGlyphs = numGlyphs;
     if (!m_numGlyphs) {
         // HarfBuzzShaper::fillGlyphBuffer gets offsets()[0]
         m_offsets.resize(1);
@@ -478,24 +479,39 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns(bool shouldSetDirection)
             // Leaving direction to HarfBuzz to guess is *really* bad, but will do for now.
             hb_buffer_guess_segment_properties(harfBuzzBuffer.get());
 
-        // Add a space as pre-context to the buffer. This prevents showing dotted-circle
-        // for combining marks at the beginning of runs.
-        static const uint16_t preContext = ' ';
-        hb_buffer_add_utf16(harfBuzzBuffer.get(), &preContext, 1, 1, 0);
-
-        if (m_font->isSmallCaps() && u_islower(m_normalizedBuffer[currentRun->startIndex()])) {
-            String upperText = String(m_normalizedBuffer.get() + currentRun->startIndex(), currentRun->numCharacters()).convertToUppercaseWithoutLocale();
-            currentFontData = m_font->glyphDataForCharacter(upperText[0], false, SmallCapsVariant).font;
-            const UChar* characters = StringView(upperText).upconvertedCharacters();
-            hb_buffer_add_utf16(harfBuzzBuffer.get(), reinterpret_cast<const uint16_t*>(characters), currentRun->numCharacters(), 0, currentRun->numCharacters());
-        } else
-            hb_buffer_add_utf16(harfBuzzBuffer.get(), reinterpret_cast<const uint16_t*>(m_normalizedBuffer.get() + currentRun->startIndex()), currentRun->numCharacters(), 0, currentRun->numCharacters());
+        String text(m_normalizedBuffer.get() + currentRun->startIndex(), currentRun->numCharacters());
+        if (m_font->isSmallCaps() && u_islower(text[0])) {
+            text = text.convertToUppercaseWithoutLocale();
+            currentFontData = m_font->glyphDataForCharacter(text[0], false, SmallCapsVariant).font;
+        }
 
         FontPlatformData* platformData = const_cast<FontPlatformData*>(&currentFontData->platformData());
         HarfBuzzFace* face = platformData->harfBuzzFace();
         if (!face)
             return false;
 
+        // The guessed direction only depends on the script, so runs shaped for measuring
+        // and for painting share the same cache entries.
+        auto& shapeCache = HarfBuzzShapeCache::singleton();
+        std::optional<HarfBuzzShapeCacheKey> cacheKey;
+        if (HarfBuzzShapeCache::canCache(text.length())) {
+            cacheKey.emplace(currentFontData, currentRun->script(), hb_buffer_get_direction(harfBuzzBuffer.get()), m_features.data(), m_features.size(), text);
+            if (auto* cachedResult = shapeCache.find(*cacheKey)) {
+                currentRun->applyShapeResult(cachedResult->glyphInfos.size());
+                setGlyphPositionsForHarfBuzzRun(currentRun, cachedResult->glyphInfos.data(), cachedResult->glyphPositions.data());
+                hb_buffer_reset(harfBuzzBuffer.get());
+                continue;
+            }
+        }
+
+        // Add a space as pre-context to the buffer. This prevents showing dotted-circle
+        // for combining marks at the beginning of runs.
+        static const uint16_t preContext = ' ';
+        hb_buffer_add_utf16(harfBuzzBuffer.get(), &preContext, 1, 1, 0);
+
+        auto characters = StringView(text).upconvertedCharacters();
+        hb_buffer_add_utf16(harfBuzzBuffer.get(), reinterpret_cast<const uint16_t*>(characters.get()), currentRun->numCharacters(), 0, currentRun->numCharacters());
+
         if (m_font->fontDescription().orientation() == Vertical)
             face->setScriptForVerticalGlyphSubstitution(harfBuzzBuffer.get());
 
@@ -503,8 +519,14 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns(bool shouldSetDirection)
 
         hb_shape(harfBuzzFont.get(), harfBuzzBuffer.get(), m_features.isEmpty() ? 0 : m_features.data(), m_features.size());
 
-        currentRun->applyShapeResult(harfBuzzBuffer.get());
-        setGlyphPositionsForHarfBuzzRun(currentRun, harfBuzzBuffer.get());
+        if (cacheKey) {
+            auto& result = shapeCache.add(WTFMove(*cacheKey), harfBuzzBuffer.get());
+            currentRun->applyShapeResult(result.glyphInfos.size());
+            setGlyphPositionsForHarfBuzzRun(currentRun, result.glyphInfos.data(), result.glyphPositions.data());
+        } else {
+            currentRun->applyShapeResult(hb_buffer_get_length(harfBuzzBuffer.get()));
+            setGlyphPositionsForHarfBuzzRun(currentRun, hb_buffer_get_glyph_infos(harfBuzzBuffer.get(), nullptr), hb_buffer_get_glyph_positions(harfBuzzBuffer.get(), nullptr));
+        }
 
         hb_buffer_reset(harfBuzzBuffer.get());
     }
@@ -512,11 +534,9 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns(bool shouldSetDirection)
     return true;
 }
 
-void HarfBuzzShaper::setGlyphPositionsForHarfBuzzRun(HarfBuzzRun* currentRun, hb_buffer_t* harfBuzzBuffer)
+void HarfBuzzShaper::setGlyphPositionsForHarfBuzzRun(HarfBuzzRun* currentRun, const hb_glyph_info_t* glyphInfos, const hb_glyph_position_t* glyphPositions)
 {
     const Font* currentFontData = currentRun->fontData();
-    hb_glyph_info_t* glyphInfos = hb_buffer_get_glyph_infos(harfBuzzBuffer, 0);
-    hb_glyph_position_t* glyphPositions = hb_buffer_get_glyph_positions(harfBuzzBuffer, 0);
 
     unsigned numGlyphs = currentRun->numGlyphs();
     uint16_t* glyphToCharacterIndexes = currentRun->glyphToCharacterIndexes();
@@ -201,8 +201,11 @@ class JPEGImageReader {
 public:
     JPEGImageReader(JPEGImageDecoder* decoder)
         : m_decoder(decoder)
-        , m_bufferLength(0)
-        , m_bytesToSkip(0)
+        , m_data(nullptr)
+        , m_nextReadPosition(0)
+        , m_restartPosition(0)
+        , m_lastSetByte(nullptr)
+        , m_needsRestart(false)
         , m_state(JPEG_HEADER)
         , m_samples(0)
     {
@@ -260,29 +263,66 @@ public:
 
     void skipBytes(long numBytes)
     {
-        decoder_source_mgr* src = (decoder_source_mgr*)m_info.src;
-        long bytesToSkip = std::min(numBytes, (long)src->pub.bytes_in_buffer);
-        src->pub.bytes_in_buffer -= (size_t)bytesToSkip;
-        src->pub.next_input_byte += bytesToSkip;
+        if (numBytes <= 0)
+            return;
+
+        size_t bytesToSkip = static_cast<size_t>(numBytes);
+        if (bytesToSkip < m_info.src->bytes_in_buffer) {
+            // The next byte needed is in the current segment.
+            m_info.src->bytes_in_buffer -= bytesToSkip;
+            m_info.src->next_input_byte += bytesToSkip;
+        } else {
+            // Move past the current segment, the bytes may not have been received yet.
+            m_nextReadPosition += bytesToSkip - m_info.src->bytes_in_buffer;
+            m_info.src->bytes_in_buffer = 0;
+            m_info.src->next_input_byte = nullptr;
+        }
 
-        m_bytesToSkip = std::max(numBytes - bytesToSkip, static_cast<long>(0));
+        // libjpeg never backs up over skipped data, so this is a valid restart position.
+        m_restartPosition = m_nextReadPosition - m_info.src->bytes_in_buffer;
+        m_lastSetByte = m_info.src->next_input_byte;
     }
 
-    bool decode(const SharedBuffer& data, bool onlySize)
+    // The encoded data is handed to libjpeg one SharedBuffer segment at a time so that
+    // it never needs to be combined into a single segment.
+    bool fillBuffer()
     {
-        m_decodingSizeOnly = onlySize;
-
-        unsigned newByteCount = data.size() - m_bufferLength;
-        unsigned readOffset = m_bufferLength - m_info.src->bytes_in_buffer;
+        if (m_needsRestart) {
+            m_needsRestart = false;
+            m_nextReadPosition = m_restartPosition;
+        } else
+            updateRestartPosition();
+
+        const char* segment;
+        unsigned bytes = m_data->getSomeData(segment, m_nextReadPosition);
+        if (!bytes) {
+            // libjpeg suspends and discards what it read since its last synchronization
+            // point, so reading has to resume from there once more data is available.
+            m_needsRestart = true;
+            clearBuffer();
+            return false;
+        }
 
-        m_info.src->bytes_in_buffer += newByteCount;
-        m_info.src->next_input_byte = (JOCTET*)(data.data()) + readOffset;
+        m_nextReadPosition += bytes;
+        m_info.src->bytes_in_buffer = bytes;
+        m_info.src->next_input_byte = reinterpret_cast<const JOCTET*>(segment);
+        m_lastSetByte = m_info.src->next_input_byte;
+        return true;
+    }
 
-        // If we still have bytes to skip, try to skip those now.
-        if (m_bytesToSkip)
-            skipBytes(m_bytesToSkip);
+    bool decode(const SharedBuffer& data, bool onlySize)
+    {
+        m_decodingSizeOnly = onlySize;
 
-        m_bufferLength = data.size();
+        // The segment handed to libjpeg during the previous call may be gone by now, e.g. if
+        // the buffer was combined into one segment. Read it again from the same position,
+        // unless libjpeg suspended, in which case fillBuffer() goes back to the restart position.
+        m_data = &data;
+        if (!m_needsRestart) {
+            m_nextReadPosition -= m_info.src->bytes_in_buffer;
+            m_restartPosition = m_nextReadPosition;
+            clearBuffer();
+        }
 
         // We need to do the setjmp here. Otherwise bad things will happen
         if (setjmp(m_err.setjmp_buffer))
@@ -348,12 +388,9 @@ public:
             // buffer. Remove this allocation for those color spaces.
             m_samples = (*m_info.mem->alloc_sarray)((j_common_ptr) &m_info, JPOOL_IMAGE, m_info.output_width * 4, 1);
 
-            if (m_decodingSizeOnly) {
-                // We can stop here. Reduce our buffer length and available data.
-                m_bufferLength -= m_info.src->bytes_in_buffer;
-                m_info.src->bytes_in_buffer = 0;
+            // We can stop here, the next call resumes reading where the header ended.
+            if (m_decodingSizeOnly)
                 return true;
-            }
         // FALL THROUGH
 
         case JPEG_START_DECOMPRESS:
@@ -457,9 +494,28 @@ public:
     JPEGImageDecoder* decoder() { return m_decoder; }
 
 private:
+    void updateRestartPosition()
+    {
+        // libjpeg moved next_input_byte since we set it, which means it reached a point it
+        // can resume from after a suspension.
+        if (m_lastSetByte != m_info.src->next_input_byte)
+            m_restartPosition = m_nextReadPosition - m_info.src->bytes_in_buffer;
+    }
+
+    void clearBuffer()
+    {
+        // Makes libjpeg ask for more data through fill_input_buffer().
+        m_info.src->bytes_in_buffer = 0;
+        m_info.src->next_input_byte = nullptr;
+        m_lastSetByte = nullptr;
+    }
+
     JPEGImageDecoder* m_decoder;
-    unsigned m_bufferLength;
-    int m_bytesToSkip;
+    const SharedBuffer* m_data;
+    unsigned m_nextReadPosition;
+    unsigned m_restartPosition;
+    const JOCTET* m_lastSetByte;
+    bool m_needsRestart;
     bool m_decodingSizeOnly;
 
     jpeg_decompress_struct m_info;
@@ -487,12 +543,11 @@ void skip_input_data(j_decompress_ptr jd, long num_bytes)
     src->decoder->skipBytes(num_bytes);
 }
 
-boolean fill_input_buffer(j_decompress_ptr)
+boolean fill_input_buffer(j_decompress_ptr jd)
 {
-    // Our decode step always sets things up properly, so if this method is ever
-    // called, then we have hit the end of the buffer.  A return value of false
-    // indicates that we have no data to supply yet.
-    return FALSE;
+    // A return value of false indicates that we have no data to supply yet.
+    decoder_source_mgr *src = (decoder_source_mgr *)jd->src;
+    return src->decoder->fillBuffer();
 }
 
 void term_source(j_decompress_ptr jd)
@@ -35,6 +35,7 @@
 #include "Logging.h"
 #include "ResourceHandle.h"
 #include "SoupNetworkProxySettings.h"
+#include "WebKitCachingResolver.h"
 #include <glib/gstdio.h>
 #include <libsoup/soup.h>
 #include <pal/crypto/CryptoDigest.h>
@@ -125,6 +126,9 @@ SoupNetworkSession::SoupNetworkSession(SoupCookieJar* cookieJar)
     static const int maxConnections = 17;
     static const int maxConnectionsPerHost = 6;
 
+    // Share host name lookups between all the connections and DNS prefetches of the process.
+    webkitCachingResolverInstallAsDefault();
+
     GRefPtr<SoupCookieJar> jar = cookieJar;
     if (!jar) {
         jar = adoptGRef(soup_cookie_jar_new());
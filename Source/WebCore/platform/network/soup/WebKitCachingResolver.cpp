@@ -0,0 +1,482 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "config.h"
+#include "WebKitCachingResolver.h"
+
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/MonotonicTime.h>
+#include <wtf/Vector.h>
+#include <wtf/glib/GRefPtr.h>
+#include <wtf/glib/GUniquePtr.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/StringHash.h>
+
+// getaddrinfo() doesn't report the TTL of the records, so use the lifetime other browsers use for
+// results of the system resolver.
+static const Seconds positiveEntryLifetime = 1_min;
+static const Seconds negativeEntryLifetime = 10_s;
+
+// Expired addresses are still used for this long, while a new lookup refreshes them in the background.
+static const Seconds staleEntryLifetime = 10_min;
+
+static const unsigned maximumEntryCount = 256;
+
+// Restricting the address family changes the answer, so lookups are keyed by their
+// GResolverNameLookupFlags too. Plain lookups use the default flags, 0.
+typedef std::pair<String, unsigned> LookupKey;
+
+struct CachedLookup {
+    Vector<GRefPtr<GInetAddress>> addresses;
+    String errorMessage; // Only set for negative entries, which have no addresses.
+    MonotonicTime expirationTime;
+};
+
+struct _WebKitCachingResolverPrivate {
+    GRefPtr<GResolver> resolver;
+
+    Lock lock;
+    HashMap<LookupKey, CachedLookup> cache;
+    // Lookups in progress in the wrapped resolver, with the tasks waiting for them. Revalidations
+    // of stale entries have no waiting tasks.
+    struct PendingTask {
+        GRefPtr<GTask> task;
+        gulong cancelledHandlerID { 0 };
+    };
+    HashMap<LookupKey, Vector<PendingTask>> pendingLookups;
+    Seconds timeOffset;
+};
+
+G_DEFINE_TYPE(WebKitCachingResolver, webkit_caching_resolver, G_TYPE_RESOLVER)
+
+static void webkitCachingResolverFinalize(GObject* object)
+{
+    WEBKIT_CACHING_RESOLVER(object)->priv->~WebKitCachingResolverPrivate();
+    G_OBJECT_CLASS(webkit_caching_resolver_parent_class)->finalize(object);
+}
+
+static void webkit_caching_resolver_init(WebKitCachingResolver* resolver)
+{
+    WebKitCachingResolverPrivate* priv = G_TYPE_INSTANCE_GET_PRIVATE(resolver, WEBKIT_TYPE_CACHING_RESOLVER, WebKitCachingResolverPrivate);
+    resolver->priv = priv;
+    new (priv) WebKitCachingResolverPrivate();
+}
+
+// Must be called with the lock held.
+static MonotonicTime currentTime(const WebKitCachingResolverPrivate& priv)
+{
+    return MonotonicTime::now() + priv.timeOffset;
+}
+
+static GList* addressListForCachedLookup(const CachedLookup& lookup)
+{
+    GList* addresses = nullptr;
+    for (auto it = lookup.addresses.rbegin(); it != lookup.addresses.rend(); ++it)
+        addresses = g_list_prepend(addresses, g_object_ref(it->get()));
+    return addresses;
+}
+
+static bool isUsable(const CachedLookup& lookup, MonotonicTime now)
+{
+    if (lookup.expirationTime > now)
+        return true;
+    return !lookup.addresses.isEmpty() && lookup.expirationTime + staleEntryLifetime > now;
+}
+
+// Must be called with the lock held.
+static void cacheLookupResult(WebKitCachingResolverPrivate& priv, const LookupKey& key, GList* addresses, const GError* error)
+{
+    // Only cache answers: cancellations and temporary failures say nothing about the host.
+    if (error && !g_error_matches(error, G_RESOLVER_ERROR, G_RESOLVER_ERROR_NOT_FOUND))
+        return;
+
+    auto now = currentTime(priv);
+    if (priv.cache.size() >= maximumEntryCount && !priv.cache.contains(key)) {
+        auto oldest = priv.cache.begin();
+        for (auto it = priv.cache.begin(); it != priv.cache.end(); ++it) {
+            if (it->value.expirationTime < oldest->value.expirationTime)
+                oldest = it;
+        }
+        priv.cache.remove(oldest);
+    }
+
+    CachedLookup lookup;
+    if (error) {
+        lookup.errorMessage = String::fromUTF8(error->message);
+        lookup.expirationTime = now + negativeEntryLifetime;
+    } else {
+        for (GList* item = addresses; item; item = g_list_next(item))
+            lookup.addresses.append(G_INET_ADDRESS(item->data));
+        lookup.expirationTime = now + positiveEntryLifetime;
+    }
+    priv.cache.set(key, WTFMove(lookup));
+}
+
+static GList* lookupByNameInWrappedResolver(GResolver* resolver, const char* hostname, unsigned flags, GCancellable* cancellable, GError** error)
+{
+#if GLIB_CHECK_VERSION(2, 59, 0)
+    if (flags != G_RESOLVER_NAME_LOOKUP_FLAGS_DEFAULT)
+        return g_resolver_lookup_by_name_with_flags(resolver, hostname, static_cast<GResolverNameLookupFlags>(flags), cancellable, error);
+#endif
+    ASSERT(!flags);
+    return g_resolver_lookup_by_name(resolver, hostname, cancellable, error);
+}
+
+static void lookupByNameInWrappedResolverAsync(GResolver* resolver, const char* hostname, unsigned flags, GAsyncReadyCallback callback, gpointer userData)
+{
+#if GLIB_CHECK_VERSION(2, 59, 0)
+    if (flags != G_RESOLVER_NAME_LOOKUP_FLAGS_DEFAULT) {
+        g_resolver_lookup_by_name_with_flags_async(resolver, hostname, static_cast<GResolverNameLookupFlags>(flags), nullptr, callback, userData);
+        return;
+    }
+#endif
+    ASSERT(!flags);
+    g_resolver_lookup_by_name_async(resolver, hostname, nullptr, callback, userData);
+}
+
+static GList* lookupByNameInWrappedResolverFinish(GResolver* resolver, unsigned flags, GAsyncResult* result, GError** error)
+{
+#if GLIB_CHECK_VERSION(2, 59, 0)
+    if (flags != G_RESOLVER_NAME_LOOKUP_FLAGS_DEFAULT)
+        return g_resolver_lookup_by_name_with_flags_finish(resolver, result, error);
+#endif
+    ASSERT(!flags);
+    return g_resolver_lookup_by_name_finish(resolver, result, error);
+}
+
+static GList* lookupByName(GResolver* resolver, const char* hostname, unsigned flags, GCancellable* cancellable, GError** error)
+{
+    auto& priv = *WEBKIT_CACHING_RESOLVER(resolver)->priv;
+    LookupKey key(String::fromUTF8(hostname), flags);
+    {
+        LockHolder locker(priv.lock);
+        // Synchronous callers might not run a main loop to complete a background revalidation,
+        // so they only get fresh entries.
+        auto it = priv.cache.find(key);
+        if (it != priv.cache.end() && it->value.expirationTime > currentTime(priv)) {
+            if (!it->value.addresses.isEmpty())
+                return addressListForCachedLookup(it->value);
+            g_set_error_literal(error, G_RESOLVER_ERROR, G_RESOLVER_ERROR_NOT_FOUND, it->value.errorMessage.utf8().data());
+            return nullptr;
+        }
+    }
+
+    GUniqueOutPtr<GError> lookupError;
+    GList* addresses = lookupByNameInWrappedResolver(priv.resolver.get(), hostname, flags, cancellable, &lookupError.outPtr());
+    {
+        LockHolder locker(priv.lock);
+        cacheLookupResult(priv, key, addresses, lookupError.get());
+    }
+    if (lookupError)
+        g_propagate_error(error, lookupError.release());
+    return addresses;
+}
+
+static GList* webkitCachingResolverLookupByName(GResolver* resolver, const char* hostname, GCancellable* cancellable, GError** error)
+{
+    return lookupByName(resolver, hostname, 0, cancellable, error);
+}
+
+struct PendingLookupContext {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    GRefPtr<WebKitCachingResolver> resolver;
+    LookupKey key;
+};
+
+static void lookupFinishedCallback(GObject* source, GAsyncResult* result, gpointer userData)
+{
+    std::unique_ptr<PendingLookupContext> context(static_cast<PendingLookupContext*>(userData));
+    auto& priv = *context->resolver->priv;
+
+    GUniqueOutPtr<GError> error;
+    GList* addresses = lookupByNameInWrappedResolverFinish(G_RESOLVER(source), context->key.second, result, &error.outPtr());
+
+    Vector<WebKitCachingResolverPrivate::PendingTask> tasks;
+    {
+        LockHolder locker(priv.lock);
+        cacheLookupResult(priv, context->key, addresses, error.get());
+        tasks = priv.pendingLookups.take(context->key);
+    }
+
+    for (auto& pendingTask : tasks) {
+        GTask* task = pendingTask.task.get();
+        if (pendingTask.cancelledHandlerID)
+            g_cancellable_disconnect(g_task_get_cancellable(task), pendingTask.cancelledHandlerID);
+        // Tasks cancelled after they were taken from the pending lookups are completed here.
+        if (g_task_return_error_if_cancelled(task))
+            continue;
+        if (error)
+            g_task_return_error(task, g_error_copy(error.get()));
+        else
+            g_task_return_pointer(task, g_list_copy_deep(addresses, reinterpret_cast<GCopyFunc>(g_object_ref), nullptr), reinterpret_cast<GDestroyNotify>(g_resolver_free_addresses));
+    }
+
+    g_resolver_free_addresses(addresses);
+}
+
+// Must be called with the lock held.
+static void startLookupIfNeeded(WebKitCachingResolver* resolver, const LookupKey& key, GRefPtr<GTask>&& task)
+{
+    auto& priv = *resolver->priv;
+    auto addResult = priv.pendingLookups.add(key, Vector<WebKitCachingResolverPrivate::PendingTask>());
+    if (task)
+        addResult.iterator->value.append({ WTFMove(task), 0 });
+    if (!addResult.isNewEntry)
+        return;
+
+    auto* context = new PendingLookupContext { resolver, key };
+    lookupByNameInWrappedResolverAsync(priv.resolver.get(), key.first.utf8().data(), key.second, lookupFinishedCallback, context);
+}
+
+struct CancelledLookupContext {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    GRefPtr<WebKitCachingResolver> resolver;
+    LookupKey key;
+    GTask* task; // Only used to find the task in the pending lookups.
+};
+
+static void lookupCancelledCallback(GCancellable*, CancelledLookupContext* context)
+{
+    auto& priv = *context->resolver->priv;
+    GRefPtr<GTask> task;
+    {
+        LockHolder locker(priv.lock);
+        auto it = priv.pendingLookups.find(context->key);
+        if (it == priv.pendingLookups.end())
+            return;
+        size_t index = it->value.findMatching([context](auto& pendingTask) {
+            return pendingTask.task.get() == context->task;
+        });
+        if (index == notFound)
+            return;
+        task = WTFMove(it->value[index].task);
+        it->value.remove(index);
+    }
+
+    // The shared lookup goes on for the other tasks and the cache, but the cancelled task doesn't
+    // wait for it. It's completed from its own main context rather than from the cancellable handler.
+    GRefPtr<GSource> source = adoptGRef(g_idle_source_new());
+    g_task_attach_source(task.get(), source.get(), [](gpointer userData) -> gboolean {
+        g_task_return_error_if_cancelled(G_TASK(userData));
+        return G_SOURCE_REMOVE;
+    });
+}
+
+static void watchPendingTaskCancellation(WebKitCachingResolver* resolver, const LookupKey& key, GTask* task, GCancellable* cancellable)
+{
+    // Not called with the lock held, since the handler runs right away if the task was cancelled in the meantime.
+    auto* context = new CancelledLookupContext { resolver, key, task };
+    gulong handlerID = g_cancellable_connect(cancellable, G_CALLBACK(lookupCancelledCallback), context, [](gpointer data) {
+        delete static_cast<CancelledLookupContext*>(data);
+    });
+    if (!handlerID)
+        return;
+
+    auto& priv = *resolver->priv;
+    bool isPending = false;
+    {
+        LockHolder locker(priv.lock);
+        auto it = priv.pendingLookups.find(key);
+        if (it != priv.pendingLookups.end()) {
+            for (auto& pendingTask : it->value) {
+                if (pendingTask.task.get() == task) {
+                    pendingTask.cancelledHandlerID = handlerID;
+                    isPending = true;
+                    break;
+                }
+            }
+        }
+    }
+    if (!isPending)
+        g_cancellable_disconnect(cancellable, handlerID);
+}
+
+static void lookupByNameAsync(GResolver* resolver, const char* hostname, unsigned flags, GCancellable* cancellable, GAsyncReadyCallback callback, gpointer userData)
+{
+    auto* cachingResolver = WEBKIT_CACHING_RESOLVER(resolver);
+    auto& priv = *cachingResolver->priv;
+    GRefPtr<GTask> task = adoptGRef(g_task_new(resolver, cancellable, callback, userData));
+    if (g_task_return_error_if_cancelled(task.get()))
+        return;
+
+    LookupKey key(String::fromUTF8(hostname), flags);
+    GList* addresses = nullptr;
+    CString errorMessage;
+    {
+        LockHolder locker(priv.lock);
+        auto now = currentTime(priv);
+        auto it = priv.cache.find(key);
+        if (it == priv.cache.end() || !isUsable(it->value, now)) {
+            GTask* pendingTask = task.get();
+            startLookupIfNeeded(cachingResolver, key, WTFMove(task));
+            locker.unlockEarly();
+            if (cancellable)
+                watchPendingTaskCancellation(cachingResolver, key, pendingTask, cancellable);
+            return;
+        }
+
+        if (it->value.addresses.isEmpty())
+            errorMessage = it->value.errorMessage.utf8();
+        else
+            addresses = addressListForCachedLookup(it->value);
+
+        if (it->value.expirationTime <= now)
+            startLookupIfNeeded(cachingResolver, key, nullptr);
+    }
+
+    // Complete the task out of the lock, in case it's dispatched synchronously.
+    if (addresses)
+        g_task_return_pointer(task.get(), addresses, reinterpret_cast<GDestroyNotify>(g_resolver_free_addresses));
+    else
+        g_task_return_new_error(task.get(), G_RESOLVER_ERROR, G_RESOLVER_ERROR_NOT_FOUND, "%s", errorMessage.data());
+}
+
+static void webkitCachingResolverLookupByNameAsync(GResolver* resolver, const char* hostname, GCancellable* cancellable, GAsyncReadyCallback callback, gpointer userData)
+{
+    lookupByNameAsync(resolver, hostname, 0, cancellable, callback, userData);
+}
+
+static GList* webkitCachingResolverLookupByNameFinish(GResolver* resolver, GAsyncResult* result, GError** error)
+{
+    g_return_val_if_fail(g_task_is_valid(result, resolver), nullptr);
+    return static_cast<GList*>(g_task_propagate_pointer(G_TASK(result), error));
+}
+
+#if GLIB_CHECK_VERSION(2, 59, 0)
+// GNetworkAddress looks up IPv4 and IPv6 addresses separately with these since GLib 2.60, and
+// GResolver fails lookups with non-default flags when a subclass doesn't implement them.
+static GList* webkitCachingResolverLookupByNameWithFlags(GResolver* resolver, const char* hostname, GResolverNameLookupFlags flags, GCancellable* cancellable, GError** error)
+{
+    return lookupByName(resolver, hostname, flags, cancellable, error);
+}
+
+static void webkitCachingResolverLookupByNameWithFlagsAsync(GResolver* resolver, const char* hostname, GResolverNameLookupFlags flags, GCancellable* cancellable, GAsyncReadyCallback callback, gpointer userData)
+{
+    lookupByNameAsync(resolver, hostname, flags, cancellable, callback, userData);
+}
+
+static GList* webkitCachingResolverLookupByNameWithFlagsFinish(GResolver* resolver, GAsyncResult* result, GError** error)
+{
+    return webkitCachingResolverLookupByNameFinish(resolver, result, error);
+}
+#endif
+
+// Reverse and record lookups are not cached, they are just forwarded to the wrapped resolver.
+static char* webkitCachingResolverLookupByAddress(GResolver* resolver, GInetAddress* address, GCancellable* cancellable, GError** error)
+{
+    return g_resolver_lookup_by_address(WEBKIT_CACHING_RESOLVER(resolver)->priv->resolver.get(), address, cancellable, error);
+}
+
+static void webkitCachingResolverLookupByAddressAsync(GResolver* resolver, GInetAddress* address, GCancellable* cancellable, GAsyncReadyCallback callback, gpointer userData)
+{
+    g_resolver_lookup_by_address_async(WEBKIT_CACHING_RESOLVER(resolver)->priv->resolver.get(), address, cancellable, callback, userData);
+}
+
+static char* webkitCachingResolverLookupByAddressFinish(GResolver* resolver, GAsyncResult* result, GError** error)
+{
+    return g_resolver_lookup_by_address_finish(WEBKIT_CACHING_RESOLVER(resolver)->priv->resolver.get(), result, error);
+}
+
+static GList* webkitCachingResolverLookupRecords(GResolver* resolver, const char* rrname, GResolverRecordType type, GCancellable* cancellable, GError** error)
+{
+    return g_resolver_lookup_records(WEBKIT_CACHING_RESOLVER(resolver)->priv->resolver.get(), rrname, type, cancellable, error);
+}
+
+static void webkitCachingResolverLookupRecordsAsync(GResolver* resolver, const char* rrname, GResolverRecordType type, GCancellable* cancellable, GAsyncReadyCallback callback, gpointer userData)
+{
+    g_resolver_lookup_records_async(WEBKIT_CACHING_RESOLVER(resolver)->priv->resolver.get(), rrname, type, cancellable, callback, userData);
+}
+
+static GList* webkitCachingResolverLookupRecordsFinish(GResolver* resolver, GAsyncResult* result, GError** error)
+{
+    return g_resolver_lookup_records_finish(WEBKIT_CACHING_RESOLVER(resolver)->priv->resolver.get(), result, error);
+}
+
+static void webkit_caching_resolver_class_init(WebKitCachingResolverClass* cachingResolverClass)
+{
+    GObjectClass* gObjectClass = G_OBJECT_CLASS(cachingResolverClass);
+    gObjectClass->finalize = webkitCachingResolverFinalize;
+
+    GResolverClass* resolverClass = G_RESOLVER_CLASS(cachingResolverClass);
+    resolverClass->lookup_by_name = webkitCachingResolverLookupByName;
+    resolverClass->lookup_by_name_async = webkitCachingResolverLookupByNameAsync;
+    resolverClass->lookup_by_name_finish = webkitCachingResolverLookupByNameFinish;
+#if GLIB_CHECK_VERSION(2, 59, 0)
+    resolverClass->lookup_by_name_with_flags = webkitCachingResolverLookupByNameWithFlags;
+    resolverClass->lookup_by_name_with_flags_async = webkitCachingResolverLookupByNameWithFlagsAsync;
+    resolverClass->lookup_by_name_with_flags_finish = webkitCachingResolverLookupByNameWithFlagsFinish;
+#endif
+    resolverClass->lookup_by_address = webkitCachingResolverLookupByAddress;
+    resolverClass->lookup_by_address_async = webkitCachingResolverLookupByAddressAsync;
+    resolverClass->lookup_by_address_finish = webkitCachingResolverLookupByAddressFinish;
+    resolverClass->lookup_records = webkitCachingResolverLookupRecords;
+    resolverClass->lookup_records_async = webkitCachingResolverLookupRecordsAsync;
+    resolverClass->lookup_records_finish = webkitCachingResolverLookupRecordsFinish;
+
+    g_type_class_add_private(cachingResolverClass, sizeof(WebKitCachingResolverPrivate));
+}
+
+static void clearCache(WebKitCachingResolver* resolver)
+{
+    LockHolder locker(resolver->priv->lock);
+    resolver->priv->cache.clear();
+}
+
+static void networkChangedCallback(GNetworkMonitor*, gboolean, WebKitCachingResolver* resolver)
+{
+    clearCache(resolver);
+}
+
+static void resolverReloadCallback(GResolver*, WebKitCachingResolver* resolver)
+{
+    clearCache(resolver);
+}
+
+GResolver* webkitCachingResolverNew(GResolver* wrappedResolver)
+{
+    auto* cachingResolver = WEBKIT_CACHING_RESOLVER(g_object_new(WEBKIT_TYPE_CACHING_RESOLVER, nullptr));
+    cachingResolver->priv->resolver = wrappedResolver;
+
+    // Cached addresses are likely wrong after switching networks or DNS servers.
+    g_signal_connect_object(g_network_monitor_get_default(), "network-changed", G_CALLBACK(networkChangedCallback), cachingResolver, static_cast<GConnectFlags>(0));
+    g_signal_connect_object(wrappedResolver, "reload", G_CALLBACK(resolverReloadCallback), cachingResolver, static_cast<GConnectFlags>(0));
+
+    return G_RESOLVER(cachingResolver);
+}
+
+void webkitCachingResolverInstallAsDefault()
+{
+    static bool isInstalled = false;
+    if (isInstalled)
+        return;
+    isInstalled = true;
+
+    GRefPtr<GResolver> defaultResolver = adoptGRef(g_resolver_get_default());
+    GRefPtr<GResolver> resolver = adoptGRef(webkitCachingResolverNew(defaultResolver.get()));
+    g_resolver_set_default(resolver.get());
+}
+
+void webkitCachingResolverAdvanceTimeForTesting(WebKitCachingResolver* resolver, Seconds delta)
+{
+    LockHolder locker(resolver->priv->lock);
+    resolver->priv->timeOffset += delta;
+}
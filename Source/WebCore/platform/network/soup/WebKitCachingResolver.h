@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#include <gio/gio.h>
+#include <wtf/Seconds.h>
+
+G_BEGIN_DECLS
+
+#define WEBKIT_TYPE_CACHING_RESOLVER            (webkit_caching_resolver_get_type())
+#define WEBKIT_CACHING_RESOLVER(object)         (G_TYPE_CHECK_INSTANCE_CAST((object), WEBKIT_TYPE_CACHING_RESOLVER, WebKitCachingResolver))
+#define WEBKIT_IS_CACHING_RESOLVER(object)      (G_TYPE_CHECK_INSTANCE_TYPE((object), WEBKIT_TYPE_CACHING_RESOLVER))
+#define WEBKIT_CACHING_RESOLVER_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST((klass), WEBKIT_TYPE_CACHING_RESOLVER, WebKitCachingResolverClass))
+#define WEBKIT_IS_CACHING_RESOLVER_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass), WEBKIT_TYPE_CACHING_RESOLVER))
+#define WEBKIT_CACHING_RESOLVER_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS((obj), WEBKIT_TYPE_CACHING_RESOLVER, WebKitCachingResolverClass))
+
+typedef struct _WebKitCachingResolver WebKitCachingResolver;
+typedef struct _WebKitCachingResolverClass WebKitCachingResolverClass;
+typedef struct _WebKitCachingResolverPrivate WebKitCachingResolverPrivate;
+
+struct _WebKitCachingResolver {
+    GResolver parent;
+
+    WebKitCachingResolverPrivate* priv;
+};
+
+struct _WebKitCachingResolverClass {
+    GResolverClass parent;
+};
+
+GType webkit_caching_resolver_get_type();
+
+// Returns a new caching resolver forwarding the lookups it can't answer to the given resolver.
+GResolver* webkitCachingResolverNew(GResolver*);
+
+// Replaces the default GResolver of the process, used by libsoup for every connection and DNS
+// prefetch, with one that caches host name lookups on top of it. Does nothing after the first call.
+void webkitCachingResolverInstallAsDefault();
+
+G_END_DECLS
+
+// Makes the cache behave as if the given time had passed, so that tests don't have to wait for entries to expire.
+void webkitCachingResolverAdvanceTimeForTesting(WebKitCachingResolver*, Seconds);
@@ -26,9 +26,11 @@
 #include "config.h"
 #include "GridTrackSizingAlgorithm.h"
 
+#include "FrameView.h"
 #include "Grid.h"
 #include "GridArea.h"
 #include "RenderGrid.h"
+#include "RenderView.h"
 
 namespace WebCore {
 
@@ -731,8 +733,11 @@ LayoutUnit GridTrackSizingAlgorithmStrategy::logicalHeightForChild(RenderBox& ch
     }
 
     // We need to clear the stretched height to properly compute logical height during layout.
-    if (child.needsLayout())
+    if (child.needsLayout()) {
         child.clearOverrideLogicalContentHeight();
+        child.view().frameView().didMeasureItemWithLayout();
+    } else
+        child.view().frameView().didReuseItemMeasurement();
 
     child.layoutIfNeeded();
     return child.logicalHeight() + child.marginLogicalHeight();
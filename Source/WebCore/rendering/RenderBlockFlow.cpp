@@ -51,6 +51,7 @@
 #include "RenderText.h"
 #include "RenderView.h"
 #include "Settings.h"
+#include "SimpleLineLayoutCoverage.h"
 #include "SimpleLineLayoutFunctions.h"
 #include "SimpleLineLayoutPagination.h"
 #include "VerticalPositionCache.h"
@@ -696,8 +697,11 @@ void RenderBlockFlow::layoutBlockChildren(bool relayoutChildren, LayoutUnit& max
 
 void RenderBlockFlow::layoutInlineChildren(bool relayoutChildren, LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom)
 {
-    if (lineLayoutPath() == UndeterminedPath)
-        setLineLayoutPath(SimpleLineLayout::canUseFor(*this) ? SimpleLinesPath : LineBoxesPath);
+    if (lineLayoutPath() == UndeterminedPath) {
+        bool canUseSimpleLines = SimpleLineLayout::canUseFor(*this);
+        SimpleLineLayout::recordLineLayoutPath(*this, canUseSimpleLines);
+        setLineLayoutPath(canUseSimpleLines ? SimpleLinesPath : LineBoxesPath);
+    }
 
     if (lineLayoutPath() == SimpleLinesPath) {
         layoutSimpleLines(relayoutChildren, repaintLogicalTop, repaintLogicalBottom);
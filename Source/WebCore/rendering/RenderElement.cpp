@@ -593,6 +593,9 @@ void RenderElement::removeChildInternal(RenderObject& oldChild, NotifyChildrenTy
     
     if (!renderTreeBeingDestroyed() && is<RenderFlexibleBox>(this) && !oldChild.isFloatingOrOutOfFlowPositioned() && oldChild.isBox())
         downcast<RenderFlexibleBox>(this)->clearCachedChildIntrinsicContentLogicalHeight(downcast<RenderBox>(oldChild));
+    // The flexbox outlives the child, so don't leave a dangling pointer to it in its caches.
+    if (!renderTreeBeingDestroyed() && is<RenderFlexibleBox>(this) && oldChild.isBox())
+        downcast<RenderFlexibleBox>(this)->clearCachedMainSizeForChild(downcast<RenderBox>(oldChild));
 
     // If oldChild is the start or end of the selection, then clear the selection to
     // avoid problems of invalid pointers.
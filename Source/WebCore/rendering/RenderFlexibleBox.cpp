@@ -32,6 +32,7 @@
 #include "RenderFlexibleBox.h"
 
 #include "FlexibleBoxAlgorithm.h"
+#include "FrameView.h"
 #include "LayoutRepainter.h"
 #include "RenderLayer.h"
 #include "RenderView.h"
@@ -793,6 +794,26 @@ void RenderFlexibleBox::cacheChildMainSize(const RenderBox& child)
 void RenderFlexibleBox::clearCachedMainSizeForChild(const RenderBox& child)
 {
     m_intrinsicSizeAlongMainAxis.remove(&child);
+    m_availableLogicalWidthAtLastChildLayout.remove(&child);
+}
+
+bool RenderFlexibleBox::canReuseChildLayout(const RenderBox& child) const
+{
+    if (!settings().flexLayoutCacheEnabled())
+        return false;
+
+    if (child.needsLayout() || child.hasRelativeLogicalHeight() || child.needsPreferredWidthsRecalculation())
+        return false;
+
+    auto it = m_availableLogicalWidthAtLastChildLayout.find(&child);
+    return it != m_availableLogicalWidthAtLastChildLayout.end() && it->value == child.containingBlockLogicalWidthForContent();
+}
+
+void RenderFlexibleBox::didLayoutChild(const RenderBox& child)
+{
+    if (!settings().flexLayoutCacheEnabled())
+        return;
+    m_availableLogicalWidthAtLastChildLayout.set(&child, child.containingBlockLogicalWidthForContent());
 }
 
     
@@ -809,13 +830,21 @@ LayoutUnit RenderFlexibleBox::computeInnerFlexBaseSizeForChild(RenderBox& child,
     // width; for the height we need to lay out the child.
     LayoutUnit mainAxisExtent;
     if (hasOrthogonalFlow(child)) {
+        // Forcing the relayout of our children doesn't change the measurement of a clean child that
+        // still sees the same available width. Skipping it keeps nested column flexboxes from
+        // re-measuring their whole subtree once per ancestor.
+        if (relayoutChildren && m_intrinsicSizeAlongMainAxis.contains(&child) && canReuseChildLayout(child))
+            relayoutChildren = false;
         updateBlockChildDirtyBitsBeforeLayout(relayoutChildren, child);
         if (child.needsLayout() || relayoutChildren || !m_intrinsicSizeAlongMainAxis.contains(&child)) {
             if (!child.needsLayout())
                 child.setChildNeedsLayout(MarkOnlyThis);
             child.layoutIfNeeded();
             cacheChildMainSize(child);
-        }
+            didLayoutChild(child);
+            view().frameView().didMeasureItemWithLayout();
+        } else
+            view().frameView().didReuseItemMeasurement();
         mainAxisExtent = m_intrinsicSizeAlongMainAxis.get(&child);
     } else {
         // We don't need to add scrollbarLogicalWidth here because the preferred
@@ -1176,6 +1205,8 @@ FlexItem RenderFlexibleBox::constructFlexItem(RenderBox& child, bool relayoutChi
         child.setChildNeedsLayout(MarkOnlyThis);
         child.layoutIfNeeded();
         cacheChildMainSize(child);
+        didLayoutChild(child);
+        view().frameView().didMeasureItemWithLayout();
         relayoutChildren = false;
     }
     
@@ -1550,7 +1581,7 @@ void RenderFlexibleBox::layoutAndPlaceChildren(LayoutUnit& crossAxisOffset, Vect
         }
         // We may have already forced relayout for orthogonal flowing children in
         // computeInnerFlexBaseSizeForChild.
-        bool forceChildRelayout = relayoutChildren && !m_relaidOutChildren.contains(&child);
+        bool forceChildRelayout = relayoutChildren && !m_relaidOutChildren.contains(&child) && !canReuseChildLayout(child);
         if (child.isRenderBlock() && downcast<RenderBlock>(child).hasPercentHeightDescendants()) {
             // Have to force another relayout even though the child is sized
             // correctly, because its descendants are not sized correctly yet. Our
@@ -1564,6 +1595,7 @@ void RenderFlexibleBox::layoutAndPlaceChildren(LayoutUnit& crossAxisOffset, Vect
         if (child.needsLayout())
             m_relaidOutChildren.add(&child);
         child.layoutIfNeeded();
+        didLayoutChild(child);
 
         updateAutoMarginsInMainAxis(child, autoMarginOffset);
 
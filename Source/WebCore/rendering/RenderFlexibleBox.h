@@ -150,6 +150,8 @@ private:
     EOverflow mainAxisOverflowForChild(const RenderBox& child) const;
     EOverflow crossAxisOverflowForChild(const RenderBox& child) const;
     void cacheChildMainSize(const RenderBox& child);
+    bool canReuseChildLayout(const RenderBox& child) const;
+    void didLayoutChild(const RenderBox& child);
     
     void layoutFlexItems(bool relayoutChildren);
     LayoutUnit autoMarginOffsetInMainAxis(const Vector<FlexItem>&, LayoutUnit& availableFreeSpace);
@@ -189,6 +191,10 @@ private:
     // This is used to cache the preferred size for orthogonal flow children so we
     // don't have to relayout to get it
     HashMap<const RenderBox*, LayoutUnit> m_intrinsicSizeAlongMainAxis;
+
+    // The logical width that was available to each child when it was last laid out. A clean child
+    // that sees the same width would lay out the same way, so it doesn't need a forced relayout.
+    HashMap<const RenderBox*, LayoutUnit> m_availableLogicalWidthAtLastChildLayout;
     
     // This is used to cache the intrinsic size on the cross axis to avoid
     // relayouts when stretching.
@@ -29,15 +29,62 @@
 #include "Logging.h"
 #include "RenderBlockFlow.h"
 #include "RenderChildIterator.h"
+#include "RenderInline.h"
 #include "RenderStyle.h"
+#include "RenderText.h"
 #include "RenderView.h"
 #include "Settings.h"
 #include "SimpleLineLayout.h"
 #include "TextStream.h"
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
 
 namespace WebCore {
 namespace SimpleLineLayout {
 
+static CoverageStatistics& mutableCoverageStatistics()
+{
+    static NeverDestroyed<CoverageStatistics> statistics;
+    return statistics;
+}
+
+static uint64_t inlineTextLength(const RenderBlockFlow& flow)
+{
+    // Only count the text laid out in this flow's own lines. Inline-blocks, floats and other blocks inside it
+    // are flows of their own, and are recorded when they are laid out.
+    uint64_t textLength = 0;
+    for (auto* renderer = flow.firstChild(); renderer;) {
+        if (is<RenderText>(*renderer))
+            textLength += downcast<RenderText>(*renderer).textLength();
+        else if (is<RenderInline>(*renderer) && downcast<RenderInline>(*renderer).firstChild()) {
+            renderer = downcast<RenderInline>(*renderer).firstChild();
+            continue;
+        }
+        renderer = renderer->nextInPreOrderAfterChildren(&flow);
+    }
+    return textLength;
+}
+
+void recordLineLayoutPath(const RenderBlockFlow& flow, bool usesSimpleLines)
+{
+    ASSERT(isMainThread());
+    uint64_t textLength = inlineTextLength(flow);
+
+    auto& statistics = mutableCoverageStatistics();
+    if (usesSimpleLines) {
+        ++statistics.simpleLinesFlowCount;
+        statistics.simpleLinesTextLength += textLength;
+        return;
+    }
+    ++statistics.lineBoxesFlowCount;
+    statistics.lineBoxesTextLength += textLength;
+}
+
+CoverageStatistics coverageStatistics()
+{
+    return mutableCoverageStatistics();
+}
+
 #ifndef NDEBUG
 static void printReason(AvoidanceReason reason, TextStream& stream)
 {
@@ -132,9 +179,6 @@ static void printReason(AvoidanceReason reason, TextStream& stream)
     case FlowHasBorderFitLines:
         stream << "-webkit-border-fit";
         break;
-    case FlowHasNonAutoLineBreak:
-        stream << "line-break is not auto";
-        break;
     case FlowHasNonAutoTrailingWord:
         stream << "-apple-trailing-word is not auto";
         break;
@@ -171,9 +215,6 @@ static void printReason(AvoidanceReason reason, TextStream& stream)
     case FlowHasComplexFontCodePath:
         stream << "text with complex font codepath";
         break;
-    case FlowHasTextShadow:
-        stream << "text-shadow";
-        break;
     case FlowChildIsSelected:
         stream << "selected content";
         break;
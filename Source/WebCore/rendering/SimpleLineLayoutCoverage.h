@@ -26,8 +26,22 @@
 #pragma once
 
 namespace WebCore {
+
+class RenderBlockFlow;
+
 namespace SimpleLineLayout {
 
+struct CoverageStatistics {
+    uint64_t simpleLinesFlowCount { 0 };
+    uint64_t simpleLinesTextLength { 0 };
+    uint64_t lineBoxesFlowCount { 0 };
+    uint64_t lineBoxesTextLength { 0 };
+};
+
+// Process-wide tally of which line layout path flows end up on, available in release builds too.
+void recordLineLayoutPath(const RenderBlockFlow&, bool usesSimpleLines);
+WEBCORE_EXPORT CoverageStatistics coverageStatistics();
+
 #ifndef NDEBUG
 void printSimpleLineLayoutCoverage();
 void printSimpleLineLayoutBlockList();
@@ -59,38 +73,36 @@ enum AvoidanceReason_ : uint64_t {
     FlowHasLineAlignEdges                 = 1LLU  << 21,
     FlowHasLineSnap                       = 1LLU  << 22,
     FlowHasTextEmphasisFillOrMark         = 1LLU  << 23,
-    FlowHasTextShadow                     = 1LLU  << 24,
-    FlowHasPseudoFirstLine                = 1LLU  << 25,
-    FlowHasPseudoFirstLetter              = 1LLU  << 26,
-    FlowHasTextCombine                    = 1LLU  << 27,
-    FlowHasTextFillBox                    = 1LLU  << 28,
-    FlowHasBorderFitLines                 = 1LLU  << 29,
-    FlowHasNonAutoLineBreak               = 1LLU  << 30,
-    FlowHasNonAutoTrailingWord            = 1LLU  << 31,
-    FlowHasSVGFont                        = 1LLU  << 32,
-    FlowTextIsEmpty                       = 1LLU  << 33,
-    FlowTextHasSoftHyphen                 = 1LLU  << 34,
-    FlowTextHasDirectionCharacter         = 1LLU  << 35,
-    FlowIsMissingPrimaryFont              = 1LLU  << 36,
-    FlowPrimaryFontIsInsufficient         = 1LLU  << 37,
-    FlowTextIsCombineText                 = 1LLU  << 38,
-    FlowTextIsRenderCounter               = 1LLU  << 39,
-    FlowTextIsRenderQuote                 = 1LLU  << 40,
-    FlowTextIsTextFragment                = 1LLU  << 41,
-    FlowTextIsSVGInlineText               = 1LLU  << 42,
-    FlowHasComplexFontCodePath            = 1LLU  << 43,
-    FeatureIsDisabled                     = 1LLU  << 44,
-    FlowHasNoParent                       = 1LLU  << 45,
-    FlowHasNoChild                        = 1LLU  << 46,
-    FlowChildIsSelected                   = 1LLU  << 47,
-    FlowHasHangingPunctuation             = 1LLU  << 48,
-    FlowFontHasOverflowGlyph              = 1LLU  << 49,
-    FlowTextHasSurrogatePair              = 1LLU  << 50,
-    MultiColumnFlowIsNotTopLevel          = 1LLU  << 51,
-    MultiColumnFlowHasColumnSpanner       = 1LLU  << 52,
-    MultiColumnFlowVerticalAlign          = 1LLU  << 53,
-    MultiColumnFlowIsFloating             = 1LLU  << 54,
-    EndOfReasons                          = 1LLU  << 55
+    FlowHasPseudoFirstLine                = 1LLU  << 24,
+    FlowHasPseudoFirstLetter              = 1LLU  << 25,
+    FlowHasTextCombine                    = 1LLU  << 26,
+    FlowHasTextFillBox                    = 1LLU  << 27,
+    FlowHasBorderFitLines                 = 1LLU  << 28,
+    FlowHasNonAutoTrailingWord            = 1LLU  << 29,
+    FlowHasSVGFont                        = 1LLU  << 30,
+    FlowTextIsEmpty                       = 1LLU  << 31,
+    FlowTextHasSoftHyphen                 = 1LLU  << 32,
+    FlowTextHasDirectionCharacter         = 1LLU  << 33,
+    FlowIsMissingPrimaryFont              = 1LLU  << 34,
+    FlowPrimaryFontIsInsufficient         = 1LLU  << 35,
+    FlowTextIsCombineText                 = 1LLU  << 36,
+    FlowTextIsRenderCounter               = 1LLU  << 37,
+    FlowTextIsRenderQuote                 = 1LLU  << 38,
+    FlowTextIsTextFragment                = 1LLU  << 39,
+    FlowTextIsSVGInlineText               = 1LLU  << 40,
+    FlowHasComplexFontCodePath            = 1LLU  << 41,
+    FeatureIsDisabled                     = 1LLU  << 42,
+    FlowHasNoParent                       = 1LLU  << 43,
+    FlowHasNoChild                        = 1LLU  << 44,
+    FlowChildIsSelected                   = 1LLU  << 45,
+    FlowHasHangingPunctuation             = 1LLU  << 46,
+    FlowFontHasOverflowGlyph              = 1LLU  << 47,
+    FlowTextHasSurrogatePair              = 1LLU  << 48,
+    MultiColumnFlowIsNotTopLevel          = 1LLU  << 49,
+    MultiColumnFlowHasColumnSpanner       = 1LLU  << 50,
+    MultiColumnFlowVerticalAlign          = 1LLU  << 51,
+    MultiColumnFlowIsFloating             = 1LLU  << 52,
+    EndOfReasons                          = 1LLU  << 53
 };
 const unsigned NoReason = 0;
 
@@ -61,6 +61,19 @@ FloatRect computeOverflow(const RenderBlockFlow& flow, const FloatRect& layoutRe
     auto strokeOverflow = std::ceil(flow.style().computedStrokeWidth(viewportSize));
     overflowRect.inflate(strokeOverflow);
 
+    if (flow.style().textShadow()) {
+        LayoutUnit shadowLogicalLeft;
+        LayoutUnit shadowLogicalRight;
+        LayoutUnit shadowLogicalTop;
+        LayoutUnit shadowLogicalBottom;
+        flow.style().getTextShadowInlineDirectionExtent(shadowLogicalLeft, shadowLogicalRight);
+        flow.style().getTextShadowBlockDirectionExtent(shadowLogicalTop, shadowLogicalBottom);
+        overflowRect.shiftXEdgeTo(overflowRect.x() + shadowLogicalLeft);
+        overflowRect.shiftMaxXEdgeTo(overflowRect.maxX() + shadowLogicalRight);
+        overflowRect.shiftYEdgeTo(overflowRect.y() + shadowLogicalTop);
+        overflowRect.shiftMaxYEdgeTo(overflowRect.maxY() + shadowLogicalBottom);
+    }
+
     auto letterSpacing = flow.style().fontCascade().letterSpacing();
     if (letterSpacing >= 0)
         return overflowRect;
@@ -86,7 +99,8 @@ void paintFlow(const RenderBlockFlow& flow, const Layout& layout, PaintInfo& pai
     if (flow.settings().simpleLineLayoutDebugBordersEnabled()) {
         debugShadow = std::make_unique<ShadowData>(IntPoint(0, 0), 10, 20, ShadowStyle::Normal, true, Color(0, 255, 0, 200));
         textPainter.addTextShadow(debugShadow.get(), nullptr);
-    }
+    } else
+        textPainter.addTextShadow(style.textShadow(), nullptr);
 
     std::optional<TextDecorationPainter> textDecorationPainter;
     if (style.textDecorationsInEffect() != TextDecorationNone) {
@@ -95,6 +109,7 @@ void paintFlow(const RenderBlockFlow& flow, const Layout& layout, PaintInfo& pai
             textDecorationPainter.emplace(paintInfo.context(), style.textDecorationsInEffect(), *textRenderer, false);
             textDecorationPainter->setFont(style.fontCascade());
             textDecorationPainter->setBaseline(style.fontMetrics().ascent());
+            textDecorationPainter->addTextShadow(style.textShadow());
         }
     }
 
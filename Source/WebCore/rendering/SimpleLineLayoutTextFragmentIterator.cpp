@@ -29,6 +29,7 @@
 #include "Hyphenation.h"
 #include "RenderBlockFlow.h"
 #include "RenderChildIterator.h"
+#include "RenderText.h"
 #include "SimpleLineLayoutFlowContents.h"
 
 namespace WebCore {
@@ -52,6 +53,7 @@ TextFragmentIterator::Style::Style(const RenderStyle& style, bool useSimplifiedT
     , hyphenLimitBefore(style.hyphenationLimitBefore() < 0 ? 2 : style.hyphenationLimitBefore())
     , hyphenLimitAfter(style.hyphenationLimitAfter() < 0 ? 2 : style.hyphenationLimitAfter())
     , locale(style.locale())
+    , lineBreakIteratorMode(mapLineBreakToIteratorMode(style.lineBreak()))
 {
     if (style.hyphenationLimitLines() > -1)
         hyphenLimitLines = style.hyphenationLimitLines();
@@ -60,7 +62,7 @@ TextFragmentIterator::Style::Style(const RenderStyle& style, bool useSimplifiedT
 TextFragmentIterator::TextFragmentIterator(const RenderBlockFlow& flow)
     : m_flowContents(flow)
     , m_currentSegment(m_flowContents.begin())
-    , m_lineBreakIterator(m_currentSegment->text, flow.style().locale())
+    , m_lineBreakIterator(m_currentSegment->text, flow.style().locale(), mapLineBreakToIteratorMode(flow.style().lineBreak()))
     , m_style(flow.style(), m_currentSegment->canUseSimplifiedTextMeasuring)
 {
 }
@@ -148,7 +150,7 @@ unsigned TextFragmentIterator::nextBreakablePosition(const FlowContents::Segment
         UChar lastCharacter = textLength > 0 ? currentText[textLength - 1] : 0;
         UChar secondToLastCharacter = textLength > 1 ? currentText[textLength - 2] : 0;
         m_lineBreakIterator.setPriorContext(lastCharacter, secondToLastCharacter);
-        m_lineBreakIterator.resetStringAndReleaseIterator(segment.text, m_style.locale, LineBreakIteratorMode::Default);
+        m_lineBreakIterator.resetStringAndReleaseIterator(segment.text, m_style.locale, m_style.lineBreakIteratorMode);
     }
     return segment.toRenderPosition(nextBreakablePositionInSegment(m_lineBreakIterator, segment.toSegmentPosition(startPosition), m_style.breakNBSP, m_style.keepAllWordsForCJK));
 }
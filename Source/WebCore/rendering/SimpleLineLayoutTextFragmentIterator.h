@@ -122,6 +122,7 @@ public:
         unsigned hyphenLimitBefore;
         unsigned hyphenLimitAfter;
         AtomicString locale;
+        LineBreakIteratorMode lineBreakIteratorMode;
         std::optional<unsigned> hyphenLimitLines;
     };
     const Style& style() const { return m_style; }
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "StyleParallelRuleMatcher.h"
+
+#include "CSSDefaultStyleSheets.h"
+#include "Document.h"
+#include "DocumentRuleSets.h"
+#include "ElementTraversal.h"
+#include "InspectorInstrumentation.h"
+#include "RuleSet.h"
+#include "SelectorFilter.h"
+#include "Settings.h"
+#include "StyleResolver.h"
+#include "StyleScope.h"
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <wtf/MainThread.h>
+#include <wtf/NumberOfCores.h>
+#include <wtf/ParallelHelperPool.h>
+
+namespace WebCore {
+namespace Style {
+
+static const unsigned noParent = std::numeric_limits<unsigned>::max();
+// Below this the cost of waking up the helper threads outweighs the matching work.
+static const unsigned minimumElementCountForParallelMatching = 256;
+static const unsigned entriesPerTask = 32;
+
+static ParallelHelperPool& styleHelperPool()
+{
+    static std::once_flag initializeHelperPoolOnceFlag;
+    static ParallelHelperPool* helperPool;
+    std::call_once(initializeHelperPoolOnceFlag, [] {
+        helperPool = new ParallelHelperPool();
+        helperPool->ensureThreads(numberOfProcessorCores() - 1);
+    });
+    return *helperPool;
+}
+
+ParallelRuleMatcher::ParallelRuleMatcher(Document& document)
+    : m_document(document)
+{
+}
+
+ParallelRuleMatcher::~ParallelRuleMatcher()
+{
+}
+
+bool ParallelRuleMatcher::canMatchInParallel(const Document& document)
+{
+    if (!document.settings().parallelStyleResolutionEnabled())
+        return false;
+    if (numberOfProcessorCores() < 2)
+        return false;
+    // The inspector can force pseudo class states, which is not safe to query from helper threads.
+    if (InspectorInstrumentation::hasFrontends())
+        return false;
+    return true;
+}
+
+bool ParallelRuleMatcher::isValid() const
+{
+    // Precollected rules refer to RuleData and elements, so any DOM or rule set mutation since matching drops them.
+    if (m_domTreeVersion != m_document.domTreeVersion())
+        return false;
+    if (m_defaultStyleVersion != CSSDefaultStyleSheets::defaultStyleVersion)
+        return false;
+    for (unsigned i = 0; i < m_ruleSets.size(); ++i) {
+        if (m_ruleSets[i]->ruleCount() != m_ruleCounts[i])
+            return false;
+    }
+    return true;
+}
+
+void ParallelRuleMatcher::clear()
+{
+    m_entries.clear();
+    m_entryIndices.clear();
+    m_ruleSets.clear();
+    m_ruleCounts.clear();
+}
+
+unsigned ParallelRuleMatcher::ensureAncestorEntries(Element& element)
+{
+    auto it = m_entryIndices.find(&element);
+    if (it != m_entryIndices.end())
+        return it->value;
+
+    auto* parent = element.parentElement();
+    unsigned parentIndex = parent ? ensureAncestorEntries(*parent) : noParent;
+
+    Entry entry { &element, parentIndex, false, { }, { } };
+    SelectorFilter::collectElementIdentifierHashes(element, entry.identifierHashes);
+
+    unsigned index = m_entries.size();
+    m_entries.append(WTFMove(entry));
+    m_entryIndices.add(&element, index);
+    return index;
+}
+
+void ParallelRuleMatcher::matchDescendants(Element& root)
+{
+    ASSERT(isMainThread());
+    ASSERT(!root.isInShadowTree());
+
+    if (!m_entries.isEmpty() && !isValid())
+        clear();
+
+    // The element was already matched as part of an earlier subtree.
+    if (m_entryIndices.contains(&root))
+        return;
+
+    ensureAncestorEntries(root);
+    unsigned firstNewEntry = m_entries.size();
+
+    // Do everything that may mutate the tree or the rule sets on the main thread up front.
+    for (auto* element = ElementTraversal::firstWithin(root); element; ) {
+        CSSDefaultStyleSheets::ensureDefaultStyleSheetsForElement(*element);
+        // Attribute selectors would otherwise synchronize lazy attributes while matching.
+        element->synchronizeAllAttributes();
+
+        auto parentIndex = m_entryIndices.get(element->parentElement());
+        // Custom style resolution callbacks may mutate the element before it is resolved.
+        Entry entry { element, parentIndex, !element->hasCustomStyleResolveCallbacks(), { }, { } };
+        if (ElementTraversal::firstChild(*element))
+            SelectorFilter::collectElementIdentifierHashes(*element, entry.identifierHashes);
+
+        m_entryIndices.add(element, m_entries.size());
+        m_entries.append(WTFMove(entry));
+
+        // Children of shadow hosts are resolved through slots in a different scope.
+        element = element->shadowRoot() ? ElementTraversal::nextSkippingChildren(*element, &root) : ElementTraversal::next(*element, &root);
+    }
+
+    Vector<const RuleSet*, 4> ruleSets;
+    ruleSets.append(CSSDefaultStyleSheets::defaultStyle);
+    if (m_document.inQuirksMode() && CSSDefaultStyleSheets::defaultQuirksStyle)
+        ruleSets.append(CSSDefaultStyleSheets::defaultQuirksStyle);
+    auto& documentRuleSets = m_document.styleScope().resolver().ruleSets();
+    if (auto* userStyle = documentRuleSets.userStyle())
+        ruleSets.append(userStyle);
+    ruleSets.append(&documentRuleSets.authorStyle());
+
+    Vector<unsigned, 4> ruleCounts;
+    for (auto* ruleSet : ruleSets)
+        ruleCounts.append(ruleSet->ruleCount());
+
+    if (ruleSets != m_ruleSets || ruleCounts != m_ruleCounts || m_defaultStyleVersion != CSSDefaultStyleSheets::defaultStyleVersion) {
+        for (unsigned i = 0; i < firstNewEntry; ++i)
+            m_entries[i].rules.clear();
+        m_ruleSets = WTFMove(ruleSets);
+        m_ruleCounts = WTFMove(ruleCounts);
+        m_defaultStyleVersion = CSSDefaultStyleSheets::defaultStyleVersion;
+    }
+    m_domTreeVersion = m_document.domTreeVersion();
+
+    unsigned endEntry = m_entries.size();
+    if (endEntry - firstNewEntry < minimumElementCountForParallelMatching)
+        return;
+
+    std::atomic<unsigned> nextEntry { firstNewEntry };
+    ParallelHelperClient client(&styleHelperPool());
+    client.runFunctionInParallel([&] {
+        SelectorFilter selectorFilter;
+        Vector<unsigned, 32> filterStack;
+        while (true) {
+            unsigned begin = nextEntry.fetch_add(entriesPerTask, std::memory_order_relaxed);
+            if (begin >= endEntry)
+                return;
+            unsigned end = std::min(begin + entriesPerTask, endEntry);
+            for (unsigned i = begin; i < end; ++i)
+                matchEntry(i, selectorFilter, filterStack);
+        }
+    });
+}
+
+void ParallelRuleMatcher::matchEntry(unsigned index, SelectorFilter& selectorFilter, Vector<unsigned, 32>& filterStack)
+{
+    auto& entry = m_entries[index];
+
+    // Keep exactly the ancestors of the element in the filter, rebuilding it when jumping to an unrelated part of the tree.
+    while (!filterStack.isEmpty() && filterStack.last() != entry.parentIndex) {
+        selectorFilter.popParent();
+        filterStack.removeLast();
+    }
+    if (filterStack.isEmpty()) {
+        Vector<unsigned, 32> ancestors;
+        for (unsigned index = entry.parentIndex; index != noParent; index = m_entries[index].parentIndex)
+            ancestors.append(index);
+        for (unsigned i = ancestors.size(); i--;) {
+            auto& ancestor = m_entries[ancestors[i]];
+            selectorFilter.pushParent(ancestor.element, ancestor.identifierHashes);
+            filterStack.append(ancestors[i]);
+        }
+    }
+
+    if (entry.shouldMatch) {
+        entry.rules.resize(m_ruleSets.size());
+        for (unsigned i = 0; i < m_ruleSets.size(); ++i) {
+            ElementRuleCollector collector(*entry.element, *m_ruleSets[i], &selectorFilter);
+            PrecollectedRules rules;
+            if (collector.collectMatchingRulesOffMainThread(*m_ruleSets[i], rules))
+                entry.rules[i] = WTFMove(rules);
+        }
+    }
+
+    // Entries are in document order, so the children of the element usually come next. Like TreeResolver
+    // does with its SelectorFilter, push the element for them. Only elements with children have hashes.
+    if (!entry.identifierHashes.isEmpty()) {
+        selectorFilter.pushParent(entry.element, entry.identifierHashes);
+        filterStack.append(index);
+    }
+}
+
+const PrecollectedRules* ParallelRuleMatcher::precollectedRules(const Element& element, const RuleSet& ruleSet) const
+{
+    ASSERT(isMainThread());
+
+    auto it = m_entryIndices.find(&element);
+    if (it == m_entryIndices.end())
+        return nullptr;
+    if (!isValid())
+        return nullptr;
+
+    auto& rules = m_entries[it->value].rules;
+    for (unsigned i = 0; i < rules.size(); ++i) {
+        if (m_ruleSets[i] == &ruleSet)
+            return rules[i] ? &rules[i].value() : nullptr;
+    }
+    return nullptr;
+}
+
+}
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "ElementRuleCollector.h"
+#include "StyleRelations.h"
+#include <wtf/HashMap.h>
+#include <wtf/Optional.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class Document;
+class Element;
+class RuleSet;
+class SelectorFilter;
+
+namespace Style {
+
+struct PrecollectedRules {
+    Vector<MatchedRule> matchedRules;
+    Relations styleRelations;
+    PseudoIdSet matchedPseudoElementIds;
+    bool didMatchUncommonAttributeSelector { false };
+};
+
+// Matches the document scope rule sets against whole subtrees on helper threads ahead of TreeResolver.
+// Only selector matching runs in parallel. Style relations are handed back to ElementRuleCollector and
+// committed, together with everything else that computing a RenderStyle involves, on the main thread.
+class ParallelRuleMatcher {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    explicit ParallelRuleMatcher(Document&);
+    ~ParallelRuleMatcher();
+
+    static bool canMatchInParallel(const Document&);
+
+    // Call when all descendants of the element are going to be resolved.
+    void matchDescendants(Element&);
+
+    const PrecollectedRules* precollectedRules(const Element&, const RuleSet&) const;
+
+private:
+    struct Entry {
+        Element* element;
+        unsigned parentIndex;
+        bool shouldMatch;
+        Vector<unsigned, 4> identifierHashes;
+        Vector<std::optional<PrecollectedRules>, 4> rules;
+    };
+
+    bool isValid() const;
+    void clear();
+    unsigned ensureAncestorEntries(Element&);
+    void matchEntry(unsigned index, SelectorFilter&, Vector<unsigned, 32>& filterStack);
+
+    Document& m_document;
+    Vector<Entry> m_entries;
+    HashMap<const Element*, unsigned> m_entryIndices;
+
+    Vector<const RuleSet*, 4> m_ruleSets;
+    Vector<unsigned, 4> m_ruleCounts;
+    uint64_t m_domTreeVersion { 0 };
+    unsigned m_defaultStyleVersion { 0 };
+};
+
+}
+}
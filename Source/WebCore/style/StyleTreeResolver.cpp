@@ -43,6 +43,7 @@
 #include "Settings.h"
 #include "ShadowRoot.h"
 #include "StyleFontSizeFunctions.h"
+#include "StyleParallelRuleMatcher.h"
 #include "StyleResolver.h"
 #include "StyleScope.h"
 #include "Text.h"
@@ -459,6 +460,10 @@ void TreeResolver::resolveComposedTree()
             continue;
         }
 
+        // Everything below is going to be resolved so selector matching for it can start on helper threads.
+        if (m_parallelRuleMatcher && change >= Force && !m_didSeePendingStylesheet && !element.isInShadowTree())
+            m_parallelRuleMatcher->matchDescendants(element);
+
         pushParent(element, *style, change);
 
         it.traverseNext();
@@ -489,8 +494,18 @@ std::unique_ptr<Update> TreeResolver::resolve()
     renderView.setUsesFirstLineRules(renderView.usesFirstLineRules() || scope().styleResolver.usesFirstLineRules());
     renderView.setUsesFirstLetterRules(renderView.usesFirstLetterRules() || scope().styleResolver.usesFirstLetterRules());
 
+    if (ParallelRuleMatcher::canMatchInParallel(m_document)) {
+        m_parallelRuleMatcher = std::make_unique<ParallelRuleMatcher>(m_document);
+        scope().styleResolver.setParallelRuleMatcher(m_parallelRuleMatcher.get());
+    }
+
     resolveComposedTree();
 
+    if (m_parallelRuleMatcher) {
+        scope().styleResolver.setParallelRuleMatcher(nullptr);
+        m_parallelRuleMatcher = nullptr;
+    }
+
     renderView.setUsesFirstLineRules(scope().styleResolver.usesFirstLineRules());
     renderView.setUsesFirstLetterRules(scope().styleResolver.usesFirstLetterRules());
 
@@ -47,6 +47,8 @@ class StyleResolver;
 
 namespace Style {
 
+class ParallelRuleMatcher;
+
 class TreeResolver {
 public:
     TreeResolver(Document&);
@@ -104,6 +106,7 @@ private:
     Vector<Parent, 32> m_parentStack;
     bool m_didSeePendingStylesheet { false };
 
+    std::unique_ptr<ParallelRuleMatcher> m_parallelRuleMatcher;
     std::unique_ptr<Update> m_update;
 };
 
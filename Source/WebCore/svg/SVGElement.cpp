@@ -958,6 +958,13 @@ bool SVGElement::isKnownAttribute(const QualifiedName& attrName)
     return attrName == HTMLNames::idAttr;
 }
 
+void SVGElement::invalidateSVGAttributes()
+{
+    ensureUniqueElementData().setAnimatedSVGAttributesAreDirty(true);
+    // The attribute values change without going through attributeChanged().
+    document().incAttributeVersion();
+}
+
 void SVGElement::svgAttributeChanged(const QualifiedName& attrName)
 {
     CSSPropertyID propId = cssPropertyIdForSVGAttributeName(attrName);
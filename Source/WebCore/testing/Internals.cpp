@@ -2818,6 +2818,22 @@ unsigned Internals::layoutCount() const
     return document->view()->layoutCount();
 }
 
+unsigned Internals::itemMeasureLayoutCount() const
+{
+    Document* document = contextDocument();
+    if (!document || !document->view())
+        return 0;
+    return document->view()->itemMeasureLayoutCount();
+}
+
+unsigned Internals::itemMeasureCacheHitCount() const
+{
+    Document* document = contextDocument();
+    if (!document || !document->view())
+        return 0;
+    return document->view()->itemMeasureCacheHitCount();
+}
+
 #if !PLATFORM(IOS)
 static const char* cursorTypeToString(Cursor::Type cursorType)
 {
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "NetworkLoadScheduler.h"
+
+#include <wtf/Optional.h>
+
+using namespace WebCore;
+
+namespace WebKit {
+
+// Keep in sync with the per-host connection limit of SoupNetworkSession, so that the connections
+// reserved here for parser-blocking loads are really available to them in the backend.
+static const unsigned maximumConnectionsPerHost = 6;
+
+// While a page has parser-blocking loads in flight, it can only run this many low priority loads.
+static const unsigned maximumThrottledLoadsPerPage = 2;
+
+// Low priority loads are not held back by the page throttling for longer than this, so that
+// long-lived parser-blocking loads (e.g. streaming responses) don't starve them.
+static const Seconds maximumThrottlingDelay = 1_s;
+
+static inline bool isBlockingPriority(ResourceLoadPriority priority)
+{
+    return priority >= ResourceLoadPriority::High;
+}
+
+static inline bool isThrottledPriority(ResourceLoadPriority priority)
+{
+    return priority <= ResourceLoadPriority::Low;
+}
+
+NetworkLoadScheduler::NetworkLoadScheduler()
+    : m_throttleTimer(RunLoop::main(), this, &NetworkLoadScheduler::throttleTimerFired)
+{
+}
+
+NetworkLoadScheduler::~NetworkLoadScheduler()
+{
+}
+
+void NetworkLoadScheduler::schedule(NetworkLoadSchedulerClient& loader, const ResourceRequest& request)
+{
+    ASSERT(RunLoop::isMain());
+    ASSERT(!isPending(loader));
+
+    // A loader restarting its network load, e.g. to revalidate a cached entry, keeps its slot.
+    if (m_activeLoads.contains(&loader)) {
+        loader.startScheduledNetworkLoad(request);
+        return;
+    }
+
+    if (loader.isSynchronous() || !isThrottledPriority(request.priority())) {
+        startLoad(loader, request);
+        return;
+    }
+
+    m_pendingLoads.append({ &loader, request, MonotonicTime::now() });
+    startPendingLoads();
+}
+
+void NetworkLoadScheduler::unschedule(NetworkLoadSchedulerClient& loader)
+{
+    ASSERT(RunLoop::isMain());
+
+    auto index = m_pendingLoads.findMatching([&loader](auto& pendingLoad) {
+        return pendingLoad.loader == &loader;
+    });
+    if (index != notFound) {
+        m_pendingLoads.remove(index);
+        return;
+    }
+
+    auto it = m_activeLoads.find(&loader);
+    if (it == m_activeLoads.end())
+        return;
+
+    auto activeLoad = WTFMove(it->value);
+    m_activeLoads.remove(it);
+    didFinishLoad(activeLoad);
+    startPendingLoads();
+}
+
+bool NetworkLoadScheduler::isPending(const NetworkLoadSchedulerClient& loader) const
+{
+    return m_pendingLoads.findMatching([&loader](auto& pendingLoad) {
+        return pendingLoad.loader == &loader;
+    }) != notFound;
+}
+
+unsigned NetworkLoadScheduler::maximumThrottledLoadsForHost(const String& host) const
+{
+    // Always leave one connection free for a parser-blocking load, and one more for each such load
+    // already running on the host, but never starve low priority loads completely.
+    auto it = m_hostLoads.find(host);
+    unsigned activeBlockingLoads = it == m_hostLoads.end() ? 0 : it->value.activeBlockingLoads;
+    unsigned reservedConnections = std::min(activeBlockingLoads + 1, maximumConnectionsPerHost - 1);
+    return maximumConnectionsPerHost - reservedConnections;
+}
+
+bool NetworkLoadScheduler::canStartThrottledLoad(const PendingLoad& pendingLoad, MonotonicTime now) const
+{
+    auto host = pendingLoad.request.url().host();
+    auto hostIterator = m_hostLoads.find(host);
+    if (hostIterator != m_hostLoads.end() && hostIterator->value.activeThrottledLoads >= maximumThrottledLoadsForHost(host))
+        return false;
+
+    if (now - pendingLoad.scheduledTime >= maximumThrottlingDelay)
+        return true;
+
+    auto pageIterator = m_pageLoads.find(pendingLoad.loader->pageID());
+    if (pageIterator == m_pageLoads.end() || !pageIterator->value.activeBlockingLoads)
+        return true;
+    return pageIterator->value.activeThrottledLoads < maximumThrottledLoadsPerPage;
+}
+
+void NetworkLoadScheduler::startLoad(NetworkLoadSchedulerClient& loader, const ResourceRequest& request)
+{
+    auto priority = request.priority();
+    ActiveLoad activeLoad { loader.pageID(), request.url().host(), !loader.isSynchronous() && isBlockingPriority(priority), !loader.isSynchronous() && isThrottledPriority(priority) };
+
+    if (activeLoad.isBlocking || activeLoad.isThrottled) {
+        auto& hostLoads = m_hostLoads.add(activeLoad.host, HostLoads()).iterator->value;
+        auto& pageLoads = m_pageLoads.add(activeLoad.pageID, PageLoads()).iterator->value;
+        if (activeLoad.isBlocking) {
+            ++hostLoads.activeBlockingLoads;
+            ++pageLoads.activeBlockingLoads;
+        } else {
+            ++hostLoads.activeThrottledLoads;
+            ++pageLoads.activeThrottledLoads;
+        }
+    }
+
+    m_activeLoads.add(&loader, WTFMove(activeLoad));
+    loader.startScheduledNetworkLoad(request);
+}
+
+void NetworkLoadScheduler::didFinishLoad(const ActiveLoad& activeLoad)
+{
+    if (!activeLoad.isBlocking && !activeLoad.isThrottled)
+        return;
+
+    auto hostIterator = m_hostLoads.find(activeLoad.host);
+    auto pageIterator = m_pageLoads.find(activeLoad.pageID);
+    ASSERT(hostIterator != m_hostLoads.end());
+    ASSERT(pageIterator != m_pageLoads.end());
+
+    auto& hostLoads = hostIterator->value;
+    auto& pageLoads = pageIterator->value;
+    if (activeLoad.isBlocking) {
+        --hostLoads.activeBlockingLoads;
+        --pageLoads.activeBlockingLoads;
+    } else {
+        --hostLoads.activeThrottledLoads;
+        --pageLoads.activeThrottledLoads;
+    }
+
+    if (!hostLoads.activeBlockingLoads && !hostLoads.activeThrottledLoads)
+        m_hostLoads.remove(hostIterator);
+    if (!pageLoads.activeBlockingLoads && !pageLoads.activeThrottledLoads)
+        m_pageLoads.remove(pageIterator);
+}
+
+void NetworkLoadScheduler::startPendingLoads()
+{
+    // Starting a load can synchronously fail and unschedule it, which re-enters this function,
+    // so look for the next load to start from scratch every time.
+    while (true) {
+        auto now = MonotonicTime::now();
+        size_t indexToStart = notFound;
+        for (size_t i = 0; i < m_pendingLoads.size(); ++i) {
+            auto& pendingLoad = m_pendingLoads[i];
+            if (!canStartThrottledLoad(pendingLoad, now))
+                continue;
+            if (indexToStart == notFound || pendingLoad.request.priority() > m_pendingLoads[indexToStart].request.priority())
+                indexToStart = i;
+        }
+        if (indexToStart == notFound)
+            break;
+
+        auto pendingLoad = WTFMove(m_pendingLoads[indexToStart]);
+        m_pendingLoads.remove(indexToStart);
+        startLoad(*pendingLoad.loader, pendingLoad.request);
+    }
+
+    if (m_pendingLoads.isEmpty()) {
+        m_throttleTimer.stop();
+        return;
+    }
+
+    // Loads that already exceeded the maximum throttling delay are waiting for a host connection,
+    // and will be started when one is released.
+    auto now = MonotonicTime::now();
+    std::optional<MonotonicTime> nextDeadline;
+    for (auto& pendingLoad : m_pendingLoads) {
+        auto deadline = pendingLoad.scheduledTime + maximumThrottlingDelay;
+        if (deadline > now && (!nextDeadline || deadline < *nextDeadline))
+            nextDeadline = deadline;
+    }
+    if (nextDeadline)
+        m_throttleTimer.startOneShot(*nextDeadline - now);
+    else
+        m_throttleTimer.stop();
+}
+
+void NetworkLoadScheduler::throttleTimerFired()
+{
+    startPendingLoads();
+}
+
+} // namespace WebKit
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "WKDeclarationSpecifiers.h"
+#include <WebCore/ResourceLoadPriority.h>
+#include <WebCore/ResourceRequest.h>
+#include <wtf/HashMap.h>
+#include <wtf/MonotonicTime.h>
+#include <wtf/RunLoop.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebKit {
+
+// Implemented by NetworkResourceLoader.
+class NetworkLoadSchedulerClient {
+public:
+    virtual ~NetworkLoadSchedulerClient() { }
+
+    virtual uint64_t pageID() const = 0;
+    virtual bool isSynchronous() const = 0;
+
+    // Called once the load is allowed to go to the network. The client may synchronously fail
+    // and unschedule itself from here.
+    virtual void startScheduledNetworkLoad(const WebCore::ResourceRequest&) = 0;
+};
+
+// Decides when a NetworkLoadSchedulerClient is allowed to create its NetworkLoad. Parser-blocking
+// loads (ResourceLoadPriority::High and above) and medium priority loads start right away.
+// Low priority loads, mostly images and prefetches, are held back while parser-blocking loads
+// of the same page are in flight, and never take the per-host connections the network backend
+// needs for them.
+class NetworkLoadScheduler {
+    WTF_MAKE_NONCOPYABLE(NetworkLoadScheduler); WTF_MAKE_FAST_ALLOCATED;
+public:
+    WK_EXPORT NetworkLoadScheduler();
+    WK_EXPORT ~NetworkLoadScheduler();
+
+    WK_EXPORT void schedule(NetworkLoadSchedulerClient&, const WebCore::ResourceRequest&);
+    WK_EXPORT void unschedule(NetworkLoadSchedulerClient&);
+
+    WK_EXPORT bool isPending(const NetworkLoadSchedulerClient&) const;
+    size_t pendingLoadCount() const { return m_pendingLoads.size(); }
+
+private:
+    struct PendingLoad {
+        NetworkLoadSchedulerClient* loader;
+        WebCore::ResourceRequest request;
+        MonotonicTime scheduledTime;
+    };
+
+    struct ActiveLoad {
+        uint64_t pageID;
+        String host;
+        bool isBlocking;
+        bool isThrottled;
+    };
+
+    struct HostLoads {
+        unsigned activeBlockingLoads { 0 };
+        unsigned activeThrottledLoads { 0 };
+    };
+
+    struct PageLoads {
+        unsigned activeBlockingLoads { 0 };
+        unsigned activeThrottledLoads { 0 };
+    };
+
+    bool canStartThrottledLoad(const PendingLoad&, MonotonicTime now) const;
+    unsigned maximumThrottledLoadsForHost(const String& host) const;
+    void startLoad(NetworkLoadSchedulerClient&, const WebCore::ResourceRequest&);
+    void didFinishLoad(const ActiveLoad&);
+    void startPendingLoads();
+    void throttleTimerFired();
+
+    Vector<PendingLoad> m_pendingLoads;
+    HashMap<NetworkLoadSchedulerClient*, ActiveLoad> m_activeLoads;
+    HashMap<String, HostLoads> m_hostLoads;
+    HashMap<uint64_t, PageLoads> m_pageLoads;
+    RunLoop::Timer<NetworkLoadScheduler> m_throttleTimer;
+};
+
+} // namespace WebKit
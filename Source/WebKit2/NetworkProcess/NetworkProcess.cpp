@@ -590,6 +590,7 @@ void NetworkProcess::getNetworkProcessStatistics(uint64_t callbackID)
     auto& networkProcess = NetworkProcess::singleton();
     data.statisticsNumbers.set("DownloadsActiveCount", networkProcess.downloadManager().activeDownloadCount());
     data.statisticsNumbers.set("OutstandingAuthenticationChallengesCount", networkProcess.authenticationManager().outstandingAuthenticationChallengeCount());
+    data.statisticsNumbers.set("PendingThrottledLoadsCount", networkProcess.networkLoadScheduler().pendingLoadCount());
 
     parentProcessConnection()->send(Messages::WebProcessPool::DidGetStatistics(data, callbackID), 0);
 }
@@ -29,6 +29,7 @@
 #include "ChildProcess.h"
 #include "DownloadManager.h"
 #include "MessageReceiverMap.h"
+#include "NetworkLoadScheduler.h"
 #include <WebCore/DiagnosticLoggingClient.h>
 #include <WebCore/SessionID.h>
 #include <WebCore/Proxy.h>
@@ -87,6 +88,7 @@ public:
 
     AuthenticationManager& authenticationManager();
     DownloadManager& downloadManager();
+    NetworkLoadScheduler& networkLoadScheduler() { return m_networkLoadScheduler; }
     bool canHandleHTTPSServerTrustEvaluation() const { return m_canHandleHTTPSServerTrustEvaluation; }
 
     void processWillSuspendImminently(bool& handled);
@@ -218,6 +220,7 @@ private:
     bool m_diskCacheIsDisabledForTesting;
     bool m_canHandleHTTPSServerTrustEvaluation;
     Seconds m_loadThrottleLatency;
+    NetworkLoadScheduler m_networkLoadScheduler;
 
     typedef HashMap<const char*, std::unique_ptr<NetworkProcessSupplement>, PtrHash<const char*>> NetworkProcessSupplementMap;
     NetworkProcessSupplementMap m_supplements;
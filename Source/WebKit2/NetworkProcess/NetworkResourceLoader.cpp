@@ -68,6 +68,27 @@ struct NetworkResourceLoader::SynchronousLoadData {
     ResourceError error;
 };
 
+// Loads that are not buffered still get their data coalesced when it arrives faster than this,
+// so that a fast transfer doesn't cost one IPC message and one main thread dispatch in the
+// WebProcess per network chunk. Sparse data, like an event stream, is still sent right away.
+static Seconds minimumDataDeliveryInterval(ResourceLoadPriority priority)
+{
+    switch (priority) {
+    case ResourceLoadPriority::VeryLow:
+        return 100_ms;
+    case ResourceLoadPriority::Low:
+        return 50_ms;
+    case ResourceLoadPriority::Medium:
+        return 16_ms;
+    case ResourceLoadPriority::High:
+    case ResourceLoadPriority::VeryHigh:
+        return 0_s;
+    }
+
+    ASSERT_NOT_REACHED();
+    return 0_s;
+}
+
 static void sendReplyToSynchronousRequest(NetworkResourceLoader::SynchronousLoadData& data, const SharedBuffer* buffer)
 {
     ASSERT(data.delayedReply);
@@ -210,6 +231,11 @@ void NetworkResourceLoader::retrieveCacheEntry(const ResourceRequest& request)
 #endif
 
 void NetworkResourceLoader::startNetworkLoad(const ResourceRequest& request)
+{
+    NetworkProcess::singleton().networkLoadScheduler().schedule(*this, request);
+}
+
+void NetworkResourceLoader::startScheduledNetworkLoad(const ResourceRequest& request)
 {
     RELEASE_LOG_IF_ALLOWED("startNetworkLoad: (pageID = %" PRIu64 ", frameID = %" PRIu64 ", resourceID = %" PRIu64 ", isMainResource = %d, isSynchronous = %d)", m_parameters.webPageID, m_parameters.webFrameID, m_parameters.identifier, isMainResource(), isSynchronous());
 
@@ -266,6 +292,10 @@ void NetworkResourceLoader::setDefersLoading(bool defers)
         return;
     }
 
+    // The new state is picked up when the scheduler creates the network load.
+    if (NetworkProcess::singleton().networkLoadScheduler().isPending(*this))
+        return;
+
     if (!m_defersLoading)
         start();
     else
@@ -281,6 +311,7 @@ void NetworkResourceLoader::cleanup()
     invalidateSandboxExtensions();
 
     m_networkLoad = nullptr;
+    NetworkProcess::singleton().networkLoadScheduler().unschedule(*this);
 
     // This will cause NetworkResourceLoader to be destroyed and therefore we do it last.
     m_connection->didCleanupResourceLoader(*this);
@@ -290,6 +321,7 @@ void NetworkResourceLoader::convertToDownload(DownloadID downloadID, const Resou
 {
     ASSERT(m_networkLoad);
     NetworkProcess::singleton().downloadManager().convertNetworkLoadToDownload(downloadID, std::exchange(m_networkLoad, nullptr), WTFMove(m_fileReferences), request, response);
+    NetworkProcess::singleton().networkLoadScheduler().unschedule(*this);
 }
 
 void NetworkResourceLoader::abort()
@@ -393,6 +425,19 @@ void NetworkResourceLoader::didReceiveBuffer(Ref<SharedBuffer>&& buffer, int rep
         startBufferingTimerIfNeeded();
         return;
     }
+
+    if (shouldCoalesceData()) {
+        Seconds interval = minimumDataDeliveryInterval(originalRequest().priority());
+        Seconds timeSinceLastDelivery = MonotonicTime::now() - m_lastDataDeliveryTime;
+        if (timeSinceLastDelivery < interval) {
+            // The timer sends this and whatever else arrives in the meantime as one message.
+            m_bufferedData = SharedBuffer::create();
+            m_bufferedData->append(buffer.get());
+            m_bufferedDataEncodedDataLength = encodedDataLength;
+            m_bufferingTimer.startOneShot(interval - timeSinceLastDelivery);
+            return;
+        }
+    }
     sendBuffer(buffer, encodedDataLength);
 }
 
@@ -531,19 +576,31 @@ void NetworkResourceLoader::bufferingTimerFired()
     if (m_bufferedData->isEmpty())
         return;
 
-    IPC::SharedBufferDataReference dataReference(m_bufferedData.get());
+    auto bufferedData = WTFMove(m_bufferedData);
     size_t encodedLength = m_bufferedDataEncodedDataLength;
 
-    m_bufferedData = SharedBuffer::create();
+    // Coalesced loads go back to sending data right away once the burst is over.
+    if (m_parameters.maximumBufferingTime > 0_s)
+        m_bufferedData = SharedBuffer::create();
     m_bufferedDataEncodedDataLength = 0;
 
-    send(Messages::WebResourceLoader::DidReceiveData(dataReference, encodedLength));
+    sendBuffer(*bufferedData, encodedLength);
+}
+
+bool NetworkResourceLoader::shouldCoalesceData() const
+{
+    // The parser needs every byte of the main resource as soon as possible, and multipart
+    // responses replace their content with each part.
+    if (isSynchronous() || isMainResource() || m_response.isMultipart())
+        return false;
+    return minimumDataDeliveryInterval(originalRequest().priority()) > 0_s;
 }
 
 void NetworkResourceLoader::sendBuffer(SharedBuffer& buffer, size_t encodedDataLength)
 {
     ASSERT(!isSynchronous());
 
+    m_lastDataDeliveryTime = MonotonicTime::now();
     IPC::SharedBufferDataReference dataReference(&buffer);
     send(Messages::WebResourceLoader::DidReceiveData(dataReference, encodedDataLength));
 }
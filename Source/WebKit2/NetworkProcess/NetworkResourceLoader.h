@@ -30,9 +30,11 @@
 #include "MessageSender.h"
 #include "NetworkConnectionToWebProcessMessages.h"
 #include "NetworkLoadClient.h"
+#include "NetworkLoadScheduler.h"
 #include "NetworkResourceLoadParameters.h"
 #include "ShareableResource.h"
 #include <WebCore/Timer.h>
+#include <wtf/MonotonicTime.h>
 
 namespace WebCore {
 class BlobDataFileReference;
@@ -49,7 +51,7 @@ namespace NetworkCache {
 class Entry;
 }
 
-class NetworkResourceLoader final : public RefCounted<NetworkResourceLoader>, public NetworkLoadClient, public IPC::MessageSender {
+class NetworkResourceLoader final : public RefCounted<NetworkResourceLoader>, public NetworkLoadClient, public NetworkLoadSchedulerClient, public IPC::MessageSender {
 public:
     static Ref<NetworkResourceLoader> create(const NetworkResourceLoadParameters& parameters, NetworkConnectionToWebProcess& connection, RefPtr<Messages::NetworkConnectionToWebProcess::PerformSynchronousLoad::DelayedReply>&& reply = nullptr)
     {
@@ -80,7 +82,7 @@ public:
     WebCore::SessionID sessionID() const { return m_parameters.sessionID; }
     ResourceLoadIdentifier identifier() const { return m_parameters.identifier; }
     uint64_t frameID() const { return m_parameters.webFrameID; }
-    uint64_t pageID() const { return m_parameters.webPageID; }
+    uint64_t pageID() const override { return m_parameters.webPageID; }
 
     struct SynchronousLoadData;
 
@@ -99,6 +101,9 @@ public:
 
     void convertToDownload(DownloadID, const WebCore::ResourceRequest&, const WebCore::ResourceResponse&);
 
+    // NetworkLoadSchedulerClient
+    void startScheduledNetworkLoad(const WebCore::ResourceRequest&) override;
+
     bool isMainResource() const { return m_parameters.request.requester() == WebCore::ResourceRequest::Requester::Main; }
     bool isAlwaysOnLoggingAllowed() const;
 
@@ -130,6 +135,7 @@ private:
 
     void startBufferingTimerIfNeeded();
     void bufferingTimerFired();
+    bool shouldCoalesceData() const;
     void sendBuffer(WebCore::SharedBuffer&, size_t encodedDataLength);
 
     void consumeSandboxExtensions();
@@ -158,6 +164,7 @@ private:
     unsigned m_retrievedDerivedDataCount { 0 };
 
     WebCore::Timer m_bufferingTimer;
+    MonotonicTime m_lastDataDeliveryTime;
 #if ENABLE(NETWORK_CACHE)
     RefPtr<WebCore::SharedBuffer> m_bufferedDataForCache;
     std::unique_ptr<NetworkCache::Entry> m_cacheEntryForValidation;
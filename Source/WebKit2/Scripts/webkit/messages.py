@@ -352,6 +352,7 @@ def headers_for_type(type):
 
     special_cases = {
         'String': ['<wtf/text/WTFString.h>'],
+        'JSC::SamplingProfileFormat': ['<JavaScriptCore/SamplingProfilerExporter.h>'],
         'WebCore::AutoplayEventFlags': ['<WebCore/AutoplayEvent.h>'],
         'WebCore::ExceptionDetails': ['<WebCore/JSDOMExceptionHandling.h>'],
         'WebCore::FileChooserSettings': ['<WebCore/FileChooser.h>'],
@@ -35,7 +35,7 @@
 
 namespace WebKit {
 
-void calculateMemoryCacheSizes(CacheModel cacheModel, unsigned& cacheTotalCapacity, unsigned& cacheMinDeadCapacity, unsigned& cacheMaxDeadCapacity, Seconds& deadDecodedDataDeletionInterval, unsigned& pageCacheCapacity)
+void calculateMemoryCacheSizes(CacheModel cacheModel, unsigned& cacheTotalCapacity, unsigned& cacheMinDeadCapacity, unsigned& cacheMaxDeadCapacity, Seconds& deadDecodedDataDeletionInterval, unsigned& pageCacheCapacity, size_t& pageCacheMemoryCapacity)
 {
     // Note: urlCacheDiskCapacity can be overridden by the WPE_DISK_CACHE_SIZE environment variable (see below).
 
@@ -70,6 +70,16 @@ void calculateMemoryCacheSizes(CacheModel cacheModel, unsigned& cacheTotalCapaci
         else
             pageCacheCapacity = 0;
 
+        // Page cache memory capacity (in bytes)
+        if (memorySize >= 2048)
+            pageCacheMemoryCapacity = 256 * MB;
+        else if (memorySize >= 1024)
+            pageCacheMemoryCapacity = 96 * MB;
+        else if (memorySize >= 512)
+            pageCacheMemoryCapacity = 48 * MB;
+        else
+            pageCacheMemoryCapacity = 24 * MB;
+
         // Object cache capacities (in bytes)
         if (memorySize >= 2048)
             cacheTotalCapacity = 96 * MB;
@@ -94,6 +104,16 @@ void calculateMemoryCacheSizes(CacheModel cacheModel, unsigned& cacheTotalCapaci
         else
             pageCacheCapacity = 0;
 
+        // Page cache memory capacity (in bytes)
+        if (memorySize >= 2048)
+            pageCacheMemoryCapacity = 256 * MB;
+        else if (memorySize >= 1024)
+            pageCacheMemoryCapacity = 96 * MB;
+        else if (memorySize >= 512)
+            pageCacheMemoryCapacity = 48 * MB;
+        else
+            pageCacheMemoryCapacity = 24 * MB;
+
         // Object cache capacities (in bytes)
         // (Testing indicates that value / MB depends heavily on content and
         // browsing pattern. Even growth above 128MB can have substantial
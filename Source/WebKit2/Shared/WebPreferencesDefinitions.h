@@ -248,6 +248,12 @@
     macro(ServiceControlsEnabled, serviceControlsEnabled, Bool, bool, false, "", "") \
     macro(NewBlockInsideInlineModelEnabled, newBlockInsideInlineModelEnabled, Bool, bool, false, "", "") \
     macro(DeferredCSSParserEnabled, deferredCSSParserEnabled, Bool, bool, false, "", "") \
+    macro(ThreadedHTMLTokenizerEnabled, threadedHTMLTokenizerEnabled, Bool, bool, false, "", "") \
+    macro(ParallelStyleResolutionEnabled, parallelStyleResolutionEnabled, Bool, bool, false, "", "") \
+    macro(ThreadedCSSTokenizerEnabled, threadedCSSTokenizerEnabled, Bool, bool, false, "", "") \
+    macro(SelectorQueryResultCacheEnabled, selectorQueryResultCacheEnabled, Bool, bool, false, "", "") \
+    macro(BudgetedLayoutDuringLoadEnabled, budgetedLayoutDuringLoadEnabled, Bool, bool, false, "", "") \
+    macro(FlexLayoutCacheEnabled, flexLayoutCacheEnabled, Bool, bool, false, "", "") \
     macro(HTTPEquivEnabled, httpEquivEnabled, Bool, bool, true, "", "") \
     macro(MockCaptureDevicesEnabled, mockCaptureDevicesEnabled, Bool, bool, false, "", "") \
     macro(MediaCaptureRequiresSecureConnection, mediaCaptureRequiresSecureConnection, Bool, bool, true, "", "") \
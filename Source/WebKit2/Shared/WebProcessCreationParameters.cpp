@@ -87,6 +87,8 @@ void WebProcessCreationParameters::encode(IPC::Encoder& encoder) const
     encoder << shouldEnableMemoryPressureReliefLogging;
     encoder << shouldSuppressMemoryPressureHandler;
     encoder << shouldUseFontSmoothing;
+    encoder << javaScriptSoftMemoryBudget;
+    encoder << javaScriptHardMemoryBudget;
     encoder << resourceLoadStatisticsEnabled;
     encoder << fontWhitelist;
     encoder << iconDatabaseEnabled;
@@ -228,6 +230,10 @@ bool WebProcessCreationParameters::decode(IPC::Decoder& decoder, WebProcessCreat
         return false;
     if (!decoder.decode(parameters.shouldUseFontSmoothing))
         return false;
+    if (!decoder.decode(parameters.javaScriptSoftMemoryBudget))
+        return false;
+    if (!decoder.decode(parameters.javaScriptHardMemoryBudget))
+        return false;
     if (!decoder.decode(parameters.resourceLoadStatisticsEnabled))
         return false;
     if (!decoder.decode(parameters.fontWhitelist))
@@ -116,6 +116,8 @@ struct WebProcessCreationParameters {
     bool shouldEnableMemoryPressureReliefLogging { false };
     bool shouldSuppressMemoryPressureHandler { false };
     bool shouldUseFontSmoothing { true };
+    uint64_t javaScriptSoftMemoryBudget { 0 };
+    uint64_t javaScriptHardMemoryBudget { 0 };
     bool resourceLoadStatisticsEnabled { false };
     bool iconDatabaseEnabled { false };
     bool fullKeyboardAccessEnabled { false };
@@ -338,6 +338,11 @@ void WKContextSetAlwaysUsesComplexTextCodePath(WKContextRef contextRef, bool alw
     toImpl(contextRef)->setAlwaysUsesComplexTextCodePath(alwaysUseComplexTextCodePath);
 }
 
+void WKContextSetJavaScriptMemoryBudget(WKContextRef contextRef, uint64_t softLimit, uint64_t hardLimit)
+{
+    toImpl(contextRef)->setJavaScriptMemoryBudget(softLimit, hardLimit);
+}
+
 void WKContextSetShouldUseFontSmoothing(WKContextRef contextRef, bool useFontSmoothing)
 {
     toImpl(contextRef)->setShouldUseFontSmoothing(useFontSmoothing);
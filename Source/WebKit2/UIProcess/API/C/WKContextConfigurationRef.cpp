@@ -146,3 +146,13 @@ void WKContextConfigurationSetShouldCaptureAudioInUIProcess(WKContextConfigurati
 {
     toImpl(configuration)->setShouldCaptureAudioInUIProcess(should);
 }
+
+unsigned WKContextConfigurationPrewarmedProcessCount(WKContextConfigurationRef configuration)
+{
+    return toImpl(configuration)->prewarmedProcessCount();
+}
+
+void WKContextConfigurationSetPrewarmedProcessCount(WKContextConfigurationRef configuration, unsigned count)
+{
+    toImpl(configuration)->setPrewarmedProcessCount(count);
+}
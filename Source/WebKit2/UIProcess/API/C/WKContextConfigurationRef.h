@@ -65,6 +65,9 @@ WK_EXPORT void WKContextConfigurationSetOverrideLanguages(WKContextConfiguration
 WK_EXPORT bool WKContextConfigurationShouldCaptureAudioInUIProcess(WKContextConfigurationRef configuration);
 WK_EXPORT void WKContextConfigurationSetShouldCaptureAudioInUIProcess(WKContextConfigurationRef configuration, bool allowed);
 
+WK_EXPORT unsigned WKContextConfigurationPrewarmedProcessCount(WKContextConfigurationRef configuration);
+WK_EXPORT void WKContextConfigurationSetPrewarmedProcessCount(WKContextConfigurationRef configuration, unsigned count);
+
 #ifdef __cplusplus
 }
 #endif
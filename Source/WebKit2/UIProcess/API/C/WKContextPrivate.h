@@ -50,6 +50,9 @@ WK_EXPORT void WKContextSetAlwaysUsesComplexTextCodePath(WKContextRef context, b
 
 WK_EXPORT void WKContextSetShouldUseFontSmoothing(WKContextRef context, bool useFontSmoothing);
 
+/* Budgets the JavaScript heap of every web process, in bytes. Above the soft limit the collector runs more often; close to the hard limit it discards compiled code and collects synchronously. 0 means no limit. */
+WK_EXPORT void WKContextSetJavaScriptMemoryBudget(WKContextRef context, uint64_t softLimit, uint64_t hardLimit);
+
 WK_EXPORT void WKContextRegisterURLSchemeAsSecure(WKContextRef context, WKStringRef urlScheme);
 
 WK_EXPORT void WKContextRegisterURLSchemeAsBypassingContentSecurityPolicy(WKContextRef context, WKStringRef urlScheme);
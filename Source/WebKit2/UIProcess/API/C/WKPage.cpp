@@ -76,6 +76,7 @@
 #include "WebProtectionSpace.h"
 #include "WKProxy.h"
 #include "WKType.h"
+#include <JavaScriptCore/SamplingProfilerExporter.h>
 #include <WebCore/Page.h>
 #include <WebCore/SecurityOriginData.h>
 #include <WebCore/SerializedCryptoKeyWrap.h>
@@ -2572,6 +2573,17 @@ void WKPageGetSamplingProfilerOutput(WKPageRef pageRef, void* context, WKPageGet
     toImpl(pageRef)->getSamplingProfilerOutput(toGenericCallbackFunction(context, callback));
 }
 
+void WKPageStartSamplingProfilerExport(WKPageRef pageRef, WKStringRef directory, WKSamplingProfileFormat format, unsigned sampleIntervalInMicroseconds, unsigned flushIntervalInMilliseconds)
+{
+    auto samplingProfileFormat = format == kWKSamplingProfileFormatPProf ? JSC::SamplingProfileFormat::PProf : JSC::SamplingProfileFormat::CollapsedStacks;
+    toImpl(pageRef)->startSamplingProfilerExport(toWTFString(directory), samplingProfileFormat, sampleIntervalInMicroseconds, flushIntervalInMilliseconds);
+}
+
+void WKPageStopSamplingProfilerExport(WKPageRef pageRef)
+{
+    toImpl(pageRef)->stopSamplingProfilerExport();
+}
+
 void WKPageIsWebProcessResponsive(WKPageRef pageRef, void* context, WKPageIsWebProcessResponsiveFunction callback)
 {
     toImpl(pageRef)->isWebProcessResponsive([context, callback](bool isWebProcessResponsive) {
@@ -96,6 +96,20 @@ WK_EXPORT void WKPageGetBytecodeProfile(WKPageRef page, void* context, WKPageGet
 typedef void (*WKPageGetSamplingProfilerOutputFunction)(WKStringRef, WKErrorRef, void*);
 WK_EXPORT void WKPageGetSamplingProfilerOutput(WKPageRef page, void* context, WKPageGetSamplingProfilerOutputFunction function);
 
+enum {
+    kWKSamplingProfileFormatCollapsedStacks,
+    kWKSamplingProfileFormatPProf
+};
+typedef uint32_t WKSamplingProfileFormat;
+
+// Continuously samples the JavaScript executed by the page's web process and periodically writes
+// the aggregated stacks to a new file in the given directory. Since the web process has a single
+// JavaScript VM, this also profiles the other pages sharing the process. Intervals without samples
+// are not written, and past the JSC samplingProfilerExportMaxFiles option the oldest file is
+// overwritten. Stopping leaves the sampling profiler as it was before the export started.
+WK_EXPORT void WKPageStartSamplingProfilerExport(WKPageRef page, WKStringRef directory, WKSamplingProfileFormat format, unsigned sampleIntervalInMicroseconds, unsigned flushIntervalInMilliseconds);
+WK_EXPORT void WKPageStopSamplingProfilerExport(WKPageRef page);
+
 typedef void (*WKPageIsWebProcessResponsiveFunction)(bool isWebProcessResponsive, void* context);
 WK_EXPORT void WKPageIsWebProcessResponsive(WKPageRef page, void* context, WKPageIsWebProcessResponsiveFunction function);
     
@@ -1321,6 +1321,66 @@ bool WKPreferencesGetDeferredCSSParserEnabled(WKPreferencesRef preferencesRef)
     return toImpl(preferencesRef)->deferredCSSParserEnabled();
 }
 
+void WKPreferencesSetThreadedHTMLTokenizerEnabled(WKPreferencesRef preferencesRef, bool flag)
+{
+    toImpl(preferencesRef)->setThreadedHTMLTokenizerEnabled(flag);
+}
+
+bool WKPreferencesGetThreadedHTMLTokenizerEnabled(WKPreferencesRef preferencesRef)
+{
+    return toImpl(preferencesRef)->threadedHTMLTokenizerEnabled();
+}
+
+void WKPreferencesSetParallelStyleResolutionEnabled(WKPreferencesRef preferencesRef, bool flag)
+{
+    toImpl(preferencesRef)->setParallelStyleResolutionEnabled(flag);
+}
+
+bool WKPreferencesGetParallelStyleResolutionEnabled(WKPreferencesRef preferencesRef)
+{
+    return toImpl(preferencesRef)->parallelStyleResolutionEnabled();
+}
+
+void WKPreferencesSetThreadedCSSTokenizerEnabled(WKPreferencesRef preferencesRef, bool flag)
+{
+    toImpl(preferencesRef)->setThreadedCSSTokenizerEnabled(flag);
+}
+
+bool WKPreferencesGetThreadedCSSTokenizerEnabled(WKPreferencesRef preferencesRef)
+{
+    return toImpl(preferencesRef)->threadedCSSTokenizerEnabled();
+}
+
+void WKPreferencesSetSelectorQueryResultCacheEnabled(WKPreferencesRef preferencesRef, bool flag)
+{
+    toImpl(preferencesRef)->setSelectorQueryResultCacheEnabled(flag);
+}
+
+bool WKPreferencesGetSelectorQueryResultCacheEnabled(WKPreferencesRef preferencesRef)
+{
+    return toImpl(preferencesRef)->selectorQueryResultCacheEnabled();
+}
+
+void WKPreferencesSetBudgetedLayoutDuringLoadEnabled(WKPreferencesRef preferencesRef, bool flag)
+{
+    toImpl(preferencesRef)->setBudgetedLayoutDuringLoadEnabled(flag);
+}
+
+bool WKPreferencesGetBudgetedLayoutDuringLoadEnabled(WKPreferencesRef preferencesRef)
+{
+    return toImpl(preferencesRef)->budgetedLayoutDuringLoadEnabled();
+}
+
+void WKPreferencesSetFlexLayoutCacheEnabled(WKPreferencesRef preferencesRef, bool flag)
+{
+    toImpl(preferencesRef)->setFlexLayoutCacheEnabled(flag);
+}
+
+bool WKPreferencesGetFlexLayoutCacheEnabled(WKPreferencesRef preferencesRef)
+{
+    return toImpl(preferencesRef)->flexLayoutCacheEnabled();
+}
+
 void WKPreferencesSetSubpixelCSSOMElementMetricsEnabled(WKPreferencesRef preferencesRef, bool flag)
 {
     toImpl(preferencesRef)->setSubpixelCSSOMElementMetricsEnabled(flag);
@@ -335,6 +335,30 @@ WK_EXPORT bool WKPreferencesGetNewBlockInsideInlineModelEnabled(WKPreferencesRef
 WK_EXPORT void WKPreferencesSetDeferredCSSParserEnabled(WKPreferencesRef, bool);
 WK_EXPORT bool WKPreferencesGetDeferredCSSParserEnabled(WKPreferencesRef);
 
+// Defaults to false.
+WK_EXPORT void WKPreferencesSetThreadedHTMLTokenizerEnabled(WKPreferencesRef, bool);
+WK_EXPORT bool WKPreferencesGetThreadedHTMLTokenizerEnabled(WKPreferencesRef);
+
+// Defaults to false.
+WK_EXPORT void WKPreferencesSetParallelStyleResolutionEnabled(WKPreferencesRef, bool);
+WK_EXPORT bool WKPreferencesGetParallelStyleResolutionEnabled(WKPreferencesRef);
+
+// Defaults to false.
+WK_EXPORT void WKPreferencesSetThreadedCSSTokenizerEnabled(WKPreferencesRef, bool);
+WK_EXPORT bool WKPreferencesGetThreadedCSSTokenizerEnabled(WKPreferencesRef);
+
+// Defaults to false.
+WK_EXPORT void WKPreferencesSetSelectorQueryResultCacheEnabled(WKPreferencesRef, bool);
+WK_EXPORT bool WKPreferencesGetSelectorQueryResultCacheEnabled(WKPreferencesRef);
+
+// Defaults to false.
+WK_EXPORT void WKPreferencesSetBudgetedLayoutDuringLoadEnabled(WKPreferencesRef, bool);
+WK_EXPORT bool WKPreferencesGetBudgetedLayoutDuringLoadEnabled(WKPreferencesRef);
+
+// Defaults to false.
+WK_EXPORT void WKPreferencesSetFlexLayoutCacheEnabled(WKPreferencesRef, bool);
+WK_EXPORT bool WKPreferencesGetFlexLayoutCacheEnabled(WKPreferencesRef);
+
 // Defaults to false.
 WK_EXPORT void WKPreferencesSetSubpixelCSSOMElementMetricsEnabled(WKPreferencesRef, bool);
 WK_EXPORT bool WKPreferencesGetSubpixelCSSOMElementMetricsEnabled(WKPreferencesRef);
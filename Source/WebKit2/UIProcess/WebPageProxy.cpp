@@ -2955,6 +2955,22 @@ void WebPageProxy::getSamplingProfilerOutput(std::function<void (const String&,
     m_process->send(Messages::WebPage::GetSamplingProfilerOutput(callbackID), m_pageID);
 }
 
+void WebPageProxy::startSamplingProfilerExport(const String& directory, JSC::SamplingProfileFormat format, uint32_t sampleIntervalInMicroseconds, uint32_t flushIntervalInMilliseconds)
+{
+    if (!isValid())
+        return;
+
+    m_process->send(Messages::WebPage::StartSamplingProfilerExport(directory, format, sampleIntervalInMicroseconds, flushIntervalInMilliseconds), m_pageID);
+}
+
+void WebPageProxy::stopSamplingProfilerExport()
+{
+    if (!isValid())
+        return;
+
+    m_process->send(Messages::WebPage::StopSamplingProfilerExport(), m_pageID);
+}
+
 void WebPageProxy::isWebProcessResponsive(std::function<void (bool isWebProcessResponsive)> callbackFunction)
 {
     if (!isValid()) {
@@ -150,6 +150,10 @@ class Decoder;
 class Connection;
 }
 
+namespace JSC {
+enum class SamplingProfileFormat;
+}
+
 namespace WebCore {
 class AuthenticationChallenge;
 class Cursor;
@@ -787,6 +791,8 @@ public:
     void getContentsAsString(std::function<void (const String&, CallbackBase::Error)>);
     void getBytecodeProfile(std::function<void (const String&, CallbackBase::Error)>);
     void getSamplingProfilerOutput(std::function<void (const String&, CallbackBase::Error)>);
+    void startSamplingProfilerExport(const String& directory, JSC::SamplingProfileFormat, uint32_t sampleIntervalInMicroseconds, uint32_t flushIntervalInMilliseconds);
+    void stopSamplingProfilerExport();
     void isWebProcessResponsive(std::function<void (bool isWebProcessResponsive)>);
 
 #if ENABLE(MHTML)
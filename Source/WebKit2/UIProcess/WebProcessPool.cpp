@@ -216,7 +216,7 @@ static HashSet<String, ASCIICaseInsensitiveHash>& globalURLSchemesWithCustomProt
 
 WebProcessPool::WebProcessPool(API::ProcessPoolConfiguration& configuration)
     : m_configuration(configuration.copy())
-    , m_haveInitialEmptyProcess(false)
+    , m_prewarmedProcessRefillTimer(RunLoop::main(), this, &WebProcessPool::refillPrewarmedProcesses)
     , m_processWithPageCache(0)
     , m_defaultPageGroup(WebPageGroup::createNonNull())
     , m_automationClient(std::make_unique<API::AutomationClient>())
@@ -283,6 +283,10 @@ WebProcessPool::WebProcessPool(API::ProcessPoolConfiguration& configuration)
 #endif
 
     notifyThisWebProcessPoolWasCreated();
+
+    // Launch the prewarmed processes once the client had a chance to finish configuring the pool.
+    if (m_configuration->prewarmedProcessCount())
+        m_prewarmedProcessRefillTimer.startOneShot(0_s);
 }
 
 #if !PLATFORM(COCOA) && !PLATFORM(GTK) && !PLATFORM(WPE)
@@ -704,6 +708,8 @@ WebProcessProxy& WebProcessPool::createNewWebProcess(WebsiteDataStore& websiteDa
 
     parameters.shouldAlwaysUseComplexTextCodePath = m_alwaysUsesComplexTextCodePath;
     parameters.shouldUseFontSmoothing = m_shouldUseFontSmoothing;
+    parameters.javaScriptSoftMemoryBudget = m_javaScriptSoftMemoryBudget;
+    parameters.javaScriptHardMemoryBudget = m_javaScriptHardMemoryBudget;
 
     parameters.iconDatabaseEnabled = !iconDatabasePath().isEmpty();
 
@@ -789,7 +795,7 @@ WebProcessProxy& WebProcessPool::createNewWebProcess(WebsiteDataStore& websiteDa
 
 void WebProcessPool::warmInitialProcess()  
 {
-    if (m_haveInitialEmptyProcess) {
+    if (!m_prewarmedProcesses.isEmpty()) {
         ASSERT(!m_processes.isEmpty());
         return;
     }
@@ -797,8 +803,47 @@ void WebProcessPool::warmInitialProcess()
     if (m_processes.size() >= maximumNumberOfProcesses())
         return;
 
-    createNewWebProcess(m_websiteDataStore->websiteDataStore());
-    m_haveInitialEmptyProcess = true;
+    launchPrewarmedProcess();
+}
+
+void WebProcessPool::launchPrewarmedProcess()
+{
+    auto& process = createNewWebProcess(m_websiteDataStore->websiteDataStore());
+    process.send(Messages::WebProcess::PrewarmGlobally(), 0);
+    m_prewarmedProcesses.append(&process);
+}
+
+WebProcessProxy* WebProcessPool::takePrewarmedProcess(WebsiteDataStore& websiteDataStore)
+{
+    // Prewarmed processes are launched with the default data store, so pages using another one,
+    // e.g. ephemeral sessions, do not get them. The oldest matching process is the most likely
+    // to have finished launching.
+    for (size_t i = 0; i < m_prewarmedProcesses.size(); ++i) {
+        if (&m_prewarmedProcesses[i]->websiteDataStore() != &websiteDataStore)
+            continue;
+        auto* process = m_prewarmedProcesses[i].get();
+        m_prewarmedProcesses.remove(i);
+        m_prewarmedProcessExitCount = 0;
+        m_prewarmedProcessRefillTimer.startOneShot(0_s);
+        return process;
+    }
+    return nullptr;
+}
+
+void WebProcessPool::refillPrewarmedProcesses()
+{
+    // Launch one process per iteration so that the process launches interleave with the
+    // work of the page that just took a prewarmed process.
+    if (m_prewarmedProcesses.size() >= m_configuration->prewarmedProcessCount())
+        return;
+
+    if (m_processes.size() >= maximumNumberOfProcesses())
+        return;
+
+    launchPrewarmedProcess();
+
+    if (m_prewarmedProcesses.size() < m_configuration->prewarmedProcessCount())
+        m_prewarmedProcessRefillTimer.startOneShot(0_s);
 }
 
 void WebProcessPool::enableProcessTermination()
@@ -818,6 +863,10 @@ bool WebProcessPool::shouldTerminate(WebProcessProxy* process)
     if (!m_processTerminationEnabled)
         return false;
 
+    // Prewarmed processes have never hosted a page, keep them around until one is needed.
+    if (m_prewarmedProcesses.contains(process))
+        return false;
+
     return true;
 }
 
@@ -854,8 +903,14 @@ void WebProcessPool::disconnectProcess(WebProcessProxy* process)
 {
     ASSERT(m_processes.contains(process));
 
-    if (m_haveInitialEmptyProcess && process == m_processes.last())
-        m_haveInitialEmptyProcess = false;
+    if (m_prewarmedProcesses.removeFirst(process) && m_configuration->prewarmedProcessCount()) {
+        // A prewarmed process that exits before hosting a page is likely crashing during launch,
+        // so its replacement would too. Double the delay before relaunching after every such exit.
+        static const unsigned maximumPrewarmedProcessRelaunchDelayExponent = 6;
+        Seconds delay = 1_s * (1 << std::min(m_prewarmedProcessExitCount, maximumPrewarmedProcessRelaunchDelayExponent));
+        m_prewarmedProcessExitCount++;
+        m_prewarmedProcessRefillTimer.startOneShot(delay);
+    }
 
     // FIXME (Multi-WebProcess): <rdar://problem/12239765> Some of the invalidation calls of the other supplements are still necessary in multi-process mode, but they should only affect data structures pertaining to the process being disconnected.
     // Clearing everything causes assertion failures, so it's less trouble to skip that for now.
@@ -926,15 +981,18 @@ Ref<WebPageProxy> WebProcessPool::createWebPage(PageClient& pageClient, Ref<API:
     }
 
     RefPtr<WebProcessProxy> process;
-    if (m_haveInitialEmptyProcess) {
-        process = m_processes.last();
-        m_haveInitialEmptyProcess = false;
-    } else if (pageConfiguration->relatedPage()) {
+    if (pageConfiguration->relatedPage()) {
         // Sharing processes, e.g. when creating the page via window.open().
         process = &pageConfiguration->relatedPage()->process();
-    } else
+    } else if (auto* prewarmedProcess = takePrewarmedProcess(pageConfiguration->websiteDataStore()->websiteDataStore()))
+        process = prewarmedProcess;
+    else
         process = &createNewWebProcessRespectingProcessCountLimit(pageConfiguration->websiteDataStore()->websiteDataStore());
 
+    // Once the process limit is reached an existing process may be picked, which could be a prewarmed one.
+    if (m_prewarmedProcesses.removeFirst(process.get()))
+        m_prewarmedProcessRefillTimer.startOneShot(0_s);
+
     return process->createWebPage(pageClient, WTFMove(pageConfiguration));
 }
 
@@ -1083,6 +1141,13 @@ void WebProcessPool::setAlwaysUsesComplexTextCodePath(bool alwaysUseComplexText)
     sendToAllProcesses(Messages::WebProcess::SetAlwaysUsesComplexTextCodePath(alwaysUseComplexText));
 }
 
+void WebProcessPool::setJavaScriptMemoryBudget(uint64_t softLimit, uint64_t hardLimit)
+{
+    m_javaScriptSoftMemoryBudget = softLimit;
+    m_javaScriptHardMemoryBudget = hardLimit;
+    sendToAllProcesses(Messages::WebProcess::SetJavaScriptMemoryBudget(softLimit, hardLimit));
+}
+
 void WebProcessPool::setShouldUseFontSmoothing(bool useFontSmoothing)
 {
     m_shouldUseFontSmoothing = useFontSmoothing;
@@ -205,6 +205,7 @@ public:
 
     void setAlwaysUsesComplexTextCodePath(bool);
     void setShouldUseFontSmoothing(bool);
+    void setJavaScriptMemoryBudget(uint64_t softLimit, uint64_t hardLimit);
     
     void registerURLSchemeAsEmptyDocument(const String&);
     void registerURLSchemeAsSecure(const String&);
@@ -421,6 +422,9 @@ private:
     void platformInvalidateContext();
 
     WebProcessProxy& createNewWebProcess(WebsiteDataStore&);
+    void launchPrewarmedProcess();
+    WebProcessProxy* takePrewarmedProcess(WebsiteDataStore&);
+    void refillPrewarmedProcesses();
 
     void requestWebContentStatistics(StatisticsRequest*);
     void requestNetworkingStatistics(StatisticsRequest*);
@@ -478,7 +482,11 @@ private:
     IPC::MessageReceiverMap m_messageReceiverMap;
 
     Vector<RefPtr<WebProcessProxy>> m_processes;
-    bool m_haveInitialEmptyProcess;
+    // Processes that have been launched ahead of time and do not host any page yet.
+    Vector<RefPtr<WebProcessProxy>> m_prewarmedProcesses;
+    RunLoop::Timer<WebProcessPool> m_prewarmedProcessRefillTimer;
+    // Prewarmed processes that exited since a page last took one, used to back off relaunches.
+    unsigned m_prewarmedProcessExitCount { 0 };
 
     WebProcessProxy* m_processWithPageCache;
 
@@ -518,6 +526,9 @@ private:
     bool m_alwaysUsesComplexTextCodePath;
     bool m_shouldUseFontSmoothing;
 
+    uint64_t m_javaScriptSoftMemoryBudget { 0 };
+    uint64_t m_javaScriptHardMemoryBudget { 0 };
+
     Vector<String> m_fontWhitelist;
 
     // Messages that were posted before any pages were created.
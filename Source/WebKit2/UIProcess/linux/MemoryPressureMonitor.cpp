@@ -31,7 +31,9 @@
 #include "Attachment.h"
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <mutex>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/eventfd.h>
@@ -39,8 +41,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <wtf/CurrentTime.h>
+#include <wtf/MemoryPressureHandler.h>
 #include <wtf/Threading.h>
 #include <wtf/UniStdExtras.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/StringConcatenate.h>
 
 namespace WebKit {
 
@@ -51,6 +56,7 @@ static const double s_maxPollingIntervalInSeconds = 5;
 static const double s_minUsedMemoryPercentageForPolling = 50;
 static const double s_maxUsedMemoryPercentageForPolling = 90;
 static const int s_memoryPresurePercentageThreshold = 95;
+static const double s_memoryPressureStallPercentageThreshold = 10;
 
 static size_t lowWatermarkPages()
 {
@@ -198,6 +204,77 @@ static int systemMemoryUsedAsPercentage()
     return ((memoryTotal - memoryAvailable) * 100) / memoryTotal;
 }
 
+// Percentage of the last 10 seconds some task was stalled waiting for memory, or -1 if the kernel
+// doesn't provide pressure stall information.
+static double memoryStallPercentage()
+{
+    FILE* file = fopen("/proc/pressure/memory", "r");
+    if (!file)
+        return -1;
+
+    double some = -1;
+    char buffer[128];
+    while (char* line = fgets(buffer, 128, file)) {
+        if (!strncmp(line, "some ", 5)) {
+            sscanf(line, "some avg10=%lf", &some);
+            break;
+        }
+    }
+    fclose(file);
+
+    return some;
+}
+
+// Path of the memory.events file of our cgroup in the unified (v2) hierarchy, or an empty
+// string when the memory controller isn't available there.
+static CString cgroupMemoryEventsPath()
+{
+    FILE* file = fopen("/proc/self/cgroup", "r");
+    if (!file)
+        return { };
+
+    CString path;
+    char buffer[PATH_MAX];
+    while (char* line = fgets(buffer, PATH_MAX, file)) {
+        if (strncmp(line, "0::", 3))
+            continue;
+        char* cgroup = line + 3;
+        cgroup[strcspn(cgroup, "\n")] = '\0';
+        path = makeString("/sys/fs/cgroup", cgroup, "/memory.events").utf8();
+        break;
+    }
+    fclose(file);
+
+    if (path.isNull() || access(path.data(), R_OK))
+        return { };
+    return path;
+}
+
+// Number of times our cgroup went over memory.high, or notSet.
+static size_t cgroupMemoryHighEventCount(const CString& memoryEventsPath)
+{
+    if (memoryEventsPath.isNull())
+        return notSet;
+
+    FILE* file = fopen(memoryEventsPath.data(), "r");
+    if (!file)
+        return notSet;
+
+    size_t count = notSet;
+    char buffer[128];
+    while (char* line = fgets(buffer, 128, file)) {
+        char* token = strtok(line, " ");
+        if (!token || strcmp(token, "high"))
+            continue;
+        if ((token = strtok(nullptr, " ")))
+            count = atoll(token);
+        break;
+    }
+    fclose(file);
+
+    return count;
+}
+
 static inline double pollIntervalForUsedMemoryPercentage(int usedPercentage)
 {
     // Use a different poll interval depending on the currently memory used,
@@ -250,6 +327,8 @@ MemoryPressureMonitor::MemoryPressureMonitor()
 
     RefPtr<Thread> thread = Thread::create("MemoryPressureMonitor", [this] {
         double pollInterval = s_maxPollingIntervalInSeconds;
+        CString memoryEventsPath = cgroupMemoryEventsPath();
+        size_t memoryHighEventCount = cgroupMemoryHighEventCount(memoryEventsPath);
         while (true) {
             sleep(pollInterval);
 
@@ -259,8 +338,20 @@ MemoryPressureMonitor::MemoryPressureMonitor()
                 break;
             }
 
-            if (usedPercentage >= s_memoryPresurePercentageThreshold) {
-                uint64_t fdEvent = 1;
+            size_t previousMemoryHighEventCount = memoryHighEventCount;
+            memoryHighEventCount = cgroupMemoryHighEventCount(memoryEventsPath);
+
+            MemoryPressureLevel level = MemoryPressureLevel::None;
+            if (usedPercentage >= s_memoryPresurePercentageThreshold)
+                level = MemoryPressureLevel::Critical;
+            else if (memoryHighEventCount != notSet && previousMemoryHighEventCount != notSet && memoryHighEventCount > previousMemoryHighEventCount)
+                level = MemoryPressureLevel::Medium;
+            else if (memoryStallPercentage() >= s_memoryPressureStallPercentageThreshold)
+                level = MemoryPressureLevel::Low;
+
+            // The value written tells the web processes how serious the pressure is.
+            uint64_t fdEvent = MemoryPressureHandler::memoryPressureMonitorEventValue(level);
+            if (fdEvent) {
                 ssize_t bytesWritten = write(m_eventFD, &fdEvent, sizeof(uint64_t));
                 if (bytesWritten != sizeof(uint64_t)) {
                     WTFLogAlways("Error writing to MemoryPressureMonitor eventFD: %s", strerror(errno));
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "JavaScriptGCPauseHistogram.h"
+
+#include <JavaScriptCore/APICast.h>
+#include <JavaScriptCore/VM.h>
+#include <wtf/text/StringBuilder.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebKit {
+
+static const char* const bucketNames[] = { "Under1ms", "1To2ms", "2To4ms", "4To8ms", "8To16ms", "16To32ms", "32To64ms", "Over64ms" };
+
+static size_t bucketForPause(double milliseconds)
+{
+    size_t bucket = 0;
+    for (double limit = 1; bucket < WTF_ARRAY_LENGTH(bucketNames) - 1 && milliseconds >= limit; limit *= 2)
+        ++bucket;
+    return bucket;
+}
+
+JavaScriptGCPauseHistogram::~JavaScriptGCPauseHistogram()
+{
+    if (!m_vm)
+        return;
+
+    JSContextGroupRemoveGarbageCollectionEventCallback(toRef(m_vm), didGarbageCollect, this);
+}
+
+void JavaScriptGCPauseHistogram::startObserving(JSC::VM& vm)
+{
+    ASSERT(!m_vm);
+    m_vm = &vm;
+    JSContextGroupAddGarbageCollectionEventCallback(toRef(m_vm), didGarbageCollect, this);
+}
+
+void JavaScriptGCPauseHistogram::didGarbageCollect(JSContextGroupRef, const JSGarbageCollectionEvent* event, void* userData)
+{
+    static_cast<JavaScriptGCPauseHistogram*>(userData)->record(*event);
+}
+
+void JavaScriptGCPauseHistogram::record(const JSGarbageCollectionEvent& event)
+{
+    if (event.isFullCollection)
+        m_fullCollections.record(event);
+    else
+        m_edenCollections.record(event);
+}
+
+void JavaScriptGCPauseHistogram::Collections::record(const JSGarbageCollectionEvent& event)
+{
+    double maxPause = event.maxPauseDuration * 1000;
+    maxPauseBuckets[bucketForPause(maxPause)]++;
+    count++;
+    totalPauseMilliseconds += event.totalPauseDuration * 1000;
+    maxPauseMilliseconds = std::max(maxPauseMilliseconds, maxPause);
+    constraintSolvingMilliseconds += event.constraintSolvingDuration * 1000;
+    bytesVisited += event.bytesVisited;
+    bytesSwept += event.bytesSwept;
+    if (event.wasOverSoftMemoryBudget)
+        overSoftMemoryBudgetCount++;
+    if (event.wasMemoryBudgetEmergency)
+        memoryBudgetEmergencyCount++;
+}
+
+void JavaScriptGCPauseHistogram::Collections::addToStatistics(const char* prefix, HashMap<String, uint64_t>& statistics) const
+{
+    auto key = [&] (const char* name) {
+        StringBuilder builder;
+        builder.append(prefix);
+        builder.append(name);
+        return builder.toString();
+    };
+
+    statistics.set(key("Count"), count);
+    statistics.set(key("TotalPauseMilliseconds"), static_cast<uint64_t>(totalPauseMilliseconds));
+    statistics.set(key("MaxPauseMilliseconds"), static_cast<uint64_t>(maxPauseMilliseconds));
+    statistics.set(key("ConstraintSolvingMilliseconds"), static_cast<uint64_t>(constraintSolvingMilliseconds));
+    statistics.set(key("BytesVisited"), bytesVisited);
+    statistics.set(key("BytesSwept"), bytesSwept);
+    statistics.set(key("OverSoftMemoryBudgetCount"), overSoftMemoryBudgetCount);
+    statistics.set(key("MemoryBudgetEmergencyCount"), memoryBudgetEmergencyCount);
+    for (size_t i = 0; i < bucketCount; ++i)
+        statistics.set(key(bucketNames[i]), maxPauseBuckets[i]);
+}
+
+void JavaScriptGCPauseHistogram::addToStatistics(HashMap<String, uint64_t>& statistics) const
+{
+    m_edenCollections.addToStatistics("JavaScriptEdenGC", statistics);
+    m_fullCollections.addToStatistics("JavaScriptFullGC", statistics);
+}
+
+} // namespace WebKit
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <JavaScriptCore/JSGarbageCollectionEventPrivate.h>
+#include <array>
+#include <wtf/Forward.h>
+#include <wtf/HashMap.h>
+
+namespace JSC {
+class VM;
+}
+
+namespace WebKit {
+
+// Aggregates the garbage collections of the web process VM into pause-time histograms, which
+// are reported to the UI process together with the other WebCore statistics.
+class JavaScriptGCPauseHistogram {
+    WTF_MAKE_NONCOPYABLE(JavaScriptGCPauseHistogram);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    JavaScriptGCPauseHistogram() = default;
+    ~JavaScriptGCPauseHistogram();
+
+    void startObserving(JSC::VM&);
+    void addToStatistics(HashMap<String, uint64_t>&) const;
+
+private:
+    static void didGarbageCollect(JSContextGroupRef, const JSGarbageCollectionEvent*, void* userData);
+    void record(const JSGarbageCollectionEvent&);
+
+    // Buckets are powers of two in milliseconds: <1, <2, <4, ..., <64, and everything above.
+    static const size_t bucketCount = 8;
+
+    struct Collections {
+        void record(const JSGarbageCollectionEvent&);
+        void addToStatistics(const char* prefix, HashMap<String, uint64_t>&) const;
+
+        std::array<uint64_t, bucketCount> maxPauseBuckets { };
+        uint64_t count { 0 };
+        double totalPauseMilliseconds { 0 };
+        double maxPauseMilliseconds { 0 };
+        double constraintSolvingMilliseconds { 0 };
+        uint64_t bytesVisited { 0 };
+        uint64_t bytesSwept { 0 };
+        uint64_t overSoftMemoryBudgetCount { 0 };
+        uint64_t memoryBudgetEmergencyCount { 0 };
+    };
+
+    JSC::VM* m_vm { nullptr };
+    Collections m_edenCollections;
+    Collections m_fullCollections;
+};
+
+} // namespace WebKit
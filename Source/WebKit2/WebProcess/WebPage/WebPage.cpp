@@ -3256,6 +3256,12 @@ void WebPage::updatePreferences(const WebPreferencesStore& store)
     
     settings.setNewBlockInsideInlineModelEnabled(store.getBoolValueForKey(WebPreferencesKey::newBlockInsideInlineModelEnabledKey()));
     settings.setDeferredCSSParserEnabled(store.getBoolValueForKey(WebPreferencesKey::deferredCSSParserEnabledKey()));
+    settings.setThreadedHTMLTokenizerEnabled(store.getBoolValueForKey(WebPreferencesKey::threadedHTMLTokenizerEnabledKey()));
+    settings.setParallelStyleResolutionEnabled(store.getBoolValueForKey(WebPreferencesKey::parallelStyleResolutionEnabledKey()));
+    settings.setThreadedCSSTokenizerEnabled(store.getBoolValueForKey(WebPreferencesKey::threadedCSSTokenizerEnabledKey()));
+    settings.setSelectorQueryResultCacheEnabled(store.getBoolValueForKey(WebPreferencesKey::selectorQueryResultCacheEnabledKey()));
+    settings.setBudgetedLayoutDuringLoadEnabled(store.getBoolValueForKey(WebPreferencesKey::budgetedLayoutDuringLoadEnabledKey()));
+    settings.setFlexLayoutCacheEnabled(store.getBoolValueForKey(WebPreferencesKey::flexLayoutCacheEnabledKey()));
 
     settings.setSubpixelCSSOMElementMetricsEnabled(store.getBoolValueForKey(WebPreferencesKey::subpixelCSSOMElementMetricsEnabledKey()));
 
@@ -5710,6 +5716,53 @@ void WebPage::getSamplingProfilerOutput(uint64_t callbackID)
 #endif
 }
 
+void WebPage::startSamplingProfilerExport(const String& directory, JSC::SamplingProfileFormat format, uint32_t sampleIntervalInMicroseconds, uint32_t flushIntervalInMilliseconds)
+{
+#if ENABLE(SAMPLING_PROFILER)
+    if (directory.isEmpty())
+        return;
+
+    SamplingProfilerExporter::Configuration configuration;
+    configuration.directory = directory;
+    configuration.format = format;
+    if (flushIntervalInMilliseconds)
+        configuration.flushInterval = std::chrono::milliseconds(flushIntervalInMilliseconds);
+    configuration.maxStacks = Options::samplingProfilerExportMaxStacks();
+    configuration.maxFiles = Options::samplingProfilerExportMaxFiles();
+
+    std::optional<std::chrono::microseconds> sampleInterval;
+    if (sampleIntervalInMicroseconds)
+        sampleInterval = std::chrono::microseconds(sampleIntervalInMicroseconds);
+
+    VM& vm = commonVM();
+    JSLockHolder lock(vm);
+    vm.setShouldBuildPCToCodeOriginMapping();
+    SamplingProfiler& samplingProfiler = vm.ensureSamplingProfiler(WTF::Stopwatch::create());
+    samplingProfiler.startExporting(WTFMove(configuration), sampleInterval);
+    samplingProfiler.noticeCurrentThreadAsJSCExecutionThread();
+    samplingProfiler.start();
+#else
+    UNUSED_PARAM(directory);
+    UNUSED_PARAM(format);
+    UNUSED_PARAM(sampleIntervalInMicroseconds);
+    UNUSED_PARAM(flushIntervalInMilliseconds);
+#endif
+}
+
+void WebPage::stopSamplingProfilerExport()
+{
+#if ENABLE(SAMPLING_PROFILER)
+    VM& vm = commonVM();
+    JSLockHolder lock(vm);
+    SamplingProfiler* samplingProfiler = vm.samplingProfiler();
+    if (!samplingProfiler || !samplingProfiler->isExporting())
+        return;
+
+    // This also pauses the profiler again, unless something else had started it before.
+    samplingProfiler->stopExporting();
+#endif
+}
+
 RefPtr<WebCore::Range> WebPage::rangeFromEditingRange(WebCore::Frame& frame, const EditingRange& range, EditingRangeIsRelativeTo editingRangeIsRelativeTo)
 {
     ASSERT(range.location != notFound);
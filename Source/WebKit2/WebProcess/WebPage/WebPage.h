@@ -114,6 +114,10 @@ class Decoder;
 class Connection;
 }
 
+namespace JSC {
+enum class SamplingProfileFormat;
+}
+
 namespace WebCore {
 class DocumentLoader;
 class GraphicsContext;
@@ -908,6 +912,8 @@ public:
 
     void getBytecodeProfile(uint64_t callbackID);
     void getSamplingProfilerOutput(uint64_t callbackID);
+    void startSamplingProfilerExport(const String& directory, JSC::SamplingProfileFormat, uint32_t sampleIntervalInMicroseconds, uint32_t flushIntervalInMilliseconds);
+    void stopSamplingProfilerExport();
     
 #if ENABLE(SERVICE_CONTROLS) || ENABLE(TELEPHONE_NUMBER_DETECTION)
     void handleTelephoneNumberClick(const String& number, const WebCore::IntPoint&);
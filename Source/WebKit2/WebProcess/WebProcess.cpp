@@ -99,6 +99,7 @@
 #include <WebCore/PageCache.h>
 #include <WebCore/PageGroup.h>
 #include <WebCore/PlatformMediaSessionManager.h>
+#include <WebCore/ProcessWarming.h>
 #include <WebCore/ResourceHandle.h>
 #include <WebCore/ResourceLoadObserver.h>
 #include <WebCore/ResourceLoadStatistics.h>
@@ -107,6 +108,7 @@
 #include <WebCore/SchemeRegistry.h>
 #include <WebCore/SecurityOrigin.h>
 #include <WebCore/Settings.h>
+#include <WebCore/SimpleLineLayoutCoverage.h>
 #include <WebCore/URLParser.h>
 #include <WebCore/UserGestureIndicator.h>
 #include <unistd.h>
@@ -133,6 +135,10 @@
 #include "WebNotificationManager.h"
 #endif
 
+#if USE(HARFBUZZ)
+#include <WebCore/HarfBuzzShapeCache.h>
+#endif
+
 #if ENABLE(REMOTE_INSPECTOR)
 #include <JavaScriptCore/RemoteInspector.h>
 #endif
@@ -410,6 +416,10 @@ void WebProcess::initializeWebProcess(WebProcessCreationParameters&& parameters)
 #if ENABLE(WEBASSEMBLY)
     JSC::Wasm::enableFastMemory();
 #endif
+
+    m_javaScriptGCPauseHistogram.startObserving(commonVM());
+    if (parameters.javaScriptSoftMemoryBudget || parameters.javaScriptHardMemoryBudget)
+        setJavaScriptMemoryBudget(parameters.javaScriptSoftMemoryBudget, parameters.javaScriptHardMemoryBudget);
 }
 
 void WebProcess::ensureNetworkProcessConnection()
@@ -495,6 +505,17 @@ void WebProcess::setAlwaysUsesComplexTextCodePath(bool alwaysUseComplexText)
     WebCore::FontCascade::setCodePath(alwaysUseComplexText ? WebCore::FontCascade::Complex : WebCore::FontCascade::Auto);
 }
 
+void WebProcess::setJavaScriptMemoryBudget(uint64_t softLimit, uint64_t hardLimit)
+{
+    JSLockHolder lock(commonVM());
+    commonVM().heap.setMemoryBudget(softLimit, hardLimit);
+}
+
+void WebProcess::prewarmGlobally()
+{
+    WebCore::ProcessWarming::prewarmGlobally();
+}
+
 void WebProcess::setShouldUseFontSmoothing(bool useFontSmoothing)
 {
     WebCore::FontCascade::setShouldUseSmoothing(useFontSmoothing);
@@ -553,12 +574,15 @@ void WebProcess::setCacheModel(uint32_t cm)
     unsigned cacheMaxDeadCapacity = 0;
     Seconds deadDecodedDataDeletionInterval;
     unsigned pageCacheSize = 0;
-    calculateMemoryCacheSizes(cacheModel, cacheTotalCapacity, cacheMinDeadCapacity, cacheMaxDeadCapacity, deadDecodedDataDeletionInterval, pageCacheSize);
+    size_t pageCacheMemoryCapacity = 0;
+    calculateMemoryCacheSizes(cacheModel, cacheTotalCapacity, cacheMinDeadCapacity, cacheMaxDeadCapacity, deadDecodedDataDeletionInterval, pageCacheSize, pageCacheMemoryCapacity);
 
     auto& memoryCache = MemoryCache::singleton();
     memoryCache.setCapacities(cacheMinDeadCapacity, cacheMaxDeadCapacity, cacheTotalCapacity);
     memoryCache.setDeadDecodedDataDeletionInterval(deadDecodedDataDeletionInterval);
-    PageCache::singleton().setMaxSize(pageCacheSize);
+    auto& pageCache = PageCache::singleton();
+    pageCache.setMaxSize(pageCacheSize);
+    pageCache.setMaxMemoryCost(pageCacheMemoryCapacity);
 
     platformSetCacheModel(cacheModel);
 }
@@ -1001,6 +1025,8 @@ void WebProcess::getWebCoreStatistics(uint64_t callbackID)
         uint64_t javaScriptHeapSize = commonVM().heap.size();
         data.statisticsNumbers.set(ASCIILiteral("JavaScriptHeapSize"), javaScriptHeapSize);
         data.statisticsNumbers.set(ASCIILiteral("JavaScriptFreeSize"), commonVM().heap.capacity() - javaScriptHeapSize);
+
+        m_javaScriptGCPauseHistogram.addToStatistics(data.statisticsNumbers);
     }
 
     WTF::FastMallocStatistics fastMallocStatistics = WTF::fastMallocStatistics();
@@ -1021,9 +1047,37 @@ void WebProcess::getWebCoreStatistics(uint64_t callbackID)
     
     // Gather glyph page statistics.
     data.statisticsNumbers.set(ASCIILiteral("GlyphPageCount"), GlyphPage::count());
+
+    // Gather simple line layout coverage statistics.
+    auto lineLayoutStatistics = SimpleLineLayout::coverageStatistics();
+    data.statisticsNumbers.set(ASCIILiteral("SimpleLineLayoutFlowCount"), lineLayoutStatistics.simpleLinesFlowCount);
+    data.statisticsNumbers.set(ASCIILiteral("SimpleLineLayoutTextLength"), lineLayoutStatistics.simpleLinesTextLength);
+    data.statisticsNumbers.set(ASCIILiteral("LineBoxesLayoutFlowCount"), lineLayoutStatistics.lineBoxesFlowCount);
+    data.statisticsNumbers.set(ASCIILiteral("LineBoxesLayoutTextLength"), lineLayoutStatistics.lineBoxesTextLength);
     
+#if USE(HARFBUZZ)
+    // Gather complex text shaping cache statistics.
+    auto& shapeCache = HarfBuzzShapeCache::singleton();
+    data.statisticsNumbers.set(ASCIILiteral("HarfBuzzShapeCacheSize"), shapeCache.size());
+    data.statisticsNumbers.set(ASCIILiteral("HarfBuzzShapeCacheHitCount"), shapeCache.hitCount());
+    data.statisticsNumbers.set(ASCIILiteral("HarfBuzzShapeCacheMissCount"), shapeCache.missCount());
+#endif
+
     // Get WebCore memory cache statistics
     getWebCoreMemoryCacheStatistics(data.webCoreCacheStatistics);
+
+    auto& pruneStatistics = MemoryCache::singleton().pruneStatistics();
+    data.statisticsNumbers.set(ASCIILiteral("MemoryCachePruneCount"), pruneStatistics.pruneCount);
+    data.statisticsNumbers.set(ASCIILiteral("MemoryCacheDecodedDataDestroyedCount"), pruneStatistics.decodedDataDestroyedCount);
+    data.statisticsNumbers.set(ASCIILiteral("MemoryCacheEvictedCount"), pruneStatistics.evictedCount);
+    data.statisticsNumbers.set(ASCIILiteral("MemoryCacheEvictedOverPartitionBudgetCount"), pruneStatistics.evictedOverPartitionBudgetCount);
+    data.statisticsNumbers.set(ASCIILiteral("MemoryCacheEvictedSize"), pruneStatistics.evictedSize);
+    data.statisticsNumbers.set(ASCIILiteral("MemoryCacheEvictedRecreationCostMilliseconds"), static_cast<uint64_t>(pruneStatistics.evictedRecreationCost.milliseconds()));
+
+    // Gather page cache statistics.
+    auto& pageCache = PageCache::singleton();
+    data.statisticsNumbers.set(ASCIILiteral("PageCachePageCount"), pageCache.pageCount());
+    data.statisticsNumbers.set(ASCIILiteral("PageCacheMemoryCost"), pageCache.memoryCost());
     
     parentProcessConnection()->send(Messages::WebProcessPool::DidGetStatistics(data, callbackID), 0);
 }
@@ -27,6 +27,7 @@
 
 #include "CacheModel.h"
 #include "ChildProcess.h"
+#include "JavaScriptGCPauseHistogram.h"
 #include "PluginProcessConnectionManager.h"
 #include "ResourceCachesToClear.h"
 #include "SandboxExtension.h"
@@ -260,6 +261,8 @@ private:
     void setDefaultRequestTimeoutInterval(double);
     void setAlwaysUsesComplexTextCodePath(bool);
     void setShouldUseFontSmoothing(bool);
+    void setJavaScriptMemoryBudget(uint64_t softLimit, uint64_t hardLimit);
+    void prewarmGlobally();
     void setResourceLoadStatisticsEnabled(bool);
     void userPreferredLanguagesChanged(const Vector<String>&) const;
     void fullKeyboardAccessModeChanged(bool fullKeyboardAccessEnabled);
@@ -426,6 +429,8 @@ private:
 
     HashMap<WebCore::UserGestureToken *, uint64_t> m_userGestureTokens;
 
+    JavaScriptGCPauseHistogram m_javaScriptGCPauseHistogram;
+
 #if PLATFORM(WAYLAND)
     String m_waylandCompositorDisplayName;
 #endif
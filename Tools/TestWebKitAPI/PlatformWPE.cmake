@@ -31,6 +31,10 @@ set(bundle_harness_SOURCES
     ${TESTWEBKITAPI_DIR}/wpe/PlatformUtilitiesWPE.cpp
 )
 
+set(webkit2_api_harness_SOURCES
+    ${TESTWEBKITAPI_DIR}/wpe/PlatformUtilitiesWPE.cpp
+)
+
 # TestWTF
 
 list(APPEND TestWTF_SOURCES
@@ -38,18 +42,34 @@ list(APPEND TestWTF_SOURCES
     ${TESTWEBKITAPI_DIR}/Tests/WTF/glib/WorkQueueGLib.cpp
 )
 
+# TestWebKit2
+
+add_executable(TestWebKit2
+    ${TESTWEBKITAPI_DIR}/Tests/WebKit2/NetworkLoadScheduler.cpp
+)
+
+target_link_libraries(TestWebKit2 ${test_webkit2_api_LIBRARIES})
+add_test(TestWebKit2 ${TESTWEBKITAPI_RUNTIME_OUTPUT_DIRECTORY}/WebKit2/TestWebKit2)
+set_tests_properties(TestWebKit2 PROPERTIES TIMEOUT 60)
+set_target_properties(TestWebKit2 PROPERTIES RUNTIME_OUTPUT_DIRECTORY ${TESTWEBKITAPI_RUNTIME_OUTPUT_DIRECTORY}/WebKit2)
+
 # TestWebCore
 
 add_executable(TestWebCore
     ${test_main_SOURCES}
     ${TESTWEBKITAPI_DIR}/TestsController.cpp
     ${TESTWEBKITAPI_DIR}/Tests/WebCore/HTMLParserIdioms.cpp
+    ${TESTWEBKITAPI_DIR}/Tests/WebCore/HTMLSpeculativeTokenizer.cpp
     ${TESTWEBKITAPI_DIR}/Tests/WebCore/LayoutUnit.cpp
     ${TESTWEBKITAPI_DIR}/Tests/WebCore/URL.cpp
     ${TESTWEBKITAPI_DIR}/Tests/WebCore/SharedBuffer.cpp
     ${TESTWEBKITAPI_DIR}/Tests/WebCore/SharedBufferTest.cpp
+    ${TESTWEBKITAPI_DIR}/Tests/WebCore/StreamingScriptDecoder.cpp
     ${TESTWEBKITAPI_DIR}/Tests/WebCore/FileSystem.cpp
     ${TESTWEBKITAPI_DIR}/Tests/WebCore/PublicSuffix.cpp
+    ${TESTWEBKITAPI_DIR}/Tests/WebCore/SelectorQuery.cpp
+    ${TESTWEBKITAPI_DIR}/Tests/WebCore/CSSBackgroundTokenizer.cpp
+    ${TESTWEBKITAPI_DIR}/Tests/WebCore/soup/WebKitCachingResolver.cpp
 )
 
 target_link_libraries(TestWebCore ${test_webcore_LIBRARIES})
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "Test.h"
+#include <WebCore/CSSBackgroundTokenizer.h>
+#include <WebCore/CSSParserTokenRange.h>
+#include <WebCore/CSSTokenizer.h>
+#include <wtf/MainThread.h>
+#include <wtf/RunLoop.h>
+#include <wtf/text/StringBuilder.h>
+
+#if USE(GLIB)
+#include <glib.h>
+#endif
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+class CSSBackgroundTokenizerTest : public testing::Test {
+public:
+    void SetUp() final
+    {
+        WTF::initializeMainThread();
+        RunLoop::initializeMainRunLoop();
+    }
+};
+
+// Large enough for the background thread to tokenize several segments.
+static String createSheet()
+{
+    StringBuilder builder;
+    for (unsigned i = 0; i < 2000; ++i) {
+        builder.appendLiteral(".rule");
+        builder.appendNumber(i);
+        builder.appendLiteral(" { color: red; background: url(image.png); content: \"\\41 b\"; }\n");
+    }
+    return builder.toString();
+}
+
+static void appendInChunks(CSSBackgroundTokenizer& tokenizer, const String& text)
+{
+    const unsigned chunkSize = 1000;
+    for (unsigned offset = 0; offset < text.length(); offset += chunkSize)
+        tokenizer.append(text.substring(offset, chunkSize));
+}
+
+static void finishAndWait(CSSBackgroundTokenizer& tokenizer)
+{
+    tokenizer.finish();
+    // The background thread drops its last reference on the main thread once it's done.
+    while (!tokenizer.hasOneRef()) {
+#if USE(GLIB)
+        g_main_context_iteration(nullptr, TRUE);
+#endif
+    }
+}
+
+static void expectSameTokens(CSSTokenizer& tokenizer, const String& sheetText)
+{
+    CSSTokenizer mainThreadTokenizer(sheetText);
+    auto tokens = tokenizer.tokenRange();
+    auto expectedTokens = mainThreadTokenizer.tokenRange();
+    ASSERT_EQ(expectedTokens.end() - expectedTokens.begin(), tokens.end() - tokens.begin());
+
+    const LChar* sheetCharacters = sheetText.characters8();
+    for (auto* token = tokens.begin(), *expectedToken = expectedTokens.begin(); token != tokens.end(); ++token, ++expectedToken) {
+        EXPECT_TRUE(*token == *expectedToken);
+        // Only escaped strings need to be kept alive for the tokens, the others point into the sheet text.
+        if (token->hasStringBacking() && token->value() != "Ab") {
+            ASSERT_TRUE(token->value().is8Bit());
+            EXPECT_TRUE(token->value().characters8() >= sheetCharacters && token->value().characters8() < sheetCharacters + sheetText.length());
+        }
+    }
+}
+
+TEST_F(CSSBackgroundTokenizerTest, TokensMatchMainThreadTokens)
+{
+    String sheetText = createSheet();
+    auto backgroundTokenizer = CSSBackgroundTokenizer::create();
+    appendInChunks(backgroundTokenizer, sheetText);
+    finishAndWait(backgroundTokenizer);
+
+    // A copy, so that tokens pointing into the appended text can't match by accident.
+    String sheetTextCopy = String(sheetText.characters8(), sheetText.length());
+    auto tokenizer = backgroundTokenizer->createTokenizer(sheetTextCopy);
+    ASSERT_TRUE(!!tokenizer);
+    expectSameTokens(*tokenizer, sheetTextCopy);
+}
+
+TEST_F(CSSBackgroundTokenizerTest, UnfinishedWorkIsDoneOnTheCallingThread)
+{
+    String sheetText = createSheet();
+    auto backgroundTokenizer = CSSBackgroundTokenizer::create();
+    appendInChunks(backgroundTokenizer, sheetText);
+
+    // Doesn't wait for the background thread, whatever it has done so far.
+    auto tokenizer = backgroundTokenizer->createTokenizer(sheetText);
+    ASSERT_TRUE(!!tokenizer);
+    expectSameTokens(*tokenizer, sheetText);
+
+    finishAndWait(backgroundTokenizer);
+}
+
+TEST_F(CSSBackgroundTokenizerTest, DifferentTextIsNotUsed)
+{
+    String sheetText = createSheet();
+    auto backgroundTokenizer = CSSBackgroundTokenizer::create();
+    appendInChunks(backgroundTokenizer, sheetText);
+    finishAndWait(backgroundTokenizer);
+
+    String otherText = sheetText;
+    otherText.replace("rule1999", "other");
+    EXPECT_FALSE(backgroundTokenizer->createTokenizer("p { color: red }"));
+    EXPECT_FALSE(backgroundTokenizer->createTokenizer(otherText));
+    EXPECT_TRUE(!!backgroundTokenizer->createTokenizer(sheetText));
+}
+
+} // namespace TestWebKitAPI
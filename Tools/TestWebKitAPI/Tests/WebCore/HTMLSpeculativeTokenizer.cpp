@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "Test.h"
+#include "WTFStringUtilities.h"
+#include <WebCore/HTMLSpeculativeTokenizer.h>
+#include <WebCore/HTMLTokenizer.h>
+#include <WebCore/SegmentedString.h>
+#include <wtf/MainThread.h>
+#include <wtf/RunLoop.h>
+#include <wtf/text/StringBuilder.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+class HTMLSpeculativeTokenizerTest : public testing::Test {
+public:
+    void SetUp() final
+    {
+        WTF::initializeMainThread();
+        RunLoop::initializeMainRunLoop();
+    }
+};
+
+static String serialize(const HTMLToken& token)
+{
+    StringBuilder builder;
+    switch (token.type()) {
+    case HTMLToken::StartTag:
+    case HTMLToken::EndTag:
+        builder.append(token.type() == HTMLToken::StartTag ? "<" : "</");
+        builder.append(token.name().data(), token.name().size());
+        for (auto& attribute : token.attributes()) {
+            builder.append(' ');
+            builder.append(attribute.name.data(), attribute.name.size());
+            builder.append("=\"");
+            builder.append(attribute.value.data(), attribute.value.size());
+            builder.append('"');
+        }
+        builder.append(token.selfClosing() ? "/>" : ">");
+        break;
+    case HTMLToken::Character:
+        builder.append("#text:");
+        builder.append(token.characters().data(), token.characters().size());
+        break;
+    case HTMLToken::Comment:
+        builder.append("<!--");
+        builder.append(token.comment().data(), token.comment().size());
+        builder.append("-->");
+        break;
+    case HTMLToken::DOCTYPE:
+        builder.append("<!DOCTYPE ");
+        builder.append(token.name().data(), token.name().size());
+        builder.append('>');
+        break;
+    default:
+        builder.append("?");
+        break;
+    }
+    return builder.toString();
+}
+
+// What the tree builder does to the tokenizer in the simple documents below, like HTMLTokenizer::updateStateFor().
+static void updateTokenizerLikeTreeBuilder(HTMLTokenizer& tokenizer, const HTMLToken& token)
+{
+    if (token.type() != HTMLToken::StartTag)
+        return;
+
+    String name(token.name().data(), token.name().size());
+    if (name == "title" || name == "textarea")
+        tokenizer.setRCDATAState();
+    else if (name == "script")
+        tokenizer.setScriptDataState();
+    else if (name == "style" || name == "xmp")
+        tokenizer.setRAWTEXTState();
+    else if (name == "plaintext")
+        tokenizer.setPLAINTEXTState();
+}
+
+static void tokenizeOnMainThread(HTMLTokenizer& tokenizer, SegmentedString& input, Vector<String>& tokens)
+{
+    while (auto token = tokenizer.nextToken(input)) {
+        tokens.append(serialize(*token));
+        updateTokenizerLikeTreeBuilder(tokenizer, *token);
+    }
+}
+
+static Vector<String> tokenizeOnMainThread(const String& source)
+{
+    HTMLTokenizer tokenizer;
+    SegmentedString input(source);
+    Vector<String> tokens;
+    tokenizeOnMainThread(tokenizer, input, tokens);
+    return tokens;
+}
+
+static Vector<HTMLSpeculativeTokenizer::Token> tokenizeSpeculatively(const Vector<String>& chunks)
+{
+    Vector<HTMLSpeculativeTokenizer::Token> tokens;
+    bool done = false;
+    auto speculativeTokenizer = HTMLSpeculativeTokenizer::create(HTMLParserOptions(), HTMLSpeculativeTokenizer::ShouldTrackSource::No, [&] (Vector<HTMLSpeculativeTokenizer::Token>&& batch, bool isFinal) {
+        for (auto& token : batch)
+            tokens.append(WTFMove(token));
+        if (isFinal) {
+            done = true;
+            RunLoop::main().stop();
+        }
+    });
+
+    for (auto& chunk : chunks)
+        speculativeTokenizer->appendToEnd(chunk);
+    speculativeTokenizer->finish();
+
+    while (!done)
+        RunLoop::run();
+    speculativeTokenizer->stop();
+    return tokens;
+}
+
+// Does what HTMLDocumentParser does: build the tree from the first speculative tokens, then, e.g. because
+// document.write() was called, tokenize the rest of the input on the main thread.
+static Vector<String> takeOverAfter(size_t numberOfSpeculativeTokens, Vector<HTMLSpeculativeTokenizer::Token>& speculativeTokens, const String& source)
+{
+    HTMLTokenizer tokenizer;
+    SegmentedString input(source);
+    Vector<String> tokens;
+    for (size_t i = 0; i < numberOfSpeculativeTokens; ++i) {
+        auto& speculativeToken = speculativeTokens[i];
+        for (unsigned j = 0; j < speculativeToken.inputLength; ++j)
+            input.advance();
+        tokenizer.restoreCheckpoint(speculativeToken.checkpoint);
+
+        tokens.append(serialize(speculativeToken.token));
+        updateTokenizerLikeTreeBuilder(tokenizer, speculativeToken.token);
+        if (speculativeToken.predictedCheckpoint)
+            EXPECT_TRUE(tokenizer.isAtCheckpoint(*speculativeToken.predictedCheckpoint));
+    }
+
+    tokenizeOnMainThread(tokenizer, input, tokens);
+    return tokens;
+}
+
+static Vector<String> split(const String& source, unsigned chunkLength)
+{
+    Vector<String> chunks;
+    for (unsigned i = 0; i < source.length(); i += chunkLength)
+        chunks.append(source.substring(i, chunkLength));
+    return chunks;
+}
+
+static const char* documents[] = {
+    "<!DOCTYPE html><html><head><title>A &amp; B</title></head><body class=\"main\"><p>Hello <b>world</b>!</p></body></html>",
+    // The character tokens before these end tags are followed by a buffered end tag name.
+    "<title>x</title><textarea>a</b>c</textarea><script>if (a < b) document.write('</p>');</script><style>p { }</style><p>",
+    "<script><!-- document.write('<script></script>'); --></script><xmp><b></xmp>",
+    "<p a=1 b='2' c=\"3\">one\r\ntwo\rthree</p><!-- comment --><br/>",
+};
+
+TEST_F(HTMLSpeculativeTokenizerTest, SameTokensAsMainThread)
+{
+    for (auto* document : documents) {
+        String source(document);
+        auto expectedTokens = tokenizeOnMainThread(source);
+        for (unsigned chunkLength : { 1u, 3u, 7u, source.length() }) {
+            auto speculativeTokens = tokenizeSpeculatively(split(source, chunkLength));
+            EXPECT_EQ(expectedTokens, takeOverAfter(speculativeTokens.size(), speculativeTokens, source)) << document << " in chunks of " << chunkLength;
+        }
+    }
+}
+
+TEST_F(HTMLSpeculativeTokenizerTest, MainThreadTakesOverAfterAnyToken)
+{
+    for (auto* document : documents) {
+        String source(document);
+        auto expectedTokens = tokenizeOnMainThread(source);
+        for (unsigned chunkLength : { 2u, source.length() }) {
+            auto speculativeTokens = tokenizeSpeculatively(split(source, chunkLength));
+            for (size_t i = 0; i <= speculativeTokens.size(); ++i)
+                EXPECT_EQ(expectedTokens, takeOverAfter(i, speculativeTokens, source)) << document << " taking over after token " << i;
+        }
+    }
+}
+
+TEST_F(HTMLSpeculativeTokenizerTest, StopsAtUnpredictableInput)
+{
+    String source = ASCIILiteral("<p>a</p><svg><![CDATA[<b>]]></svg><p>c</p>");
+    auto speculativeTokens = tokenizeSpeculatively({ source });
+
+    // Whether CDATA is allowed depends on the tree builder, so the main thread has to tokenize from there on.
+    ASSERT_EQ(4u, speculativeTokens.size());
+    EXPECT_EQ("<svg>", serialize(speculativeTokens.last().token));
+    EXPECT_EQ(tokenizeOnMainThread(source), takeOverAfter(speculativeTokens.size(), speculativeTokens, source));
+}
+
+} // namespace TestWebKitAPI
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "Test.h"
+#include <WebCore/HTMLDocument.h>
+#include <WebCore/HTMLNames.h>
+#include <WebCore/QualifiedName.h>
+#include <WebCore/Settings.h>
+#include <runtime/InitializeThreading.h>
+#include <wtf/MainThread.h>
+#include <wtf/RunLoop.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+class SelectorQueryTest : public testing::Test {
+public:
+    void SetUp() final
+    {
+        JSC::initializeThreading();
+        WTF::initializeMainThread();
+        RunLoop::initializeMainRunLoop();
+        AtomicString::init();
+        HTMLNames::init();
+        QualifiedName::init();
+    }
+
+    static Ref<Document> createDocument()
+    {
+        auto document = HTMLDocument::create(nullptr, URL());
+        document->mutableSettings().setSelectorQueryResultCacheEnabled(true);
+        auto html = document->createElement(HTMLNames::htmlTag, false);
+        document->appendChild(html);
+        return WTFMove(document);
+    }
+};
+
+TEST_F(SelectorQueryTest, CachedResultsDoNotReferenceTheDocument)
+{
+    auto document = createDocument();
+    auto div = document->createElement(HTMLNames::divTag, false);
+    document->documentElement()->appendChild(div);
+    EXPECT_TRUE(document->hasOneRef());
+
+    auto result = document->querySelector("div");
+    ASSERT_FALSE(result.hasException());
+    EXPECT_EQ(div.ptr(), result.releaseReturnValue());
+    EXPECT_EQ(1U, document->querySelectorAll("div").releaseReturnValue()->length());
+
+    // A reference from the cache would keep the document alive after navigation.
+    EXPECT_TRUE(document->hasOneRef());
+}
+
+TEST_F(SelectorQueryTest, CachedResultsAreDroppedWhenTheTreeChanges)
+{
+    auto document = createDocument();
+    auto div = document->createElement(HTMLNames::divTag, false);
+    document->documentElement()->appendChild(div);
+    int refCountBeforeQuery = div->refCount();
+
+    EXPECT_EQ(1U, document->querySelectorAll("div").releaseReturnValue()->length());
+    EXPECT_GT(div->refCount(), refCountBeforeQuery);
+
+    auto span = document->createElement(HTMLNames::spanTag, false);
+    document->documentElement()->appendChild(span);
+    EXPECT_EQ(refCountBeforeQuery, div->refCount());
+    EXPECT_EQ(1U, document->querySelectorAll("div").releaseReturnValue()->length());
+}
+
+TEST_F(SelectorQueryTest, CachedResultsAreDroppedWhenTheDocumentIsPreparedForDestruction)
+{
+    auto document = createDocument();
+    auto div = document->createElement(HTMLNames::divTag, false);
+    document->documentElement()->appendChild(div);
+    int refCountBeforeQuery = div->refCount();
+
+    EXPECT_EQ(div.ptr(), document->querySelector("div").releaseReturnValue());
+    EXPECT_EQ(1U, document->querySelectorAll("div").releaseReturnValue()->length());
+    EXPECT_GT(div->refCount(), refCountBeforeQuery);
+
+    document->prepareForDestruction();
+    EXPECT_EQ(refCountBeforeQuery, div->refCount());
+}
+
+} // namespace TestWebKitAPI
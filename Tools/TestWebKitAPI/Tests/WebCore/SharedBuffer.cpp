@@ -127,6 +127,32 @@ TEST_F(SharedBufferTest, tryCreateArrayBufferLargeSegments)
     }
 }
 
+TEST_F(SharedBufferTest, getSomeData)
+{
+    Vector<char> s1 = {'a', 'b', 'c', 'd'};
+    Vector<char> s2 = {'e', 'f', 'g', 'h'};
+    Vector<char> s3 = {'i', 'j', 'k', 'l'};
+
+    auto buffer = SharedBuffer::create();
+    buffer->append(WTFMove(s1));
+    buffer->append(WTFMove(s2));
+    buffer->append(WTFMove(s3));
+
+    const char* segment;
+    ASSERT_EQ(4U, buffer->getSomeData(segment, 0));
+    EXPECT_EQ('a', segment[0]);
+    ASSERT_EQ(2U, buffer->getSomeData(segment, 6));
+    EXPECT_EQ('g', segment[0]);
+    EXPECT_EQ('h', segment[1]);
+    ASSERT_EQ(4U, buffer->getSomeData(segment, 8));
+    EXPECT_EQ('i', segment[0]);
+    EXPECT_EQ(0U, buffer->getSomeData(segment, 12));
+    EXPECT_EQ(nullptr, segment);
+
+    // getSomeData() must not combine the segments.
+    EXPECT_EQ(3, buffer->end() - buffer->begin());
+}
+
 TEST_F(SharedBufferTest, copy)
 {
     char testData[] = "Habitasse integer eros tincidunt a scelerisque! Enim elit? Scelerisque magnis,"
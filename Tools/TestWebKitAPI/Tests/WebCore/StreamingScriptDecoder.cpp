@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "Test.h"
+#include <WebCore/SharedBuffer.h>
+#include <WebCore/StreamingScriptDecoder.h>
+#include <WebCore/TextEncoding.h>
+#include <WebCore/TextResourceDecoder.h>
+#include <wtf/MainThread.h>
+#include <wtf/text/StringBuilder.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+class StreamingScriptDecoderTest : public testing::Test {
+public:
+    void SetUp() final
+    {
+        WTF::initializeMainThread();
+    }
+};
+
+struct StreamingResult {
+    String script;
+    unsigned hash;
+    bool isDecoding;
+    RefPtr<SharedBuffer> contiguousData;
+};
+
+// Appends the data chunk by chunk, each chunk in its own segment as the loader does. The segments received
+// so far are merged into one after mergeAfterChunk chunks, like SharedBuffer::data() does.
+static StreamingResult decodeInChunks(const Vector<char>& data, const TextEncoding& encoding, size_t chunkSize, size_t mergeAfterChunk = notFound)
+{
+    StreamingScriptDecoder decoder(encoding);
+    auto buffer = SharedBuffer::create();
+    size_t chunkCount = 0;
+    for (size_t offset = 0; offset < data.size(); offset += chunkSize) {
+        buffer->append(data.data() + offset, std::min(chunkSize, data.size() - offset));
+        if (++chunkCount == mergeAfterChunk)
+            buffer->data();
+        decoder.append(buffer.get());
+    }
+    decoder.append(buffer.get());
+    EXPECT_EQ(data.size(), decoder.size());
+
+    String script = decoder.finish();
+    RefPtr<SharedBuffer> contiguousData;
+    if (!decoder.isDecoding())
+        contiguousData = decoder.takeContiguousData();
+    return { script, decoder.hash(), decoder.isDecoding(), WTFMove(contiguousData) };
+}
+
+static Vector<char> scriptData(const char* prefix, unsigned repeatCount, const char* suffix)
+{
+    Vector<char> data;
+    data.append(prefix, strlen(prefix));
+    for (unsigned i = 0; i < repeatCount; ++i) {
+        static const char line[] = "var x = 1; // a comment of an odd length.\n";
+        data.append(line, sizeof(line) - 1);
+    }
+    data.append(suffix, strlen(suffix));
+    return data;
+}
+
+static const size_t chunkSizes[] = { 1, 2, 3, 7, 64, 4093, 100000 };
+
+TEST_F(StreamingScriptDecoderTest, ASCIIScriptIsHashedButNotDecoded)
+{
+    auto data = scriptData("", 100, "x++;");
+    unsigned expectedHash = String(data.data(), data.size()).impl()->hash();
+
+    for (auto chunkSize : chunkSizes) {
+        auto result = decodeInChunks(data, UTF8Encoding(), chunkSize);
+        EXPECT_FALSE(result.isDecoding);
+        EXPECT_TRUE(result.script.isNull());
+        EXPECT_EQ(expectedHash, result.hash);
+
+        ASSERT_TRUE(!!result.contiguousData);
+        const char* contiguousBytes;
+        ASSERT_EQ(data.size(), result.contiguousData->getSomeData(contiguousBytes));
+        EXPECT_EQ(0, memcmp(data.data(), contiguousBytes, data.size()));
+    }
+}
+
+TEST_F(StreamingScriptDecoderTest, RestartsAtFirstNonASCIIByte)
+{
+    // The non-ASCII characters come after many ASCII chunks, and are split between chunks.
+    auto data = scriptData("", 50, "var s = \"\xC3\xA9t\xC3\xA9 \xE2\x86\x92 \xF0\x9F\x98\x80\";\n");
+    String expectedScript = TextResourceDecoder::create(ASCIILiteral("application/javascript"), UTF8Encoding())->decodeAndFlush(data.data(), data.size());
+    EXPECT_FALSE(expectedScript.is8Bit());
+
+    for (auto chunkSize : chunkSizes) {
+        auto result = decodeInChunks(data, UTF8Encoding(), chunkSize);
+        EXPECT_TRUE(result.isDecoding);
+        EXPECT_EQ(expectedScript, result.script);
+        EXPECT_EQ(expectedScript.impl()->hash(), result.hash);
+    }
+
+    // Same with the data received so far merged into a single segment.
+    for (size_t mergeAfterChunk : { 1, 10, 30 }) {
+        auto result = decodeInChunks(data, UTF8Encoding(), 64, mergeAfterChunk);
+        EXPECT_EQ(expectedScript, result.script);
+        EXPECT_EQ(expectedScript.impl()->hash(), result.hash);
+    }
+}
+
+TEST_F(StreamingScriptDecoderTest, RestartsAtFirstNonASCIIByteInLatin1)
+{
+    auto data = scriptData("", 30, "var s = \"\xE9t\xE9\";\n");
+    String expectedScript = TextResourceDecoder::create(ASCIILiteral("application/javascript"), WindowsLatin1Encoding())->decodeAndFlush(data.data(), data.size());
+
+    for (auto chunkSize : chunkSizes) {
+        auto result = decodeInChunks(data, WindowsLatin1Encoding(), chunkSize);
+        EXPECT_TRUE(result.isDecoding);
+        EXPECT_EQ(expectedScript, result.script);
+        EXPECT_EQ(expectedScript.impl()->hash(), result.hash);
+    }
+}
+
+TEST_F(StreamingScriptDecoderTest, NonByteBasedEncodingIsAlwaysDecoded)
+{
+    auto asciiData = scriptData("", 30, "x++;");
+    Vector<char> data;
+    for (char character : asciiData) {
+        data.append(character);
+        data.append('\0');
+    }
+    TextEncoding encoding(String("UTF-16LE"));
+    String expectedScript = TextResourceDecoder::create(ASCIILiteral("application/javascript"), encoding)->decodeAndFlush(data.data(), data.size());
+    EXPECT_EQ(String(asciiData.data(), asciiData.size()), expectedScript);
+
+    for (auto chunkSize : chunkSizes) {
+        auto result = decodeInChunks(data, encoding, chunkSize);
+        EXPECT_TRUE(result.isDecoding);
+        EXPECT_EQ(expectedScript, result.script);
+        EXPECT_EQ(expectedScript.impl()->hash(), result.hash);
+    }
+}
+
+} // namespace TestWebKitAPI
@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "Test.h"
+#include <WebCore/WebKitCachingResolver.h>
+#include <wtf/Vector.h>
+#include <wtf/glib/GRefPtr.h>
+#include <wtf/glib/GUniquePtr.h>
+#include <wtf/text/CString.h>
+
+namespace TestWebKitAPI {
+
+// A resolver that answers synchronous lookups right away, and asynchronous ones when the test says so.
+typedef struct {
+    GResolver parent;
+} TestResolver;
+
+typedef struct {
+    GResolverClass parent;
+} TestResolverClass;
+
+struct TestResolverState {
+    unsigned synchronousLookupCount { 0 };
+    unsigned asynchronousLookupCount { 0 };
+    Vector<unsigned> asynchronousLookupFlags;
+    Vector<GRefPtr<GTask>> pendingLookups;
+};
+
+static TestResolverState& testResolverState()
+{
+    static TestResolverState state;
+    return state;
+}
+
+G_DEFINE_TYPE(TestResolver, test_resolver, G_TYPE_RESOLVER)
+
+static const char* synchronousLookupAddress = "192.0.2.100";
+
+static GList* addressList(const char* address)
+{
+    return g_list_prepend(nullptr, g_inet_address_new_from_string(address));
+}
+
+static GList* testResolverLookupByName(GResolver*, const char*, GCancellable*, GError**)
+{
+    testResolverState().synchronousLookupCount++;
+    return addressList(synchronousLookupAddress);
+}
+
+static void testResolverLookupByNameAsync(GResolver* resolver, const char*, GCancellable* cancellable, GAsyncReadyCallback callback, gpointer userData)
+{
+    testResolverState().asynchronousLookupCount++;
+    testResolverState().asynchronousLookupFlags.append(0);
+    testResolverState().pendingLookups.append(adoptGRef(g_task_new(resolver, cancellable, callback, userData)));
+}
+
+static GList* testResolverLookupByNameFinish(GResolver*, GAsyncResult* result, GError** error)
+{
+    return static_cast<GList*>(g_task_propagate_pointer(G_TASK(result), error));
+}
+
+#if GLIB_CHECK_VERSION(2, 59, 0)
+static void testResolverLookupByNameWithFlagsAsync(GResolver* resolver, const char*, GResolverNameLookupFlags flags, GCancellable* cancellable, GAsyncReadyCallback callback, gpointer userData)
+{
+    testResolverState().asynchronousLookupCount++;
+    testResolverState().asynchronousLookupFlags.append(flags);
+    testResolverState().pendingLookups.append(adoptGRef(g_task_new(resolver, cancellable, callback, userData)));
+}
+
+static GList* testResolverLookupByNameWithFlagsFinish(GResolver* resolver, GAsyncResult* result, GError** error)
+{
+    return testResolverLookupByNameFinish(resolver, result, error);
+}
+#endif
+
+static void test_resolver_init(TestResolver*)
+{
+}
+
+static void test_resolver_class_init(TestResolverClass* testResolverClass)
+{
+    GResolverClass* resolverClass = G_RESOLVER_CLASS(testResolverClass);
+    resolverClass->lookup_by_name = testResolverLookupByName;
+    resolverClass->lookup_by_name_async = testResolverLookupByNameAsync;
+    resolverClass->lookup_by_name_finish = testResolverLookupByNameFinish;
+#if GLIB_CHECK_VERSION(2, 59, 0)
+    resolverClass->lookup_by_name_with_flags_async = testResolverLookupByNameWithFlagsAsync;
+    resolverClass->lookup_by_name_with_flags_finish = testResolverLookupByNameWithFlagsFinish;
+#endif
+}
+
+static void completePendingLookups(const char* address)
+{
+    auto lookups = WTFMove(testResolverState().pendingLookups);
+    for (auto& task : lookups)
+        g_task_return_pointer(task.get(), addressList(address), reinterpret_cast<GDestroyNotify>(g_resolver_free_addresses));
+}
+
+static void failPendingLookups(GResolverError code)
+{
+    auto lookups = WTFMove(testResolverState().pendingLookups);
+    for (auto& task : lookups)
+        g_task_return_new_error(task.get(), G_RESOLVER_ERROR, code, "Lookup failed");
+}
+
+static void runPendingEvents()
+{
+    while (g_main_context_pending(nullptr))
+        g_main_context_iteration(nullptr, FALSE);
+}
+
+class Lookup {
+    WTF_MAKE_NONCOPYABLE(Lookup);
+public:
+    Lookup(GResolver* resolver, const char* hostname, GCancellable* cancellable = nullptr)
+    {
+        g_resolver_lookup_by_name_async(resolver, hostname, cancellable, [](GObject* source, GAsyncResult* result, gpointer userData) {
+            auto& lookup = *static_cast<Lookup*>(userData);
+            lookup.m_addresses = g_resolver_lookup_by_name_finish(G_RESOLVER(source), result, &lookup.m_error.outPtr());
+            lookup.m_isDone = true;
+        }, this);
+    }
+
+#if GLIB_CHECK_VERSION(2, 59, 0)
+    Lookup(GResolver* resolver, const char* hostname, GResolverNameLookupFlags flags)
+    {
+        g_resolver_lookup_by_name_with_flags_async(resolver, hostname, flags, nullptr, [](GObject* source, GAsyncResult* result, gpointer userData) {
+            auto& lookup = *static_cast<Lookup*>(userData);
+            lookup.m_addresses = g_resolver_lookup_by_name_with_flags_finish(G_RESOLVER(source), result, &lookup.m_error.outPtr());
+            lookup.m_isDone = true;
+        }, this);
+    }
+#endif
+
+    ~Lookup()
+    {
+        // The callback must not outlive us.
+        while (!m_isDone)
+            g_main_context_iteration(nullptr, TRUE);
+        if (m_addresses)
+            g_resolver_free_addresses(m_addresses);
+    }
+
+    bool isDone()
+    {
+        runPendingEvents();
+        return m_isDone;
+    }
+
+    CString address()
+    {
+        while (!m_isDone)
+            g_main_context_iteration(nullptr, TRUE);
+        if (!m_addresses)
+            return { };
+        GUniquePtr<char> address(g_inet_address_to_string(G_INET_ADDRESS(m_addresses->data)));
+        return address.get();
+    }
+
+    GError* error()
+    {
+        while (!m_isDone)
+            g_main_context_iteration(nullptr, TRUE);
+        return m_error.get();
+    }
+
+private:
+    bool m_isDone { false };
+    GList* m_addresses { nullptr };
+    GUniqueOutPtr<GError> m_error;
+};
+
+static CString synchronousLookup(GResolver* resolver, const char* hostname)
+{
+    GList* addresses = g_resolver_lookup_by_name(resolver, hostname, nullptr, nullptr);
+    if (!addresses)
+        return { };
+    GUniquePtr<char> address(g_inet_address_to_string(G_INET_ADDRESS(addresses->data)));
+    g_resolver_free_addresses(addresses);
+    return address.get();
+}
+
+class WebKitCachingResolverTest : public testing::Test {
+public:
+    void SetUp() final
+    {
+        testResolverState() = TestResolverState();
+        GRefPtr<GResolver> testResolver = adoptGRef(G_RESOLVER(g_object_new(test_resolver_get_type(), nullptr)));
+        m_resolver = adoptGRef(webkitCachingResolverNew(testResolver.get()));
+    }
+
+    void TearDown() final
+    {
+        completePendingLookups("192.0.2.255");
+        runPendingEvents();
+        m_resolver = nullptr;
+    }
+
+    GResolver* resolver() const { return m_resolver.get(); }
+
+    void advanceTime(Seconds delta)
+    {
+        webkitCachingResolverAdvanceTimeForTesting(WEBKIT_CACHING_RESOLVER(m_resolver.get()), delta);
+    }
+
+private:
+    GRefPtr<GResolver> m_resolver;
+};
+
+TEST_F(WebKitCachingResolverTest, ConcurrentLookupsAreCoalesced)
+{
+    Lookup first(resolver(), "www.example.test");
+    Lookup second(resolver(), "www.example.test");
+    Lookup otherHost(resolver(), "other.example.test");
+    EXPECT_EQ(2U, testResolverState().asynchronousLookupCount);
+    EXPECT_FALSE(first.isDone());
+    EXPECT_FALSE(second.isDone());
+
+    completePendingLookups("192.0.2.1");
+    EXPECT_STREQ("192.0.2.1", first.address().data());
+    EXPECT_STREQ("192.0.2.1", second.address().data());
+    EXPECT_STREQ("192.0.2.1", otherHost.address().data());
+
+    // Answered from the cache.
+    Lookup cached(resolver(), "www.example.test");
+    EXPECT_STREQ("192.0.2.1", cached.address().data());
+    EXPECT_STREQ("192.0.2.1", synchronousLookup(resolver(), "www.example.test").data());
+    EXPECT_EQ(2U, testResolverState().asynchronousLookupCount);
+    EXPECT_EQ(0U, testResolverState().synchronousLookupCount);
+}
+
+TEST_F(WebKitCachingResolverTest, CancelledLookupDoesNotCancelSharedLookup)
+{
+    GRefPtr<GCancellable> cancellable = adoptGRef(g_cancellable_new());
+    Lookup cancelledLookup(resolver(), "www.example.test", cancellable.get());
+    Lookup lookup(resolver(), "www.example.test");
+    EXPECT_EQ(1U, testResolverState().asynchronousLookupCount);
+
+    // The cancelled lookup doesn't wait for the shared one.
+    g_cancellable_cancel(cancellable.get());
+    EXPECT_TRUE(cancelledLookup.isDone());
+    EXPECT_TRUE(g_error_matches(cancelledLookup.error(), G_IO_ERROR, G_IO_ERROR_CANCELLED));
+    EXPECT_FALSE(lookup.isDone());
+
+    completePendingLookups("192.0.2.1");
+    EXPECT_STREQ("192.0.2.1", lookup.address().data());
+
+    // Lookups cancelled before they start never reach the wrapped resolver.
+    Lookup alreadyCancelledLookup(resolver(), "other.example.test", cancellable.get());
+    EXPECT_TRUE(g_error_matches(alreadyCancelledLookup.error(), G_IO_ERROR, G_IO_ERROR_CANCELLED));
+    EXPECT_EQ(1U, testResolverState().asynchronousLookupCount);
+}
+
+#if GLIB_CHECK_VERSION(2, 59, 0)
+TEST_F(WebKitCachingResolverTest, LookupsWithFlagsAreCachedSeparately)
+{
+    Lookup ipv4Lookup(resolver(), "www.example.test", G_RESOLVER_NAME_LOOKUP_FLAGS_IPV4_ONLY);
+    Lookup ipv6Lookup(resolver(), "www.example.test", G_RESOLVER_NAME_LOOKUP_FLAGS_IPV6_ONLY);
+    Lookup lookup(resolver(), "www.example.test");
+    EXPECT_EQ(3U, testResolverState().asynchronousLookupCount);
+    EXPECT_EQ(static_cast<unsigned>(G_RESOLVER_NAME_LOOKUP_FLAGS_IPV4_ONLY), testResolverState().asynchronousLookupFlags[0]);
+    EXPECT_EQ(static_cast<unsigned>(G_RESOLVER_NAME_LOOKUP_FLAGS_IPV6_ONLY), testResolverState().asynchronousLookupFlags[1]);
+    EXPECT_EQ(0U, testResolverState().asynchronousLookupFlags[2]);
+
+    completePendingLookups("192.0.2.1");
+    EXPECT_STREQ("192.0.2.1", ipv4Lookup.address().data());
+    EXPECT_STREQ("192.0.2.1", ipv6Lookup.address().data());
+    EXPECT_STREQ("192.0.2.1", lookup.address().data());
+
+    Lookup cachedIPv4Lookup(resolver(), "www.example.test", G_RESOLVER_NAME_LOOKUP_FLAGS_IPV4_ONLY);
+    EXPECT_STREQ("192.0.2.1", cachedIPv4Lookup.address().data());
+    EXPECT_EQ(3U, testResolverState().asynchronousLookupCount);
+}
+#endif
+
+TEST_F(WebKitCachingResolverTest, StaleEntriesAreRevalidated)
+{
+    {
+        Lookup lookup(resolver(), "www.example.test");
+        completePendingLookups("192.0.2.1");
+        EXPECT_STREQ("192.0.2.1", lookup.address().data());
+    }
+
+    // Expired entries are still used by asynchronous lookups while they are looked up again.
+    advanceTime(2_min);
+    {
+        Lookup stale(resolver(), "www.example.test");
+        Lookup alsoStale(resolver(), "www.example.test");
+        EXPECT_STREQ("192.0.2.1", stale.address().data());
+        EXPECT_STREQ("192.0.2.1", alsoStale.address().data());
+        EXPECT_EQ(2U, testResolverState().asynchronousLookupCount);
+    }
+
+    completePendingLookups("192.0.2.2");
+    runPendingEvents();
+    {
+        Lookup revalidated(resolver(), "www.example.test");
+        EXPECT_STREQ("192.0.2.2", revalidated.address().data());
+        EXPECT_EQ(2U, testResolverState().asynchronousLookupCount);
+    }
+
+    // Synchronous lookups never use expired entries.
+    advanceTime(2_min);
+    EXPECT_STREQ(synchronousLookupAddress, synchronousLookup(resolver(), "www.example.test").data());
+    EXPECT_EQ(1U, testResolverState().synchronousLookupCount);
+
+    // Entries that expired too long ago are not used at all.
+    advanceTime(15_min);
+    {
+        Lookup tooOld(resolver(), "www.example.test");
+        EXPECT_FALSE(tooOld.isDone());
+        EXPECT_EQ(3U, testResolverState().asynchronousLookupCount);
+        completePendingLookups("192.0.2.3");
+        EXPECT_STREQ("192.0.2.3", tooOld.address().data());
+    }
+}
+
+TEST_F(WebKitCachingResolverTest, OnlyMissingHostsAreCachedAsFailures)
+{
+    {
+        Lookup lookup(resolver(), "missing.example.test");
+        failPendingLookups(G_RESOLVER_ERROR_NOT_FOUND);
+        EXPECT_TRUE(g_error_matches(lookup.error(), G_RESOLVER_ERROR, G_RESOLVER_ERROR_NOT_FOUND));
+    }
+    {
+        Lookup lookup(resolver(), "missing.example.test");
+        EXPECT_TRUE(g_error_matches(lookup.error(), G_RESOLVER_ERROR, G_RESOLVER_ERROR_NOT_FOUND));
+        EXPECT_EQ(1U, testResolverState().asynchronousLookupCount);
+    }
+
+    // Negative entries are never used once expired.
+    advanceTime(11_s);
+    {
+        Lookup lookup(resolver(), "missing.example.test");
+        EXPECT_FALSE(lookup.isDone());
+        EXPECT_EQ(2U, testResolverState().asynchronousLookupCount);
+        completePendingLookups("192.0.2.1");
+        EXPECT_STREQ("192.0.2.1", lookup.address().data());
+    }
+
+    {
+        Lookup lookup(resolver(), "flaky.example.test");
+        failPendingLookups(G_RESOLVER_ERROR_TEMPORARY_FAILURE);
+        EXPECT_TRUE(g_error_matches(lookup.error(), G_RESOLVER_ERROR, G_RESOLVER_ERROR_TEMPORARY_FAILURE));
+    }
+    {
+        Lookup lookup(resolver(), "flaky.example.test");
+        EXPECT_EQ(4U, testResolverState().asynchronousLookupCount);
+        completePendingLookups("192.0.2.1");
+        EXPECT_STREQ("192.0.2.1", lookup.address().data());
+    }
+}
+
+} // namespace TestWebKitAPI
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if WK_HAVE_C_SPI
+
+#include "JavaScriptTest.h"
+#include "PlatformUtilities.h"
+#include "PlatformWebView.h"
+#include <WebKit/WKPreferencesRefPrivate.h>
+#include <WebKit/WKRetainPtr.h>
+
+namespace TestWebKitAPI {
+
+static bool didFinishLoad;
+
+static void didFinishLoadForFrame(WKPageRef, WKFrameRef, WKTypeRef, const void*)
+{
+    didFinishLoad = true;
+}
+
+// The item holds five 60x10 boxes, so it's as many lines tall as the boxes need at the width
+// of the outer flexbox.
+static const char* nestedColumnFlexboxes =
+    "<div id=outer style='display: flex; flex-direction: column; width: 200px'>"
+    "<div id=inner style='display: flex; flex-direction: column'>"
+    "<div id=item style='font-size: 0; line-height: 0'>"
+    "<span style='display: inline-block; vertical-align: top; width: 60px; height: 10px'></span>"
+    "<span style='display: inline-block; vertical-align: top; width: 60px; height: 10px'></span>"
+    "<span style='display: inline-block; vertical-align: top; width: 60px; height: 10px'></span>"
+    "<span style='display: inline-block; vertical-align: top; width: 60px; height: 10px'></span>"
+    "<span style='display: inline-block; vertical-align: top; width: 60px; height: 10px'></span>"
+    "</div></div></div>";
+
+static void loadNestedColumnFlexboxes(PlatformWebView& webView, bool flexLayoutCacheEnabled)
+{
+    WKPageLoaderClientV0 loaderClient;
+    memset(&loaderClient, 0, sizeof(loaderClient));
+    loaderClient.base.version = 0;
+    loaderClient.didFinishLoadForFrame = didFinishLoadForFrame;
+    WKPageSetPageLoaderClient(webView.page(), &loaderClient.base);
+
+    WKRetainPtr<WKPreferencesRef> preferences(AdoptWK, WKPreferencesCreate());
+    WKPreferencesSetFlexLayoutCacheEnabled(preferences.get(), flexLayoutCacheEnabled);
+    WKPageGroupSetPreferences(WKPageGetPageGroup(webView.page()), preferences.get());
+
+    didFinishLoad = false;
+    WKRetainPtr<WKStringRef> htmlString(AdoptWK, WKStringCreateWithUTF8CString(nestedColumnFlexboxes));
+    WKPageLoadHTMLString(webView.page(), htmlString.get(), nullptr);
+    Util::run(&didFinishLoad);
+}
+
+static void testNestedColumnFlexboxes(bool flexLayoutCacheEnabled)
+{
+    WKRetainPtr<WKContextRef> context(AdoptWK, WKContextCreate());
+    PlatformWebView webView(context.get());
+    loadNestedColumnFlexboxes(webView, flexLayoutCacheEnabled);
+
+    EXPECT_JS_EQ(webView.page(), "item.offsetHeight", "20");
+
+    // Items that see a different available width are laid out again.
+    EXPECT_JS_EQ(webView.page(), "outer.style.width = '130px', item.offsetHeight", "30");
+    EXPECT_JS_EQ(webView.page(), "outer.style.width = '70px', item.offsetHeight", "50");
+
+    // Forced relayouts that don't change the available width keep the same layout.
+    EXPECT_JS_EQ(webView.page(), "outer.style.height = '500px', item.offsetHeight", "50");
+
+    // Items removed from a flexbox and added again are measured from scratch.
+    EXPECT_JS_EQ(webView.page(), "outer.removeChild(inner), item.offsetHeight", "0");
+    EXPECT_JS_EQ(webView.page(), "outer.appendChild(inner), item.offsetHeight", "50");
+    EXPECT_JS_EQ(webView.page(), "inner.replaceChild(item.cloneNode(true), item), document.getElementById('item').offsetHeight", "50");
+    EXPECT_JS_EQ(webView.page(), "outer.style.width = '200px', document.getElementById('item').offsetHeight", "20");
+}
+
+TEST(WebKit2, FlexLayoutCache)
+{
+    testNestedColumnFlexboxes(true);
+}
+
+TEST(WebKit2, FlexLayoutCacheDisabled)
+{
+    testNestedColumnFlexboxes(false);
+}
+
+} // namespace TestWebKitAPI
+
+#endif
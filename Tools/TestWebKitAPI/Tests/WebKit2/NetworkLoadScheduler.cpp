@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "PlatformUtilities.h"
+#include "Test.h"
+#include <WebCore/ResourceRequest.h>
+#include <WebKit/NetworkLoadScheduler.h>
+#include <wtf/Function.h>
+#include <wtf/RunLoop.h>
+
+using namespace WebCore;
+using namespace WebKit;
+
+namespace TestWebKitAPI {
+
+class TestLoad final : public NetworkLoadSchedulerClient {
+public:
+    TestLoad(NetworkLoadScheduler& scheduler, uint64_t pageID, const char* url, ResourceLoadPriority priority)
+        : m_scheduler(scheduler)
+        , m_pageID(pageID)
+        , m_request(URL(URL(), url))
+    {
+        m_request.setPriority(priority);
+    }
+
+    void schedule() { m_scheduler.schedule(*this, m_request); }
+    void finish() { m_scheduler.unschedule(*this); }
+
+    bool isStarted() const { return m_startCount; }
+    unsigned startCount() const { return m_startCount; }
+    void setStartHandler(WTF::Function<void()>&& handler) { m_startHandler = WTFMove(handler); }
+
+private:
+    uint64_t pageID() const final { return m_pageID; }
+    bool isSynchronous() const final { return false; }
+
+    void startScheduledNetworkLoad(const ResourceRequest&) final
+    {
+        ++m_startCount;
+        if (m_startHandler)
+            m_startHandler();
+    }
+
+    NetworkLoadScheduler& m_scheduler;
+    uint64_t m_pageID;
+    ResourceRequest m_request;
+    unsigned m_startCount { 0 };
+    WTF::Function<void()> m_startHandler;
+};
+
+class NetworkLoadSchedulerTest : public testing::Test {
+public:
+    void SetUp() final
+    {
+        RunLoop::initializeMainRunLoop();
+    }
+};
+
+TEST_F(NetworkLoadSchedulerTest, PageThrottlingWhileParserBlockingLoadsAreInFlight)
+{
+    NetworkLoadScheduler scheduler;
+
+    TestLoad script(scheduler, 1, "http://a.test/script.js", ResourceLoadPriority::High);
+    script.schedule();
+    EXPECT_TRUE(script.isStarted());
+
+    // Different hosts, so that only the page limit applies.
+    TestLoad image1(scheduler, 1, "http://b.test/1.png", ResourceLoadPriority::Low);
+    TestLoad image2(scheduler, 1, "http://c.test/2.png", ResourceLoadPriority::Low);
+    TestLoad image3(scheduler, 1, "http://d.test/3.png", ResourceLoadPriority::VeryLow);
+    TestLoad image4(scheduler, 1, "http://e.test/4.png", ResourceLoadPriority::Low);
+    image1.schedule();
+    image2.schedule();
+    image3.schedule();
+    image4.schedule();
+    EXPECT_TRUE(image1.isStarted());
+    EXPECT_TRUE(image2.isStarted());
+    EXPECT_FALSE(image3.isStarted());
+    EXPECT_FALSE(image4.isStarted());
+    EXPECT_TRUE(scheduler.isPending(image3));
+    EXPECT_EQ(2U, scheduler.pendingLoadCount());
+
+    // Other pages are not throttled.
+    TestLoad otherPageImage(scheduler, 2, "http://b.test/other.png", ResourceLoadPriority::Low);
+    otherPageImage.schedule();
+    EXPECT_TRUE(otherPageImage.isStarted());
+
+    // The higher priority load takes the released slot, even if it was scheduled later.
+    image1.finish();
+    EXPECT_FALSE(image3.isStarted());
+    EXPECT_TRUE(image4.isStarted());
+
+    script.finish();
+    EXPECT_TRUE(image3.isStarted());
+    EXPECT_EQ(0U, scheduler.pendingLoadCount());
+}
+
+TEST_F(NetworkLoadSchedulerTest, ConnectionsReservedForParserBlockingLoads)
+{
+    NetworkLoadScheduler scheduler;
+
+    // One of the six connections to a host is always left to parser-blocking loads.
+    Vector<std::unique_ptr<TestLoad>> images;
+    for (unsigned i = 0; i < 6; ++i) {
+        images.append(std::make_unique<TestLoad>(scheduler, 1, "http://a.test/image.png", ResourceLoadPriority::Low));
+        images.last()->schedule();
+    }
+    for (unsigned i = 0; i < 5; ++i)
+        EXPECT_TRUE(images[i]->isStarted());
+    EXPECT_FALSE(images[5]->isStarted());
+
+    // Another one is reserved for every parser-blocking load running on the host, whatever its page.
+    TestLoad script(scheduler, 2, "http://a.test/script.js", ResourceLoadPriority::VeryHigh);
+    script.schedule();
+    EXPECT_TRUE(script.isStarted());
+
+    images[0]->finish();
+    EXPECT_FALSE(images[5]->isStarted());
+
+    images[1]->finish();
+    EXPECT_TRUE(images[5]->isStarted());
+
+    // Medium priority loads are never held back.
+    TestLoad font(scheduler, 1, "http://a.test/font.woff", ResourceLoadPriority::Medium);
+    font.schedule();
+    EXPECT_TRUE(font.isStarted());
+}
+
+TEST_F(NetworkLoadSchedulerTest, ThrottledLoadsStartAfterMaximumDelay)
+{
+    NetworkLoadScheduler scheduler;
+
+    TestLoad script(scheduler, 1, "http://a.test/script.js", ResourceLoadPriority::High);
+    script.schedule();
+
+    TestLoad image1(scheduler, 1, "http://b.test/1.png", ResourceLoadPriority::Low);
+    TestLoad image2(scheduler, 1, "http://c.test/2.png", ResourceLoadPriority::Low);
+    TestLoad image3(scheduler, 1, "http://d.test/3.png", ResourceLoadPriority::Low);
+    image1.schedule();
+    image2.schedule();
+
+    bool done = false;
+    image3.setStartHandler([&done] {
+        done = true;
+    });
+    auto scheduleTime = MonotonicTime::now();
+    image3.schedule();
+    EXPECT_FALSE(image3.isStarted());
+
+    // The script never finishes, the image must not wait for it for more than a second.
+    Util::run(&done);
+    EXPECT_GE(MonotonicTime::now() - scheduleTime, 1_s);
+    EXPECT_EQ(1U, image3.startCount());
+    EXPECT_EQ(0U, scheduler.pendingLoadCount());
+}
+
+TEST_F(NetworkLoadSchedulerTest, LoadFailingWhenStarted)
+{
+    NetworkLoadScheduler scheduler;
+
+    TestLoad script(scheduler, 1, "http://a.test/script.js", ResourceLoadPriority::High);
+    script.schedule();
+
+    TestLoad image1(scheduler, 1, "http://b.test/1.png", ResourceLoadPriority::Low);
+    TestLoad image2(scheduler, 1, "http://c.test/2.png", ResourceLoadPriority::Low);
+    TestLoad failingImage(scheduler, 1, "http://d.test/failing.png", ResourceLoadPriority::Low);
+    TestLoad image3(scheduler, 1, "http://e.test/3.png", ResourceLoadPriority::Low);
+    TestLoad image4(scheduler, 1, "http://f.test/4.png", ResourceLoadPriority::Low);
+    image1.schedule();
+    image2.schedule();
+    failingImage.schedule();
+    image3.schedule();
+    image4.schedule();
+    EXPECT_EQ(3U, scheduler.pendingLoadCount());
+
+    // A load failing synchronously unschedules itself while the scheduler is starting it.
+    failingImage.setStartHandler([&failingImage] {
+        failingImage.finish();
+    });
+
+    image1.finish();
+    EXPECT_EQ(1U, failingImage.startCount());
+    EXPECT_FALSE(scheduler.isPending(failingImage));
+
+    // The slot it released went to the next load, and every load was started only once.
+    EXPECT_EQ(1U, image3.startCount());
+    EXPECT_FALSE(image4.isStarted());
+    EXPECT_EQ(1U, scheduler.pendingLoadCount());
+
+    script.finish();
+    EXPECT_EQ(1U, image1.startCount());
+    EXPECT_EQ(1U, image2.startCount());
+    EXPECT_EQ(1U, image3.startCount());
+    EXPECT_EQ(1U, image4.startCount());
+    EXPECT_EQ(0U, scheduler.pendingLoadCount());
+
+    // Its slot isn't leaked either: the page can still run more loads once unthrottled.
+    TestLoad image5(scheduler, 1, "http://d.test/5.png", ResourceLoadPriority::Low);
+    image5.schedule();
+    EXPECT_TRUE(image5.isStarted());
+}
+
+} // namespace TestWebKitAPI
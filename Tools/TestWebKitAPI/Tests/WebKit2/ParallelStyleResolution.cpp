@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if WK_HAVE_C_SPI
+
+#include "JavaScriptTest.h"
+#include "PlatformUtilities.h"
+#include "PlatformWebView.h"
+#include <JavaScriptCore/JSContextRef.h>
+#include <JavaScriptCore/JSRetainPtr.h>
+#include <WebKit/WKPreferencesRefPrivate.h>
+#include <WebKit/WKRetainPtr.h>
+#include <WebKit/WKSerializedScriptValue.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace TestWebKitAPI {
+
+static bool didFinishLoad;
+
+static void didFinishLoadForFrame(WKPageRef, WKFrameRef, WKTypeRef, const void*)
+{
+    didFinishLoad = true;
+}
+
+// More elements than helper threads are woken up for, with selectors depending on ancestors and siblings.
+static String createDocument()
+{
+    StringBuilder builder;
+    builder.appendLiteral("<!DOCTYPE html><style>"
+        "div { color: rgb(0, 0, 1) }"
+        ".a > .b { color: rgb(0, 0, 2) }"
+        ".a .c { margin-left: 3px }"
+        "#list > div:nth-child(3n) { padding-left: 4px }"
+        "div.b + div.c { border-left-style: solid }"
+        "section div[data-x='2'] { width: 5px }"
+        ".a section .b { height: 6px }"
+        "div:not(.a) > .c { text-indent: 7px }"
+        "</style><div id=list>");
+    for (unsigned i = 0; i < 100; ++i) {
+        builder.appendLiteral("<div class=a data-x=");
+        builder.appendNumber(i % 3);
+        builder.appendLiteral("><div class=b><div class=c data-x=2></div></div><section><div class='c b'></div><div class=b data-x=2></div></section></div>");
+    }
+    builder.appendLiteral("</div>");
+    return builder.toString();
+}
+
+static void loadDocument(PlatformWebView& webView, const String& html, bool parallelStyleResolutionEnabled)
+{
+    WKRetainPtr<WKPreferencesRef> preferences(AdoptWK, WKPreferencesCreate());
+    WKPreferencesSetParallelStyleResolutionEnabled(preferences.get(), parallelStyleResolutionEnabled);
+    WKPageGroupSetPreferences(WKPageGetPageGroup(webView.page()), preferences.get());
+
+    didFinishLoad = false;
+    WKRetainPtr<WKStringRef> htmlString(AdoptWK, WKStringCreateWithUTF8CString(html.utf8().data()));
+    WKPageLoadHTMLString(webView.page(), htmlString.get(), nullptr);
+    Util::run(&didFinishLoad);
+}
+
+struct JavaScriptResult {
+    bool isDone { false };
+    std::string value;
+};
+
+static void javaScriptCallback(WKSerializedScriptValueRef serializedValue, WKErrorRef, void* context)
+{
+    auto& result = *static_cast<JavaScriptResult*>(context);
+    result.isDone = true;
+    if (!serializedValue)
+        return;
+
+    JSGlobalContextRef scriptContext = JSGlobalContextCreate(nullptr);
+    JSValueRef value = WKSerializedScriptValueDeserialize(serializedValue, scriptContext, nullptr);
+    JSRetainPtr<JSStringRef> string(Adopt, JSValueToStringCopy(scriptContext, value, nullptr));
+    size_t bufferSize = JSStringGetMaximumUTF8CStringSize(string.get());
+    auto buffer = std::make_unique<char[]>(bufferSize);
+    JSStringGetUTF8CString(string.get(), buffer.get(), bufferSize);
+    result.value = buffer.get();
+    JSGlobalContextRelease(scriptContext);
+}
+
+static std::string computedStyles(WKPageRef page)
+{
+    static const char* script = "Array.prototype.map.call(document.querySelectorAll('#list *'), element => {"
+        "    let style = getComputedStyle(element);"
+        "    return [style.color, style.marginLeft, style.paddingLeft, style.borderLeftStyle, style.width, style.height, style.textIndent].join(' ');"
+        "}).join('|')";
+    JavaScriptResult result;
+    WKPageRunJavaScriptInMainFrame(page, Util::toWK(script).get(), &result, javaScriptCallback);
+    Util::run(&result.isDone);
+    return result.value;
+}
+
+TEST(WebKit2, ParallelStyleResolutionMatchesMainThreadResolution)
+{
+    WKRetainPtr<WKContextRef> context(AdoptWK, WKContextCreate());
+    PlatformWebView webView(context.get());
+
+    WKPageLoaderClientV0 loaderClient;
+    memset(&loaderClient, 0, sizeof(loaderClient));
+    loaderClient.base.version = 0;
+    loaderClient.didFinishLoadForFrame = didFinishLoadForFrame;
+    WKPageSetPageLoaderClient(webView.page(), &loaderClient.base);
+
+    String html = createDocument();
+    loadDocument(webView, html, false);
+    std::string mainThreadStyles = computedStyles(webView.page());
+    EXPECT_JS_EQ(webView.page(), "getComputedStyle(document.querySelector('.a > .b')).color", "rgb(0, 0, 2)");
+
+    loadDocument(webView, html, true);
+    EXPECT_EQ(mainThreadStyles, computedStyles(webView.page()));
+    EXPECT_JS_EQ(webView.page(), "getComputedStyle(document.querySelector('.a > .b')).color", "rgb(0, 0, 2)");
+    EXPECT_JS_EQ(webView.page(), "getComputedStyle(document.querySelector('section .b')).height", "6px");
+}
+
+} // namespace TestWebKitAPI
+
+#endif
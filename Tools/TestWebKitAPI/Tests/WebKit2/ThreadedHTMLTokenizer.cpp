@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2017 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if WK_HAVE_C_SPI
+
+#include "JavaScriptTest.h"
+#include "PlatformUtilities.h"
+#include "PlatformWebView.h"
+#include <WebKit/WKPreferencesRefPrivate.h>
+#include <WebKit/WKRetainPtr.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace TestWebKitAPI {
+
+static bool didFinishLoad;
+
+static void didFinishLoadForFrame(WKPageRef, WKFrameRef, WKTypeRef, const void*)
+{
+    didFinishLoad = true;
+}
+
+static void loadWithThreadedHTMLTokenizer(PlatformWebView& webView, const String& html)
+{
+    WKPageLoaderClientV0 loaderClient;
+    memset(&loaderClient, 0, sizeof(loaderClient));
+    loaderClient.base.version = 0;
+    loaderClient.didFinishLoadForFrame = didFinishLoadForFrame;
+    WKPageSetPageLoaderClient(webView.page(), &loaderClient.base);
+
+    WKRetainPtr<WKPreferencesRef> preferences(AdoptWK, WKPreferencesCreate());
+    WKPreferencesSetThreadedHTMLTokenizerEnabled(preferences.get(), true);
+    WKPageGroupSetPreferences(WKPageGetPageGroup(webView.page()), preferences.get());
+
+    didFinishLoad = false;
+    WKRetainPtr<WKStringRef> htmlString(AdoptWK, WKStringCreateWithUTF8CString(html.utf8().data()));
+    WKPageLoadHTMLString(webView.page(), htmlString.get(), nullptr);
+    Util::run(&didFinishLoad);
+}
+
+static String repeat(const char* markup, unsigned count)
+{
+    StringBuilder builder;
+    for (unsigned i = 0; i < count; ++i)
+        builder.append(markup);
+    return builder.toString();
+}
+
+TEST(WebKit2, ThreadedHTMLTokenizer)
+{
+    WKRetainPtr<WKContextRef> context(AdoptWK, WKContextCreate());
+    PlatformWebView webView(context.get());
+
+    // More tokens than fit in a single batch from the background tokenizer.
+    String items = repeat("<i>x</i>", 1000);
+    loadWithThreadedHTMLTokenizer(webView, "<!DOCTYPE html><title>a &amp; b</title><textarea>c</b></textarea>" + items + "<p id=a>1</p>" + items);
+
+    EXPECT_JS_EQ(webView.page(), "document.title", "a & b");
+    EXPECT_JS_EQ(webView.page(), "document.querySelector('textarea').value", "c</b>");
+    EXPECT_JS_EQ(webView.page(), "document.getElementsByTagName('i').length", "2000");
+    EXPECT_JS_EQ(webView.page(), "document.getElementById('a').previousSibling.tagName", "I");
+}
+
+TEST(WebKit2, ThreadedHTMLTokenizerDocumentWrite)
+{
+    WKRetainPtr<WKContextRef> context(AdoptWK, WKContextCreate());
+    PlatformWebView webView(context.get());
+
+    // document.write() input goes before what the background tokenizer has already seen, so the main thread
+    // tokenizer has to take over right after the script, including in the middle of a batch.
+    String items = repeat("<i>x</i>", 500);
+    loadWithThreadedHTMLTokenizer(webView, "<!DOCTYPE html><body>" + items
+        + "<p id=a>1</p><script>document.write('<p id=b>2</p><textarea>');</script>3</textarea><p id=c>4</p>" + items);
+
+    EXPECT_JS_EQ(webView.page(), "Array.prototype.map.call(document.querySelectorAll('p'), p => p.id + p.textContent).join()", "a1,b2,c4");
+    EXPECT_JS_EQ(webView.page(), "document.querySelector('textarea').value", "3");
+    EXPECT_JS_EQ(webView.page(), "document.getElementsByTagName('i').length", "1000");
+}
+
+} // namespace TestWebKitAPI
+
+#endif
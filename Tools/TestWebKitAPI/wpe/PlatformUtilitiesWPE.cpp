@@ -32,6 +32,12 @@
 namespace TestWebKitAPI {
 namespace Util {
 
+void run(bool* done)
+{
+    while (!*done)
+        g_main_context_iteration(nullptr, TRUE);
+}
+
 void sleep(double seconds)
 {
     g_usleep(seconds * 1000000);